@@ -0,0 +1,140 @@
+#include "backtest/backtest_engine.hpp"
+#include "data/series_data_feed.hpp"
+#include "strategy/moving_average_strategy.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// 检查点续跑示例
+// 用法: checkpoint_resume [已有K线数] [新增K线数]
+// 先回测已有数据，历史追加到日志并保存检查点；新数据到达后分别从头重跑和从检查点续跑，
+// 核对报告、检查点和历史日志逐位一致并比较耗时
+
+namespace {
+
+double seconds_since(std::chrono::steady_clock::time_point begin) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+bool same_curve(
+    const std::vector<std::pair<quant::data::Timestamp, double>>& a,
+    const std::vector<std::pair<quant::data::Timestamp, double>>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].first != b[i].first || std::memcmp(&a[i].second, &b[i].second, sizeof(double)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool same_orders(const std::vector<quant::execution::Order>& a, const std::vector<quant::execution::Order>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].timestamp != b[i].timestamp || a[i].symbol != b[i].symbol || a[i].side != b[i].side ||
+            std::memcmp(&a[i].quantity, &b[i].quantity, sizeof(double)) != 0 ||
+            std::memcmp(&a[i].price, &b[i].price, sizeof(double)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool same_report(const quant::analysis::PerformanceReport& a, const quant::analysis::PerformanceReport& b) {
+    const double x[] = {a.total_return, a.annualized_return, a.sharpe_ratio, a.max_drawdown, a.volatility,
+                        a.win_rate, a.profit_factor, a.average_profit, a.average_loss, a.largest_profit, a.largest_loss};
+    const double y[] = {b.total_return, b.annualized_return, b.sharpe_ratio, b.max_drawdown, b.volatility,
+                        b.win_rate, b.profit_factor, b.average_profit, b.average_loss, b.largest_profit, b.largest_loss};
+    return std::memcmp(x, y, sizeof(x)) == 0 && a.total_trades == b.total_trades &&
+           a.winning_trades == b.winning_trades && a.losing_trades == b.losing_trades;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t history = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::size_t appended = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000;
+
+    const std::string name = "BTCUSDT";
+    auto symbol = quant::data::intern_symbol(name);
+    std::vector<quant::data::BarData> bars;
+    bars.reserve(history + appended);
+    double price = 100.0;
+    for (std::size_t i = 0; i < history + appended; ++i) {
+        price *= 1.0 + (std::rand() % 2001 - 1000) / 5e5;
+        bars.push_back({static_cast<quant::data::Timestamp>(1577836800 + i * 60), symbol, price, price, price, price, 1.0});
+    }
+    auto data = std::make_shared<quant::data::SeriesDataFeed>();
+    data->set_series(name, quant::data::BarSeries::from_bars(bars, symbol));
+
+    quant::backtest::BacktestConfig config;
+    config.commission_rate = 0.001;
+    config.symbols = {name};
+    config.warmup_duration = 3600;
+    config.start_time = 1577836800 + config.warmup_duration;
+    config.end_time = bars[history - 1].timestamp;
+
+    // 已有数据回测完毕，历史写入日志后保存检查点
+    const std::string path = "checkpoint_resume.bin";
+    const std::string log = "checkpoint_resume.hist";
+    const std::string full_log = "checkpoint_resume_full.hist";
+    std::remove(log.c_str());
+    std::remove(full_log.c_str());
+    quant::backtest::BacktestEngine first(data, std::make_shared<quant::strategy::MovingAverageStrategy>(10, 30), config);
+    first.run();
+    first.append_history(log);
+    auto begin = std::chrono::steady_clock::now();
+    first.save_checkpoint(path);
+    double save_seconds = seconds_since(begin);
+
+    // 新数据到达：从头重跑
+    config.end_time = bars.back().timestamp;
+    begin = std::chrono::steady_clock::now();
+    quant::backtest::BacktestEngine full(data, std::make_shared<quant::strategy::MovingAverageStrategy>(10, 30), config);
+    full.run();
+    full.append_history(full_log);
+    double full_seconds = seconds_since(begin);
+
+    // 新数据到达：从检查点续跑，只处理新增的K线
+    begin = std::chrono::steady_clock::now();
+    quant::backtest::BacktestEngine resumed(data, std::make_shared<quant::strategy::MovingAverageStrategy>(10, 30), config);
+    resumed.load_checkpoint(path);
+    resumed.run();
+    resumed.append_history(log);
+    double resume_seconds = seconds_since(begin);
+
+    // 续跑的引擎只持有新增的历史，完整历史从日志读回
+    auto history_log = quant::backtest::load_history(log);
+    auto full_history = quant::backtest::load_history(full_log);
+    std::remove(path.c_str());
+    std::remove(log.c_str());
+    std::remove(full_log.c_str());
+
+    const auto& report = resumed.get_performance_report();
+    bool identical = full.checkpoint() == resumed.checkpoint() &&
+                     same_report(full.get_performance_report(), report) &&
+                     same_curve(full.get_equity_curve(), history_log.equity_curve) &&
+                     same_curve(full_history.equity_curve, history_log.equity_curve) &&
+                     same_orders(full.get_order_history(), history_log.orders) &&
+                     same_orders(full_history.orders, history_log.orders);
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << history << " bars + " << appended << " new bars, checkpoint "
+              << first.checkpoint().size() / 1024.0 << " KiB, saved in " << save_seconds * 1e3 << " ms\n"
+              << "full re-run: " << full_seconds * 1e3 << " ms\n"
+              << "resume:      " << resume_seconds * 1e3 << " ms (" << full_seconds / resume_seconds << "x)\n"
+              << "return " << report.total_return * 100 << "%, sharpe " << report.sharpe_ratio << ", "
+              << history_log.orders.size() << " orders\n"
+              << "results " << (identical ? "identical" : "DIFFERENT") << "\n";
+    return identical ? 0 : 1;
+}
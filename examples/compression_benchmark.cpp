@@ -0,0 +1,152 @@
+#include "data/bar_store.hpp"
+#include "data/compressed_store.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+// 压缩存储基准
+// 用法: compression_benchmark [每个品种的K线数]
+// 生成多品种分钟线和逐笔成交，比较原始列式存储与压缩存储的文件大小，
+// 并测量解码吞吐（按解码后原始字节计的MB/s）
+
+namespace {
+
+using quant::data::BarData;
+using quant::data::Timestamp;
+using quant::data::Trade;
+
+// 目标：压缩比不低于5倍；解码吞吐高于常见NVMe顺序读（约2000 MB/s）的一半，
+// 即在I/O受限的回测中解码不会成为新的瓶颈
+constexpr double kTargetRatio = 5.0;
+constexpr double kTargetDecodeMBps = 1000.0;
+
+const char* kSymbols[] = {"BTCUSDT", "ETHUSDT", "BNBUSDT", "SOLUSDT"};
+
+std::vector<BarData> generate_bars(const std::string& symbol, std::size_t count) {
+    std::vector<BarData> bars;
+    bars.reserve(count);
+    auto id = quant::data::intern_symbol(symbol);
+    long long cents = 1000000 + std::rand() % 100000;
+    Timestamp timestamp = 1577836800;  // 2020-01-01
+    for (std::size_t i = 0; i < count; ++i) {
+        long long open = cents;
+        long long close = open + std::rand() % 201 - 100;
+        long long high = std::max(open, close) + std::rand() % 50;
+        long long low = std::min(open, close) - std::rand() % 50;
+        bars.push_back(BarData{timestamp, id, open / 100.0, high / 100.0, low / 100.0, close / 100.0,
+                               (std::rand() % 10000000) / 10000.0});
+        cents = close;
+        timestamp += 60;
+    }
+    return bars;
+}
+
+std::vector<Trade> generate_trades(const std::string& symbol, std::size_t count) {
+    std::vector<Trade> trades;
+    trades.reserve(count);
+    auto id = quant::data::intern_symbol(symbol);
+    long long cents = 1000000;
+    Timestamp timestamp = 1577836800000LL;  // 毫秒
+    for (std::size_t i = 0; i < count; ++i) {
+        cents += std::rand() % 5 - 2;
+        timestamp += std::rand() % 200;
+        trades.push_back(Trade{timestamp, id, cents / 100.0, (std::rand() % 100000) / 1000.0,
+                               (std::rand() & 1) != 0});
+    }
+    return trades;
+}
+
+double seconds_since(std::chrono::steady_clock::time_point begin) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+long file_size(const std::string& path) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        return 0;
+    }
+    std::fseek(file, 0, SEEK_END);
+    long size = std::ftell(file);
+    std::fclose(file);
+    return size;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t bars_per_symbol = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    const std::string raw_path = "compression_benchmark.qfb";
+    const std::string compressed_path = "compression_benchmark.qfc";
+
+    std::cout << "Generating " << bars_per_symbol << " 1m bars x " << std::size(kSymbols) << " symbols...\n";
+    std::vector<std::vector<BarData>> all_bars;
+    for (const char* symbol : kSymbols) {
+        all_bars.push_back(generate_bars(symbol, bars_per_symbol));
+    }
+    std::vector<Trade> trades = generate_trades("BTCUSDT", bars_per_symbol);
+
+    {
+        quant::data::BarStoreWriter raw(raw_path, "1m");
+        quant::data::CompressedStoreWriter compressed(compressed_path, "1m");
+        for (std::size_t s = 0; s < all_bars.size(); ++s) {
+            raw.add_symbol(kSymbols[s], all_bars[s]);
+            compressed.add_bars(kSymbols[s], all_bars[s]);
+        }
+        compressed.add_trades("BTCUSDT", trades);
+    }
+
+    // 成交单独写一份，分开统计压缩比
+    const std::string trade_path = "compression_benchmark_trades.qfc";
+    {
+        quant::data::CompressedStoreWriter writer(trade_path, "tick");
+        writer.add_trades("BTCUSDT", trades);
+    }
+
+    quant::data::CompressedStore store(compressed_path);
+    double raw_bar_bytes = static_cast<double>(file_size(raw_path));
+    double trade_bytes = static_cast<double>(file_size(trade_path));
+    double compressed_bytes = static_cast<double>(store.file_bytes()) - trade_bytes;
+    double bar_ratio = raw_bar_bytes / compressed_bytes;
+    double trade_ratio = trades.size() * (sizeof(Timestamp) + 2 * sizeof(double) + 1) / trade_bytes;
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "bars:   raw " << raw_bar_bytes / 1048576.0 << " MB, compressed "
+              << compressed_bytes / 1048576.0 << " MB, ratio " << bar_ratio << "x"
+              << (bar_ratio >= kTargetRatio ? "  [OK]" : "  [BELOW TARGET]") << "\n"
+              << "trades: raw " << trades.size() * 25 / 1048576.0 << " MB, compressed "
+              << trade_bytes / 1048576.0 << " MB, ratio " << trade_ratio << "x\n";
+
+    // 解码吞吐，以解码出的原始列字节计
+    auto begin = std::chrono::steady_clock::now();
+    std::size_t decoded = 0;
+    bool identical = true;
+    for (std::size_t s = 0; s < all_bars.size(); ++s) {
+        auto series = store.get_bar_series(kSymbols[s], 0, std::numeric_limits<Timestamp>::max(), "1m");
+        decoded += series.size();
+        identical = identical && series.size() == all_bars[s].size() &&
+                    series[series.size() / 2] == all_bars[s][series.size() / 2];
+    }
+    double seconds = seconds_since(begin);
+    double decode_mbps = decoded * 48.0 / 1048576.0 / seconds;
+    std::cout << "decode: " << std::setprecision(1) << decode_mbps << " MB/s, "
+              << decoded / seconds / 1e6 << " Mbars/s"
+              << (decode_mbps >= kTargetDecodeMBps ? "  [OK]" : "  [BELOW TARGET]")
+              << (identical ? "" : "  [MISMATCH]") << "\n";
+
+    begin = std::chrono::steady_clock::now();
+    std::size_t trade_count = 0;
+    store.for_each_trade_block("BTCUSDT", 0, std::numeric_limits<Timestamp>::max(),
+        [&trade_count](const std::vector<Trade>& block) { trade_count += block.size(); });
+    seconds = seconds_since(begin);
+    std::cout << "trades: " << trade_count / seconds / 1e6 << " Mtrades/s\n";
+
+    std::remove(raw_path.c_str());
+    std::remove(compressed_path.c_str());
+    std::remove(trade_path.c_str());
+    return identical ? 0 : 1;
+}
@@ -0,0 +1,95 @@
+#include "data/csv_data_source.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
+#include <iostream>
+#include <string>
+
+// CSV解析吞吐基准
+// 用法: csv_benchmark [行数] [文件路径]
+// 生成一份多品种分钟线CSV，测量全量解析与按品种过滤两种场景的吞吐（MB/s，取3次扫描中最快的一次）
+
+namespace {
+
+// 吞吐目标（单线程、页缓存命中）：全量解析所有列 / 按品种过滤
+constexpr double kTargetFullMBps = 250.0;
+constexpr double kTargetFilteredMBps = 500.0;
+
+void generate_csv(const std::string& path, std::size_t rows) {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        throw std::runtime_error("Cannot create " + path);
+    }
+    std::fputs("timestamp,symbol,open,high,low,close,volume\n", file);
+
+    const char* symbols[] = {"BTCUSDT", "ETHUSDT", "BNBUSDT", "SOLUSDT", "XRPUSDT", "ADAUSDT", "DOGEUSDT", "DOTUSDT"};
+    const std::size_t symbol_count = sizeof(symbols) / sizeof(symbols[0]);
+    double price = 10000.0;
+    long long timestamp = 1577836800;  // 2020-01-01
+    for (std::size_t i = 0; i < rows; ++i) {
+        std::size_t s = i % symbol_count;
+        if (s == 0) {
+            timestamp += 60;
+            price += (std::rand() % 200 - 100) / 100.0;
+        }
+        double open = price + s;
+        std::fprintf(file, "%lld,%s,%.2f,%.2f,%.2f,%.2f,%.4f\n",
+                     timestamp, symbols[s], open, open + 1.25, open - 1.5, open + 0.25,
+                     (std::rand() % 100000) / 100.0);
+    }
+    std::fclose(file);
+}
+
+// 连续扫描passes次取最快的一次，减少偶发抖动的影响；target_mbps为0时只报告不判定
+void run(const quant::data::CsvDataSource& source, const std::string& label,
+         const std::string& symbol, double target_mbps, int passes) {
+    double best = 0.0;
+    double checksum = 0.0;
+    quant::data::CsvScanStats stats;
+    for (int pass = 0; pass < passes; ++pass) {
+        checksum = 0.0;
+        auto begin = std::chrono::steady_clock::now();
+        stats = source.for_each_bar(symbol, 0, std::numeric_limits<quant::data::Timestamp>::max(),
+            [&checksum](const quant::data::BarData& bar) { checksum += bar.close; });
+        auto end = std::chrono::steady_clock::now();
+        best = std::max(best, stats.bytes_read / (1024.0 * 1024.0) / std::chrono::duration<double>(end - begin).count());
+    }
+
+    double lines_per_second = stats.lines * best * (1024.0 * 1024.0) / stats.bytes_read;
+    std::cout << std::left << std::setw(18) << label
+              << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << best << " MB/s  "
+              << std::setw(10) << lines_per_second / 1e6 << " Mlines/s  "
+              << "bars=" << stats.bars_matched;
+    if (target_mbps > 0.0) {
+        std::cout << (best >= target_mbps ? "  [OK]" : "  [BELOW TARGET]");
+    }
+    std::cout << "  (checksum " << std::setprecision(0) << checksum << ")\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t rows = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5000000;
+    std::string path = argc > 2 ? argv[2] : "csv_benchmark.csv";
+
+    std::cout << "Generating " << rows << " rows into " << path << "...\n";
+    generate_csv(path, rows);
+
+    quant::data::CsvDataSource source(path);
+    std::cout << "Target throughput (single thread, warm page cache): "
+              << kTargetFullMBps << " MB/s full parse, "
+              << kTargetFilteredMBps << " MB/s filtered\n";
+
+    // 第一次扫描预热页缓存，不计入目标
+    run(source, "warm-up", "", 0.0, 1);
+    run(source, "all symbols", "", kTargetFullMBps, 3);
+    run(source, "single symbol", "ETHUSDT", kTargetFilteredMBps, 3);
+
+    std::remove(path.c_str());
+    return 0;
+}
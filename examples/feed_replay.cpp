@@ -0,0 +1,107 @@
+#include "data/feed_replayer.hpp"
+#include "data/market_data_dispatcher.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+
+// 行情回放压测
+// 用法: feed_replay [倍速] [事件数] [消费线程绑定的CPU]
+// 先录制一段带突发的合成成交和订单簿增量，再按指定倍速回放到分发器，
+// 消费线程统计发布到处理的延迟。倍速<=0表示尽可能快。
+
+namespace {
+
+using namespace quant::data;
+
+// 消费者：维护订单簿并统计成交量
+struct BookConsumer {
+    std::vector<L2OrderBook<32>> books;
+    double traded_volume = 0.0;
+    std::uint64_t events = 0;
+
+    void operator()(const MarketEvent& event) {
+        ++events;
+        if (event.type == MarketEventType::TRADE) {
+            traded_volume += event.volume;
+        } else if (event.type == MarketEventType::BOOK_DELTA) {
+            if (event.symbol >= books.size()) {
+                books.resize(event.symbol + 1);
+            }
+            books[event.symbol].apply(event.to_book_delta(), event.timestamp);
+        }
+    }
+};
+
+void record_feed(const std::string& path, std::size_t events) {
+    const char* names[] = {"BTCUSDT", "ETHUSDT", "BNBUSDT", "SOLUSDT"};
+    SymbolId symbols[4];
+    for (int i = 0; i < 4; ++i) {
+        symbols[i] = intern_symbol(names[i]);
+    }
+
+    std::mt19937 rng(42);
+    FeedRecorder recorder(path);
+    std::uint64_t capture_ns = 1;
+    Timestamp timestamp = 1700000000;
+    for (std::size_t i = 0; i < events; ++i) {
+        // 平时约2万条/秒，每1000条中有200条以约20万条/秒的速度突发
+        capture_ns += (i % 1000) < 200 ? 5000 : 50000 + rng() % 20000;
+        timestamp = 1700000000 + static_cast<Timestamp>(capture_ns / 1000000000);
+        SymbolId symbol = symbols[rng() % 4];
+        if (rng() % 4 == 0) {
+            recorder.record(Trade{timestamp, symbol, 100.0 + (rng() % 100) / 100.0, (rng() % 1000) / 100.0,
+                                  (rng() & 1) != 0}, capture_ns);
+        } else {
+            BookSide side = (rng() & 1) ? BookSide::BID : BookSide::ASK;
+            double price = side == BookSide::BID ? 100.0 - (rng() % 20) / 100.0 : 100.01 + (rng() % 20) / 100.0;
+            DeltaAction action = rng() % 5 == 0 ? DeltaAction::REMOVE : DeltaAction::MODIFY;
+            recorder.record(symbol, timestamp, BookDelta{side, action, price, double(rng() % 500 + 1)}, capture_ns);
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    double speed = argc > 1 ? std::atof(argv[1]) : 10.0;
+    std::size_t events = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 200000;
+    int cpu = argc > 3 ? std::atoi(argv[3]) : -1;
+    const std::string path = "feed_replay.qflog";
+
+    record_feed(path, events);
+    FeedReplayer replayer(path);
+    std::cout << "Recorded " << replayer.event_count() << " events over "
+              << replayer.duration_ns() / 1e9 << " s ("
+              << replayer.event_count() / (replayer.duration_ns() / 1e9) << " msg/s average)\n";
+
+    MarketDataDispatcher dispatcher;
+    auto& channel = dispatcher.create_channel({ChannelMode::SPSC, 1 << 16});
+    dispatcher.subscribe_all(channel);
+    replayer.set_dispatcher(&dispatcher);
+
+    // 单核机器上忙等的消费线程会和回放线程争抢CPU，未绑定核心时改为让出时间片
+    ConsumerOptions consumer_options;
+    consumer_options.cpu = cpu;
+    consumer_options.wait = cpu >= 0 ? WaitStrategy::BUSY_SPIN : WaitStrategy::YIELD;
+    ConsumerThread<LatencyProbe<BookConsumer>> consumer(channel, LatencyProbe<BookConsumer>{}, consumer_options);
+    consumer.start();
+
+    ReplayOptions options;
+    options.speed = speed;
+    auto stats = replayer.replay(options);
+    consumer.stop();
+
+    const auto& probe = consumer.handler();
+    std::cout << "Replayed at " << (speed > 0 ? std::to_string(speed) + "x" : std::string("max speed"))
+              << ": " << stats.events_published << " events in " << stats.elapsed_seconds << " s ("
+              << static_cast<std::uint64_t>(stats.events_per_second) << " msg/s)\n"
+              << "  schedule lag:      " << stats.schedule_lag.summary() << "\n"
+              << "  publish->consumer: " << probe.latency.summary() << "\n"
+              << "  consumed=" << probe.handler.events << " dropped=" << channel.dropped()
+              << (consumer.pinned() ? " (pinned)" : "") << "\n";
+
+    std::remove(path.c_str());
+    return 0;
+}
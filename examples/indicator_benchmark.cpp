@@ -0,0 +1,190 @@
+#include "indicators/batch_kernels.hpp"
+#include "indicators/moving_average.hpp"
+#include "utils/indicators.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+// 批量指标内核基准
+// 用法: indicator_benchmark [K线数] [周期数]
+// 对一列收盘价一次算出多个周期的SMA / EMA / RSI完整序列，
+// 与逐个周期逐点更新指标对象比较耗时（按输出值计的ns/value），并在每个指令集上校验结果：
+// SMA相对误差小于1e-12，EMA、RSI与对应指标类逐位相同
+
+namespace {
+
+using namespace quant::indicators;
+
+double seconds_since(std::chrono::steady_clock::time_point begin) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+// 逐点更新指标对象的基线
+void incremental_sma(const std::vector<double>& closes, const std::vector<std::size_t>& periods,
+                     std::vector<double>& output) {
+    const std::size_t n = closes.size();
+    for (std::size_t k = 0; k < periods.size(); ++k) {
+        SimpleMovingAverage sma(periods[k]);
+        for (std::size_t t = 0; t < n; ++t) {
+            sma.update(closes[t]);
+            output[k * n + t] = sma.is_valid() ? sma.get_value() : NAN;
+        }
+    }
+}
+
+void incremental_ema(const std::vector<double>& closes, const std::vector<std::size_t>& periods,
+                     std::vector<double>& output) {
+    const std::size_t n = closes.size();
+    for (std::size_t k = 0; k < periods.size(); ++k) {
+        ExponentialMovingAverage ema(periods[k]);
+        for (std::size_t t = 0; t < n; ++t) {
+            ema.update(closes[t]);
+            output[k * n + t] = ema.get_value();
+        }
+    }
+}
+
+// 两组输出的最大相对误差，NaN位置须一致
+double max_relative_error(const std::vector<double>& a, const std::vector<double>& b) {
+    double error = 0.0;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (std::isnan(a[i]) || std::isnan(b[i])) {
+            if (std::isnan(a[i]) != std::isnan(b[i])) {
+                return INFINITY;
+            }
+            continue;
+        }
+        error = std::max(error, std::fabs(a[i] - b[i]) / std::max(std::fabs(a[i]), 1e-300));
+    }
+    return error;
+}
+
+// 逐位相同，NaN只要求位置一致
+bool same_value(double a, double b) {
+    if (std::isnan(a) || std::isnan(b)) {
+        return std::isnan(a) && std::isnan(b);
+    }
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+// 按周期逐行用指标类重新计算并与批量输出逐位比较；reference(period, row)写出一行参考值
+template <typename Reference>
+bool matches_reference(const std::vector<double>& output, const std::vector<double>& closes,
+                       const std::vector<std::size_t>& periods, Reference reference) {
+    const std::size_t n = closes.size();
+    std::vector<double> row(n);
+    for (std::size_t k = 0; k < periods.size(); ++k) {
+        reference(periods[k], row);
+        for (std::size_t t = 0; t < n; ++t) {
+            if (!same_value(row[t], output[k * n + t])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t bars = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::size_t period_count = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 64;
+
+    std::vector<double> closes(bars);
+    double price = 10000.0;
+    for (double& close : closes) {
+        price += (std::rand() % 2001 - 1000) / 100.0;
+        close = price;
+    }
+    std::vector<std::size_t> periods(period_count);
+    std::iota(periods.begin(), periods.end(), std::size_t{2});
+
+    const double values = static_cast<double>(bars * period_count);
+    std::vector<double> expected(bars * period_count);
+    std::vector<double> output(bars * period_count);
+
+    std::cout << std::fixed << std::setprecision(2)
+              << bars << " bars x " << period_count << " periods, cpu supports "
+              << batch::simd_level_name(batch::detected_simd_level()) << "\n";
+
+    auto begin = std::chrono::steady_clock::now();
+    incremental_sma(closes, periods, expected);
+    std::cout << "incremental sma: " << seconds_since(begin) * 1e9 / values << " ns/value\n";
+    begin = std::chrono::steady_clock::now();
+    incremental_ema(closes, periods, output);
+    std::cout << "incremental ema: " << seconds_since(begin) * 1e9 / values << " ns/value\n";
+
+    // 参考值：EMA以第一个值为初始值，与ExponentialMovingAverage一致
+    auto ema_reference = [&closes](std::size_t period, std::vector<double>& row) {
+        ExponentialMovingAverage ema(period);
+        for (std::size_t t = 0; t < closes.size(); ++t) {
+            ema.update(closes[t]);
+            row[t] = ema.get_value();
+        }
+    };
+    // 以SMA为初始值的EMA，与utils::EMA一致：先用前period个值初始化，之后逐值推进
+    auto seeded_ema_reference = [&closes](std::size_t period, std::vector<double>& row) {
+        quant::utils::EMA ema(period);
+        std::fill(row.begin(), row.end(), NAN);
+        if (closes.size() < period) {
+            return;
+        }
+        row[period - 1] = ema.calculate(std::vector<double>(closes.begin(), closes.begin() + period));
+        for (std::size_t t = period; t < closes.size(); ++t) {
+            row[t] = ema.calculate(closes[t]);
+        }
+    };
+    // RSI与utils::RSI一致：先用前period + 1个值初始化，之后逐值推进
+    auto rsi_reference = [&closes](std::size_t period, std::vector<double>& row) {
+        quant::utils::RSI rsi(period);
+        std::fill(row.begin(), row.end(), NAN);
+        if (closes.size() < period + 1) {
+            return;
+        }
+        row[period] = rsi.calculate(std::vector<double>(closes.begin(), closes.begin() + period + 1));
+        for (std::size_t t = period + 1; t < closes.size(); ++t) {
+            row[t] = rsi.calculate(closes[t]);
+        }
+    };
+
+    bool ok = true;
+    for (auto level : {batch::SimdLevel::SCALAR, batch::SimdLevel::AVX2, batch::SimdLevel::AVX512}) {
+        if (level > batch::detected_simd_level()) {
+            break;
+        }
+        batch::set_simd_level(level);
+        const char* name = batch::simd_level_name(level);
+
+        begin = std::chrono::steady_clock::now();
+        batch::sma_multi(closes, periods, output);
+        double sma_ns = seconds_since(begin) * 1e9 / values;
+        double sma_error = max_relative_error(expected, output);
+
+        begin = std::chrono::steady_clock::now();
+        batch::ema_multi(closes, periods, output);
+        double ema_ns = seconds_since(begin) * 1e9 / values;
+        bool ema_exact = matches_reference(output, closes, periods, ema_reference);
+
+        batch::ema_multi(closes, periods, output, batch::EmaSeed::SMA);
+        bool seeded_ema_exact = matches_reference(output, closes, periods, seeded_ema_reference);
+
+        begin = std::chrono::steady_clock::now();
+        batch::rsi_multi(closes, periods, output);
+        double rsi_ns = seconds_since(begin) * 1e9 / values;
+        bool rsi_exact = matches_reference(output, closes, periods, rsi_reference);
+
+        ok = ok && sma_error < 1e-12 && ema_exact && seeded_ema_exact && rsi_exact;
+        std::cout << std::setw(6) << name << " batch  sma " << sma_ns << "  ema " << ema_ns
+                  << "  rsi " << rsi_ns << " ns/value  (sma max rel error "
+                  << std::scientific << sma_error << std::fixed << ", ema "
+                  << (ema_exact && seeded_ema_exact ? "exact" : "MISMATCH") << ", rsi "
+                  << (rsi_exact ? "exact" : "MISMATCH") << ")\n";
+    }
+    batch::set_simd_level(batch::detected_simd_level());
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,65 @@
+#include "backtest/parameter_sweep.hpp"
+#include "strategy/moving_average_strategy.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+// 双均线参数扫描示例
+// 用法: parameter_sweep [K线数] [线程数] [结果CSV文件]
+// 快线1-50 x 慢线10-209，去掉快线不小于慢线的组合后约一万组参数，
+// 所有回测共享同一份只读行情，按线程池并行运行
+
+int main(int argc, char* argv[]) {
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000;
+    std::size_t threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 0;
+
+    auto symbol = quant::data::intern_symbol("BTCUSDT");
+    std::vector<quant::data::BarData> bars;
+    bars.reserve(count);
+    double price = 10000.0;
+    for (std::size_t i = 0; i < count; ++i) {
+        price += (std::rand() % 2001 - 1000) / 100.0;
+        if (price < 100.0) {
+            price = 100.0;
+        }
+        bars.push_back({static_cast<quant::data::Timestamp>(1577836800 + i * 60), symbol, price, price, price, price, 1.0});
+    }
+    auto data = std::make_shared<quant::data::SeriesDataFeed>();
+    data->set_series("BTCUSDT", quant::data::BarSeries::from_bars(bars, symbol));
+
+    quant::backtest::BacktestConfig config;
+    config.start_time = bars.front().timestamp;
+    config.end_time = bars.back().timestamp;
+    config.commission_rate = 0.001;
+
+    quant::backtest::ParameterGrid grid;
+    grid.add_range("fast", 1, 50, 1)
+        .add_range("slow", 10, 209, 1)
+        .where([](const quant::backtest::ParameterSet& p) { return p.get("fast") < p.get("slow"); });
+
+    quant::backtest::ParameterSweep sweep(data, config, threads);
+    auto begin = std::chrono::steady_clock::now();
+    auto results = sweep.run(grid, [](const quant::backtest::ParameterSet& p) {
+        return std::make_shared<quant::strategy::MovingAverageStrategy>(p.get_int("fast"), p.get_int("slow"));
+    });
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    const auto& best = results.best("sharpe_ratio");
+    std::cout << std::fixed << std::setprecision(2)
+              << results.size() << " backtests x " << count << " bars on " << sweep.threads() << " threads: "
+              << seconds << " s (" << results.size() / seconds << " backtests/s, "
+              << results.failures() << " failed)\n"
+              << "best sharpe: " << best.parameters.to_string()
+              << " sharpe=" << best.report.sharpe_ratio
+              << " return=" << best.report.total_return * 100 << "%\n";
+
+    if (argc > 3) {
+        std::ofstream out(argv[3]);
+        results.write_csv(out);
+    }
+    return results.failures() == 0 ? 0 : 1;
+}
@@ -0,0 +1,86 @@
+#include "indicators/indicator_graph.hpp"
+#include "strategy/graph_moving_average_strategy.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+// 共享指标图基准
+// 用法: shared_indicators [K线数]
+// 200个参数不同的双均线策略实例接收同一路行情，比较各自持有均线与共用指标图两种方式的
+// 每根K线耗时，并校验两种方式产生的信号一致
+
+namespace {
+
+using quant::strategy::GraphMovingAverageStrategy;
+using quant::strategy::MovingAverageStrategy;
+using quant::strategy::Strategy;
+
+std::vector<std::unique_ptr<Strategy>> make_strategies(std::shared_ptr<quant::indicators::IndicatorGraph> graph) {
+    // 快线5-14 x 慢线20-39，共200个实例、30条不同的均线
+    std::vector<std::unique_ptr<Strategy>> strategies;
+    for (int fast = 5; fast < 15; ++fast) {
+        for (int slow = 20; slow < 40; ++slow) {
+            if (graph) {
+                strategies.push_back(std::make_unique<GraphMovingAverageStrategy>(fast, slow, graph));
+            } else {
+                strategies.push_back(std::make_unique<MovingAverageStrategy>(fast, slow));
+            }
+            strategies.back()->initialize();
+        }
+    }
+    return strategies;
+}
+
+// 返回每根K线的耗时（纳秒），signals记录全部信号
+double run(std::vector<std::unique_ptr<Strategy>>& strategies, const std::vector<quant::data::BarData>& bars,
+           std::vector<int>& signals) {
+    auto begin = std::chrono::steady_clock::now();
+    for (const auto& bar : bars) {
+        for (auto& strategy : strategies) {
+            auto signal = strategy->on_data(bar);
+            signals.push_back(signal ? static_cast<int>(signal->type) : -1);
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    return seconds * 1e9 / static_cast<double>(bars.size());
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+
+    auto symbol = quant::data::intern_symbol("BTCUSDT");
+    std::vector<quant::data::BarData> bars;
+    bars.reserve(count);
+    double price = 10000.0;
+    for (std::size_t i = 0; i < count; ++i) {
+        price += (std::rand() % 2001 - 1000) / 100.0;
+        bars.push_back({static_cast<quant::data::Timestamp>(1577836800 + i * 60), symbol, price, price, price, price, 1.0});
+    }
+
+    std::vector<int> own_signals;
+    std::vector<int> shared_signals;
+    own_signals.reserve(count * 200);
+    shared_signals.reserve(count * 200);
+
+    auto own = make_strategies(nullptr);
+    double own_ns = run(own, bars, own_signals);
+
+    auto graph = std::make_shared<quant::indicators::IndicatorGraph>();
+    auto shared = make_strategies(graph);
+    double shared_ns = run(shared, bars, shared_signals);
+
+    bool identical = own_signals == shared_signals;
+    std::cout << std::fixed << std::setprecision(1)
+              << own.size() << " strategies, " << count << " bars\n"
+              << "own indicators:    " << own_ns << " ns/bar\n"
+              << "shared graph:      " << shared_ns << " ns/bar (" << graph->node_count() << " nodes, "
+              << static_cast<double>(graph->evaluations()) / count << " evaluations/bar)\n"
+              << "speedup:           " << own_ns / shared_ns << "x"
+              << (identical ? "" : "  [MISMATCH]") << "\n";
+    return identical ? 0 : 1;
+}
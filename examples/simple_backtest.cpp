@@ -104,9 +104,10 @@ public:
         const std::string& timeframe) override {
         
         std::vector<quant::data::BarData> filtered_bars;
+        auto symbol_id = quant::data::intern_symbol(symbol);
         
         for (const auto& bar : sample_data_) {
-            if (bar.symbol == symbol && bar.timestamp >= start_time && bar.timestamp <= end_time) {
+            if (bar.symbol == symbol_id && bar.timestamp >= start_time && bar.timestamp <= end_time) {
                 filtered_bars.push_back(bar);
             }
         }
@@ -127,7 +128,7 @@ public:
 private:
     void generate_sample_data() {
         // 生成200天的模拟数据
-        std::string symbol = "BTCUSDT";
+        auto symbol = quant::data::intern_symbol("BTCUSDT");
         double price = 10000.0;
         
         auto now = std::time(nullptr);
@@ -0,0 +1,116 @@
+#include "backtest/backtest_engine.hpp"
+#include "backtest/static_backtest_engine.hpp"
+#include "strategy/moving_average_strategy.hpp"
+#include "strategy/static_moving_average_strategy.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+// 模板回测引擎基准
+// 用法: static_backtest [K线数]
+// 同一组数据上分别用虚函数引擎（逐根on_data、按块on_data_batch）和模板引擎运行10/30双均线，
+// 比较每根K线耗时并校验资金曲线与订单完全一致
+
+namespace {
+
+using quant::backtest::BacktestConfig;
+using quant::backtest::BacktestEngine;
+using quant::backtest::StaticBacktestEngine;
+
+// 从内存中的序列提供数据，排除数据加载对计时的影响
+class MemoryDataFeed : public quant::data::DataFeed {
+public:
+    explicit MemoryDataFeed(quant::data::BarSeries series) : series_(std::move(series)) {}
+
+    quant::data::BarSeries get_bar_series(
+        const std::string&,
+        const quant::data::Timestamp& start_time,
+        const quant::data::Timestamp& end_time,
+        const std::string&) override {
+        return series_.range(start_time, end_time);
+    }
+
+private:
+    quant::data::BarSeries series_;
+};
+
+// 关闭批量接口，使虚函数引擎逐根调用on_data
+class StreamingMovingAverageStrategy : public quant::strategy::MovingAverageStrategy {
+public:
+    using MovingAverageStrategy::MovingAverageStrategy;
+    bool supports_batch() const override { return false; }
+};
+
+template <typename Engine>
+double time_run(Engine& engine, std::size_t count) {
+    auto begin = std::chrono::steady_clock::now();
+    engine.run();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    return seconds * 1e9 / static_cast<double>(count);
+}
+
+template <typename A, typename B>
+bool same_result(const A& a, const B& b) {
+    if (a.get_equity_curve() != b.get_equity_curve() ||
+        a.get_order_history().size() != b.get_order_history().size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.get_order_history().size(); ++i) {
+        const auto& x = a.get_order_history()[i];
+        const auto& y = b.get_order_history()[i];
+        if (x.timestamp != y.timestamp || x.side != y.side || x.quantity != y.quantity || x.price != y.price) {
+            return false;
+        }
+    }
+    const auto ra = a.get_performance_report();
+    const auto rb = b.get_performance_report();
+    return ra.total_return == rb.total_return && ra.sharpe_ratio == rb.sharpe_ratio &&
+           ra.max_drawdown == rb.max_drawdown && ra.volatility == rb.volatility &&
+           ra.total_trades == rb.total_trades && ra.win_rate == rb.win_rate;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    auto symbol = quant::data::intern_symbol("BTCUSDT");
+    std::vector<quant::data::BarData> bars;
+    bars.reserve(count);
+    double price = 10000.0;
+    for (std::size_t i = 0; i < count; ++i) {
+        price += (std::rand() % 2001 - 1000) / 100.0;
+        if (price < 100.0) {
+            price = 100.0;
+        }
+        bars.push_back({static_cast<quant::data::Timestamp>(1577836800 + i * 60), symbol, price, price, price, price, 1.0});
+    }
+    auto feed = std::make_shared<MemoryDataFeed>(quant::data::BarSeries::from_bars(bars, symbol));
+
+    BacktestConfig config;
+    config.start_time = bars.front().timestamp;
+    config.end_time = bars.back().timestamp;
+    config.commission_rate = 0.001;
+
+    BacktestEngine streaming(feed, std::make_shared<StreamingMovingAverageStrategy>(10, 30), config);
+    double streaming_ns = time_run(streaming, count);
+
+    BacktestEngine batch(feed, std::make_shared<quant::strategy::MovingAverageStrategy>(10, 30), config);
+    double batch_ns = time_run(batch, count);
+
+    StaticBacktestEngine<quant::strategy::StaticMovingAverageStrategy<10, 30>> fused(feed, {}, config);
+    double fused_ns = time_run(fused, count);
+
+    bool identical = same_result(streaming, batch) && same_result(streaming, fused);
+    std::cout << std::fixed << std::setprecision(1)
+              << count << " bars, " << fused.get_order_history().size() << " orders\n"
+              << "virtual on_data:       " << streaming_ns << " ns/bar\n"
+              << "virtual on_data_batch: " << batch_ns << " ns/bar\n"
+              << "static engine:         " << fused_ns << " ns/bar\n"
+              << "speedup vs on_data:    " << streaming_ns / fused_ns << "x"
+              << (identical ? "" : "  [MISMATCH]") << "\n";
+    return identical ? 0 : 1;
+}
@@ -0,0 +1,183 @@
+#include "backtest/vectorized_backtest.hpp"
+#include "data/series_data_feed.hpp"
+#include "strategy/moving_average_strategy.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 向量化回测示例
+// 用法: vectorized_backtest [每个品种的K线数] [品种数]
+// 同一组双均线交叉分别用事件驱动引擎和向量化回测运行，核对订单与资金曲线，比较耗时
+
+namespace {
+
+double seconds_since(std::chrono::steady_clock::time_point begin) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+bool same_orders(const std::vector<quant::execution::Order>& a, const std::vector<quant::execution::Order>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].symbol != b[i].symbol || a[i].timestamp != b[i].timestamp || a[i].side != b[i].side ||
+            a[i].quantity != b[i].quantity || a[i].price != b[i].price) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 两条资金曲线的最大相对差，时间点不一致时返回无穷大
+double max_difference(
+    const std::vector<std::pair<quant::data::Timestamp, double>>& a,
+    const std::vector<std::pair<quant::data::Timestamp, double>>& b) {
+    if (a.size() != b.size()) {
+        return INFINITY;
+    }
+    double difference = 0.0;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].first != b[i].first) {
+            return INFINITY;
+        }
+        difference = std::max(difference, std::fabs(a[i].second - b[i].second) / std::fabs(a[i].second));
+    }
+    return difference;
+}
+
+// 按时间戳回放预先算好的信号列，让事件驱动引擎与向量化回测结算同一组信号
+class ReplayStrategy : public quant::strategy::Strategy {
+public:
+    explicit ReplayStrategy(std::vector<quant::backtest::SignalColumn> columns)
+        : columns_(std::move(columns)), cursors_(columns_.size(), 0) {}
+
+    void initialize() override {
+        std::fill(cursors_.begin(), cursors_.end(), 0);
+    }
+
+    std::optional<quant::strategy::Signal> on_data(const quant::data::MarketData& data) override {
+        for (std::size_t s = 0; s < columns_.size(); ++s) {
+            const auto& column = columns_[s];
+            if (column.bars.symbol() != data.symbol) {
+                continue;
+            }
+            std::size_t& i = cursors_[s];
+            while (i < column.bars.size() && column.bars.timestamp_at(i) < data.timestamp) {
+                ++i;
+            }
+            if (i == column.bars.size() || column.bars.timestamp_at(i) != data.timestamp || column.signals[i] == 0.0) {
+                return std::nullopt;
+            }
+            quant::strategy::Signal signal;
+            signal.type = column.signals[i] > 0.0 ? quant::strategy::SignalType::BUY : quant::strategy::SignalType::SELL;
+            signal.symbol = data.symbol;
+            signal.timestamp = data.timestamp;
+            return signal;
+        }
+        return std::nullopt;
+    }
+
+    std::string name() const override { return "ReplayStrategy"; }
+    std::unordered_map<std::string, std::string> parameters() const override { return {}; }
+
+private:
+    std::vector<quant::backtest::SignalColumn> columns_;
+    std::vector<std::size_t> cursors_;
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::size_t symbols = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1;
+
+    quant::backtest::BacktestConfig config;
+    config.commission_rate = 0.001;
+    config.symbols.clear();
+
+    auto data = std::make_shared<quant::data::SeriesDataFeed>();
+    for (std::size_t s = 0; s < symbols; ++s) {
+        std::string name = "SYM" + std::to_string(s);
+        auto symbol = quant::data::intern_symbol(name);
+        std::vector<quant::data::BarData> bars;
+        bars.reserve(count);
+        double price = 100.0 * (s + 1);
+        for (std::size_t i = 0; i < count; ++i) {
+            price *= 1.0 + (std::rand() % 2001 - 1000) / 5e5;
+            // 各品种的时间轴错开，多品种时检验按时间归并
+            bars.push_back({static_cast<quant::data::Timestamp>(1577836800 + i * 60 + s * 20), symbol, price, price, price, price, 1.0});
+        }
+        data->set_series(name, quant::data::BarSeries::from_bars(bars, symbol));
+        config.symbols.push_back(name);
+    }
+    config.start_time = 1577836800;
+    config.end_time = 1577836800 + static_cast<quant::data::Timestamp>(count) * 60;
+
+    // 每个品种预先算好的信号列
+    quant::strategy::VectorizedMovingAverageStrategy strategy(10, 30);
+    std::vector<quant::data::BarSeries> series;
+    std::vector<std::vector<double>> signals;
+    for (const auto& name : config.symbols) {
+        series.push_back(data->series(name));
+        signals.emplace_back(series.back().size(), 0.0);
+        strategy.generate(series.back(), signals.back());
+    }
+    std::vector<quant::backtest::SignalColumn> columns;
+    for (std::size_t s = 0; s < symbols; ++s) {
+        columns.push_back({series[s].view(), signals[s]});
+    }
+
+    // 事件驱动引擎。MovingAverageStrategy的一组均线由所有品种的K线共同更新，
+    // 多品种时改为回放各品种各自的信号列
+    std::shared_ptr<quant::strategy::Strategy> event_strategy;
+    if (symbols == 1) {
+        event_strategy = std::make_shared<quant::strategy::MovingAverageStrategy>(10, 30);
+    } else {
+        event_strategy = std::make_shared<ReplayStrategy>(columns);
+    }
+    auto begin = std::chrono::steady_clock::now();
+    quant::backtest::BacktestEngine engine(data, event_strategy, config);
+    engine.run();
+    double engine_seconds = seconds_since(begin);
+
+    // 向量化回测：生成信号 + 结算
+    quant::backtest::VectorizedBacktest vectorized(config);
+    begin = std::chrono::steady_clock::now();
+    quant::backtest::VectorizedResult result = vectorized.run(*data, strategy);
+    double vectorized_seconds = seconds_since(begin);
+
+    // 只计结算：信号列已经算好（例如来自共享的指标列），结果数组复用上一次回测的内存
+    quant::backtest::VectorizedResult settled;
+    vectorized.run(columns, settled);
+    begin = std::chrono::steady_clock::now();
+    vectorized.run(columns, settled);
+    double settle_seconds = seconds_since(begin);
+
+    const std::size_t bars = count * symbols;
+    bool orders_match = same_orders(engine.get_order_history(), result.orders) &&
+                        same_orders(result.orders, settled.orders);
+    double difference = max_difference(engine.get_equity_curve(), result.equity_curve());
+    const auto& report = engine.get_performance_report();
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << bars << " bars, " << symbols << " symbols, " << result.orders.size() << " orders\n"
+              << "event engine:       " << engine_seconds * 1e9 / bars << " ns/bar, return "
+              << report.total_return * 100 << "%, sharpe " << report.sharpe_ratio << "\n"
+              << "vectorized:         " << vectorized_seconds * 1e9 / bars << " ns/bar, return "
+              << result.report.total_return * 100 << "%, sharpe " << result.report.sharpe_ratio << " ("
+              << engine_seconds / vectorized_seconds << "x)\n"
+              << "settlement, reused: " << settle_seconds * 1e9 / bars << " ns/bar ("
+              << engine_seconds / settle_seconds << "x)\n"
+              << "turnover " << result.turnover << ", commission " << result.commission << "\n"
+              << "orders " << (orders_match ? "identical" : "DIFFERENT")
+              << ", max equity difference " << std::scientific << difference << "\n";
+    return orders_match ? 0 : 1;
+}
@@ -2,6 +2,11 @@
 
 #include "data/data_types.hpp"
 #include "execution/order.hpp"
+#include "utils/binary_stream.hpp"
+#include "utils/span.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <unordered_map>
@@ -28,12 +33,117 @@ struct PerformanceReport {
     std::unordered_map<std::string, double> metrics; // 其他指标
 };
 
+// 资金曲线统计：按时间顺序逐点累计收益、回撤与收益率的均值和方差，不保存曲线本身。
+// 收益率方差用Welford算法在同一遍中累计，分段累计（例如检查点续跑）与一次累计的结果逐位一致
+class EquityStatistics {
+public:
+    void add(data::Timestamp timestamp, double equity) {
+        if (count_ == 0) {
+            first_time_ = timestamp;
+            peak_ = equity;
+        }
+        if (equity > peak_) {
+            peak_ = equity;
+        } else {
+            max_drawdown_ = std::max(max_drawdown_, (peak_ - equity) / peak_);
+        }
+        if (count_ > 0 && last_equity_ > 0) {
+            double value = (equity - last_equity_) / last_equity_;
+            sum_returns_ += value;
+            ++return_count_;
+            double delta = value - running_mean_;
+            running_mean_ += delta / static_cast<double>(return_count_);
+            squared_deviations_ += delta * (value - running_mean_);
+        }
+        last_time_ = timestamp;
+        last_equity_ = equity;
+        ++count_;
+    }
+
+    bool empty() const { return count_ == 0; }
+
+    // 收益率个数、均值与标准差，没有收益率时为0
+    std::uint64_t return_count() const { return return_count_; }
+    double mean_return() const {
+        return return_count_ > 0 ? sum_returns_ / static_cast<double>(return_count_) : 0.0;
+    }
+    double return_std_dev() const {
+        return return_count_ > 0 ? std::sqrt(squared_deviations_ / static_cast<double>(return_count_)) : 0.0;
+    }
+
+    // 写入报告中的收益、回撤、波动率与夏普比率字段
+    void apply(PerformanceReport& report, double initial_capital) const;
+
+    void save_state(utils::BinaryWriter& writer) const;
+    void load_state(utils::BinaryReader& reader);
+
+private:
+    std::uint64_t count_ = 0;
+    data::Timestamp first_time_ = 0;
+    data::Timestamp last_time_ = 0;
+    double last_equity_ = 0.0;
+    double peak_ = 0.0;
+    double max_drawdown_ = 0.0;
+    std::uint64_t return_count_ = 0;
+    double sum_returns_ = 0.0;
+    double running_mean_ = 0.0;
+    double squared_deviations_ = 0.0;  // 收益率与均值之差的平方和
+};
+
+// 交易统计：成交按买卖成对配成一笔交易（第1、2笔一对，第3、4笔一对……），末尾未配对的开仓不计入盈亏
+class TradeStatistics {
+public:
+    void add(const execution::Order& order);
+
+    // 丢弃未配对的开仓，之后的成交重新开始配对。用于拼接互相独立的多段回测，
+    // 使某段期末的持仓不会与下一段的成交错位配对
+    void end_segment() { has_entry_ = false; }
+
+    // 写入报告中的交易统计字段
+    void apply(PerformanceReport& report) const;
+
+    void save_state(utils::BinaryWriter& writer) const;
+    void load_state(utils::BinaryReader& reader);
+
+private:
+    int order_count_ = 0;
+    bool has_entry_ = false;
+    execution::OrderSide entry_side_ = execution::OrderSide::BUY;
+    double entry_value_ = 0.0;
+    int winning_trades_ = 0;
+    int losing_trades_ = 0;
+    double total_profit_ = 0.0;
+    double total_loss_ = 0.0;
+    double largest_profit_ = 0.0;
+    double largest_loss_ = 0.0;
+};
+
 // 计算性能指标
 PerformanceReport calculate_performance(
     const std::vector<std::pair<data::Timestamp, double>>& equity_curve,
     const std::vector<execution::Order>& orders,
     double initial_capital);
 
+// 按列存储的资金曲线计算性能指标，结果与上面的版本相同
+PerformanceReport calculate_performance(
+    utils::Span<const data::Timestamp> timestamps,
+    utils::Span<const double> equity,
+    const std::vector<execution::Order>& orders,
+    double initial_capital);
+
+// 交易统计已单独累计时使用，资金曲线部分与上面的版本相同
+PerformanceReport calculate_performance(
+    utils::Span<const data::Timestamp> timestamps,
+    utils::Span<const double> equity,
+    const TradeStatistics& trades,
+    double initial_capital);
+
+// 由逐点累计的统计量生成报告，与对同一资金曲线和订单调用上面的版本结果逐位一致
+PerformanceReport calculate_performance(
+    const EquityStatistics& equity,
+    const TradeStatistics& trades,
+    double initial_capital);
+
 // 计算回撤
 std::vector<std::pair<data::Timestamp, double>> calculate_drawdowns(
     const std::vector<std::pair<data::Timestamp, double>>& equity_curve);
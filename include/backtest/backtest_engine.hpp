@@ -1,10 +1,14 @@
 #pragma once
 
 #include "data/data_feed.hpp"
+#include "data/bar_stream.hpp"
+#include "backtest/portfolio.hpp"
 #include "strategy/strategy.hpp"
 #include "execution/order.hpp"
 #include "analysis/performance.hpp"
+#include <cstdint>
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -18,8 +22,29 @@ struct BacktestConfig {
     double initial_capital = 100000;  // 初始资金
     double commission_rate = 0.0;     // 手续费率
     bool use_fractional_shares = false; // 是否使用分数股份
+    std::vector<std::string> symbols = {"BTCUSDT"};  // 回测品种
+    std::string timeframe = "1d";     // K线周期
+    // 分块加载的时间跨度（秒），0表示每个品种一次加载整个区间；
+    // 数据源支持高效区间查询（如MmapBarStore）时设置该值可让内存与品种数×块大小成正比
+    data::Timestamp chunk_duration = 0;
+    // 预热时长（秒）：start_time之前这段时间的K线只交给策略更新指标，不成交、不计入资金曲线
+    data::Timestamp warmup_duration = 0;
 };
 
+// 为每个回测品种创建分块数据来源
+std::vector<std::unique_ptr<data::BarChunkSource>> make_chunk_sources(
+    const std::shared_ptr<data::DataFeed>& data_feed,
+    const BacktestConfig& config);
+
+// 预热区间[start_time - warmup_duration, start_time)的数据来源，warmup_duration为0时为空。
+// 各引擎把其中的K线按时间顺序只交给策略更新状态，不成交、不计入资金曲线
+std::vector<std::unique_ptr<data::BarChunkSource>> make_warmup_sources(
+    const std::shared_ptr<data::DataFeed>& data_feed,
+    const BacktestConfig& config);
+
+// 读取BacktestEngine::append_history写出的历史文件
+BacktestHistory load_history(const std::string& path);
+
 // 回测引擎
 class BacktestEngine {
 public:
@@ -31,32 +56,87 @@ public:
     // 运行回测
     void run();
     
+    // 分段运行：start()后可多次调用run_until()逐段推进，最后调用finish()计算性能指标。
+    // 引擎与策略的状态在各段之间保留，分段运行到结束与run()的结果一致。
+    // 分段运行始终逐根调用on_data，不使用批量接口
+    void start();
+    
+    // 处理时间戳不晚于time的全部K线，返回是否还有剩余数据
+    bool run_until(data::Timestamp time);
+    
+    // 结束分段运行并计算性能指标，未处理的数据不再处理
+    void finish();
+    
+    // 截至当前已处理数据的性能指标，用于运行中途评估
+    analysis::PerformanceReport current_report() const;
+    
+    // 已处理的K线数
+    std::uint64_t bars_processed() const { return bars_processed_; }
+    
     // 获取性能报告
     analysis::PerformanceReport get_performance_report() const;
     
-    // 获取订单历史
+    // 获取订单历史；从检查点恢复时只包含恢复之后的部分，完整历史见append_history
     const std::vector<execution::Order>& get_order_history() const;
     
-    // 获取资金曲线
+    // 获取资金曲线；从检查点恢复时只包含恢复之后的部分，完整历史见append_history
     const std::vector<std::pair<data::Timestamp, double>>& get_equity_curve() const;
     
+    // 获取某品种当前持仓
+    double get_position(data::SymbolId symbol) const;
+    
+    // 获取当前总资产
+    double get_equity() const { return portfolio_.equity(); }
+    
+    // 检查点：账户、报告统计量、已处理K线数与策略状态（通过Strategy::save_state）的二进制快照，
+    // 大小与已处理的K线数无关。可在run()结束后或分段运行的两段之间调用；
+    // 策略不支持检查点时抛出logic_error
+    std::vector<std::uint8_t> checkpoint() const;
+    
+    // 把检查点写入文件：先写临时文件再改名，写入失败不会破坏已有的检查点
+    void save_checkpoint(const std::string& path) const;
+    
+    // 在尚未运行的引擎上恢复检查点，之后run()/start()跳过预热，只处理快照中最后时间戳之后的K线，
+    // 恢复与续跑的耗时只与新K线数有关，报告与不间断运行到同一结束时间逐位一致。
+    // 结束时间与分块大小可以与快照不同，其余配置或策略与快照不符时抛出runtime_error
+    void restore(const std::vector<std::uint8_t>& snapshot);
+    
+    // 从文件读取并恢复检查点
+    void load_checkpoint(const std::string& path);
+    
+    // 把上次写出以来新增的订单和资金曲线点追加到历史文件，文件不存在时创建。
+    // 检查点不含历史：需要完整历史时，每次保存检查点前调用一次，续跑结束后再调用一次，
+    // load_history读回的内容与不间断运行的订单历史、资金曲线相同
+    void append_history(const std::string& path);
+    
 private:
+    // 本次运行读取数据的配置：从检查点恢复时开始时间移到快照之后
+    BacktestConfig data_config() const;
+    
+    // 初始化策略并用预热区间的K线推进其状态
+    void prepare_strategy();
+    
+    // 逐根K线调用on_data
+    void process_bar(const data::BarData& bar);
+    
+    // 单品种且策略支持批量接口时按块调用on_data_batch
+    void run_batch();
+    
+    // 记录最后一个资金曲线点并计算性能指标
+    void complete();
+    
     // 处理交易信号
     void process_signal(const strategy::Signal& signal, const data::BarData& bar);
     
-    // 更新投资组合
-    void update_portfolio(const data::BarData& bar);
-    
     std::shared_ptr<data::DataFeed> data_feed_;
     std::shared_ptr<strategy::Strategy> strategy_;
     BacktestConfig config_;
     
-    double cash_;                     // 当前现金
-    double equity_;                   // 当前总资产
-    std::unordered_map<std::string, double> positions_;  // 当前持仓
+    Portfolio portfolio_;  // 现金、持仓、订单历史与资金曲线
     
-    std::vector<execution::Order> order_history_;  // 订单历史
-    std::vector<std::pair<data::Timestamp, double>> equity_curve_;  // 资金曲线
+    std::unique_ptr<data::MergedBarStream> stream_;  // 分段运行时按时间归并的数据流
+    std::uint64_t bars_processed_ = 0;
+    bool restored_ = false;  // 状态来自检查点，运行时不再初始化和预热策略
     
     analysis::PerformanceReport performance_report_;  // 性能报告
 };
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "backtest/backtest_engine.hpp"
+#include "data/series_data_feed.hpp"
+#include "utils/thread_pool.hpp"
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace quant {
+namespace backtest {
+
+// 一组策略参数，按加入网格的顺序保存
+class ParameterSet {
+public:
+    void set(const std::string& name, double value);
+
+    // 参数值，不存在时抛出std::out_of_range
+    double get(const std::string& name) const;
+    int get_int(const std::string& name) const;
+
+    bool contains(const std::string& name) const;
+    const std::vector<std::pair<std::string, double>>& values() const { return values_; }
+
+    // 形如"fast=10,slow=30"
+    std::string to_string() const;
+
+private:
+    std::vector<std::pair<std::string, double>> values_;
+};
+
+// 参数网格：各参数取值的笛卡尔积，可附加约束过滤无效组合（如快线周期须小于慢线）
+class ParameterGrid {
+public:
+    // 参数的全部取值
+    ParameterGrid& add(const std::string& name, std::vector<double> values);
+
+    // first到last（含）按step递增的取值
+    ParameterGrid& add_range(const std::string& name, double first, double last, double step);
+
+    // 只保留满足约束的组合
+    ParameterGrid& where(std::function<bool(const ParameterSet&)> constraint);
+
+    // 未经约束过滤的组合数
+    std::size_t cartesian_size() const;
+
+    // 满足全部约束的组合，最后加入的参数变化最快
+    std::vector<ParameterSet> combinations() const;
+
+private:
+    std::vector<std::pair<std::string, std::vector<double>>> axes_;
+    std::vector<std::function<bool(const ParameterSet&)>> constraints_;
+};
+
+// 一组参数的回测结果
+struct SweepResult {
+    ParameterSet parameters;
+    analysis::PerformanceReport report;
+    double final_equity = 0.0;
+    std::size_t order_count = 0;
+    std::string error;  // 非空表示该组参数运行失败，其余字段无意义
+
+    bool ok() const { return error.empty(); }
+};
+
+// 按名称读取性能指标：total_return、sharpe_ratio、max_drawdown等字段名，
+// 或final_equity，或report.metrics中的键；未知名称抛出std::invalid_argument
+double result_metric(const SweepResult& result, const std::string& metric);
+
+// 参数扫描结果表，行顺序与输入参数顺序一致（排序后除外）
+class SweepResults {
+public:
+    SweepResults() = default;
+    explicit SweepResults(std::vector<SweepResult> rows) : rows_(std::move(rows)) {}
+
+    std::size_t size() const { return rows_.size(); }
+    bool empty() const { return rows_.empty(); }
+    const SweepResult& operator[](std::size_t i) const { return rows_[i]; }
+    std::vector<SweepResult>::const_iterator begin() const { return rows_.begin(); }
+    std::vector<SweepResult>::const_iterator end() const { return rows_.end(); }
+
+    // 失败的行数
+    std::size_t failures() const;
+
+    // 按指标排序，失败的行排在最后
+    void sort_by(const std::string& metric, bool descending = true);
+
+    // 指标最优的成功行，没有成功行时抛出std::runtime_error
+    const SweepResult& best(const std::string& metric, bool maximize = true) const;
+
+    // 以CSV输出：各参数列、主要指标列和error列
+    void write_csv(std::ostream& out) const;
+
+private:
+    std::vector<SweepResult> rows_;
+};
+
+// 从data_feed一次性加载config.symbols在回测区间（含预热时长）内的数据，供多个回测实例共享
+std::shared_ptr<data::SeriesDataFeed> load_backtest_data(data::DataFeed& data_feed, const BacktestConfig& config);
+
+// 在共享的内存数据上运行回测实例所用的配置：检查data非空，并让每个引擎一次取出整个区间的切片
+BacktestConfig shared_data_config(const std::shared_ptr<data::SeriesDataFeed>& data, BacktestConfig config);
+
+// 由参数创建策略实例；会在多个工作线程上同时调用，须线程安全
+using StrategyBuilder = std::function<std::shared_ptr<strategy::Strategy>(const ParameterSet&)>;
+
+// 多线程参数扫描
+//
+// 构造时把回测区间内各品种的数据加载进只读的SeriesDataFeed，之后所有回测实例共享这份
+// 数据，按区间切片读取，不再复制或重新加载。每组参数在线程池上各自创建策略和
+// BacktestEngine运行，工作线程从共享计数器领取下一组参数，负载自动均衡。
+// 单组参数抛出的异常记录在该行的error中，不影响其他参数。
+class ParameterSweep {
+public:
+    // 数据由load_backtest_data加载；threads为0时使用硬件并发数
+    ParameterSweep(data::DataFeed& data_feed, BacktestConfig config, std::size_t threads = 0);
+
+    // 使用已加载的数据
+    ParameterSweep(std::shared_ptr<data::SeriesDataFeed> data, BacktestConfig config, std::size_t threads = 0);
+
+    SweepResults run(const ParameterGrid& grid, const StrategyBuilder& builder);
+    SweepResults run(const std::vector<ParameterSet>& parameters, const StrategyBuilder& builder);
+
+    const std::shared_ptr<data::SeriesDataFeed>& data() const { return data_; }
+    const BacktestConfig& config() const { return config_; }
+    std::size_t threads() const { return pool_.size(); }
+
+private:
+    SweepResult run_one(const ParameterSet& parameters, const StrategyBuilder& builder) const;
+
+    std::shared_ptr<data::SeriesDataFeed> data_;
+    BacktestConfig config_;
+    utils::ThreadPool pool_;
+};
+
+} // namespace backtest
+} // namespace quant
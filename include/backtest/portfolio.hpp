@@ -0,0 +1,147 @@
+#pragma once
+
+#include "analysis/performance.hpp"
+#include "data/data_types.hpp"
+#include "execution/order.hpp"
+#include "strategy/strategy.hpp"
+#include "utils/binary_stream.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace quant {
+namespace backtest {
+
+// 订单历史与资金曲线，由Portfolio::append_history分段写出、read_history读回
+struct BacktestHistory {
+    std::vector<execution::Order> orders;
+    std::vector<std::pair<data::Timestamp, double>> equity_curve;
+};
+
+// 回测账户：现金、持仓、订单历史与资金曲线
+//
+// 虚函数回测引擎与模板回测引擎共用同一套成交与估值逻辑，保证两者结果一致。
+// 每根K线按 begin_bar -> execute（有信号时）-> mark 的顺序调用，全部K线处理完后调用finish。
+// 逐K线调用的begin_bar/mark定义在头文件中，便于内联进引擎主循环。
+// 资金曲线点与订单记录时同时累计进报告所需的统计量，report()不需要遍历历史。
+class Portfolio {
+public:
+    Portfolio(double initial_capital, double commission_rate, bool use_fractional_shares);
+
+    // 新K线开始：时间戳变化时为上一时间点记录一次资金曲线
+    void begin_bar(data::Timestamp timestamp) {
+        if (has_bar_ && timestamp != current_time_) {
+            equity_curve_.emplace_back(current_time_, equity_);
+            equity_statistics_.add(current_time_, equity_);
+        }
+        has_bar_ = true;
+        current_time_ = timestamp;
+    }
+
+    // 以price成交信号：买入使用可用资金的90%，卖出清空该品种持仓
+    void execute(strategy::SignalType type, data::SymbolId symbol, data::Timestamp timestamp, double price);
+
+    // 按收盘价重估该品种持仓市值并更新总资产
+    void mark(data::SymbolId symbol, double close) {
+        ensure_symbol_slot(symbol);
+
+        // 按最新价格重估该品种持仓市值，其他品种沿用各自最新价格
+        double quantity = positions_[symbol];
+        if (quantity != 0.0) {
+            market_value_ -= quantity * last_prices_[symbol];
+            market_value_ += quantity * close;
+        }
+        last_prices_[symbol] = close;
+
+        // 更新总资产
+        equity_ = cash_ + market_value_;
+    }
+
+    // 记录最后一个时间点的资金曲线。该点只追加到曲线，不计入统计量，
+    // 从检查点续跑时由begin_bar照常记录
+    void finish() {
+        if (has_bar_ && !finished_) {
+            equity_curve_.emplace_back(current_time_, equity_);
+            finished_ = true;
+        }
+    }
+
+    // 包含当前时间点的资金曲线副本，用于回测中途评估
+    std::vector<std::pair<data::Timestamp, double>> equity_curve_snapshot() const {
+        std::vector<std::pair<data::Timestamp, double>> curve;
+        curve.reserve(equity_curve_.size() + 1);
+        curve.insert(curve.end(), equity_curve_.begin(), equity_curve_.end());
+        if (has_bar_) {
+            curve.emplace_back(current_time_, equity_);
+        }
+        return curve;
+    }
+
+    // 截至当前时间点（含尚未记入资金曲线的当前点）的性能指标，与对完整资金曲线和订单历史
+    // 调用analysis::calculate_performance的结果逐位一致
+    analysis::PerformanceReport report(double initial_capital) const;
+
+    // 写出现金、持仓与报告统计量，大小与已处理的K线数无关；订单历史与资金曲线不写入，
+    // 需要时用append_history另行保存。品种按名称保存，与进程内的品种编号无关
+    void save_state(utils::BinaryWriter& writer) const;
+
+    // 读取save_state写出的状态，替换当前全部内容。恢复后订单历史与资金曲线只包含之后新增的部分
+    void load_state(utils::BinaryReader& reader);
+
+    // 写出上次写出（或恢复）以来新增的订单和资金曲线点，以及当前时间点。
+    // 检查点之前的部分必须已经写出，否则抛出logic_error
+    void append_history(utils::BinaryWriter& writer);
+
+    // 依次读取append_history写出的各段，拼接后追加到history
+    static void read_history(utils::BinaryReader& reader, BacktestHistory& history);
+
+    bool has_bar() const { return has_bar_; }
+    data::Timestamp current_time() const { return current_time_; }
+
+    double cash() const { return cash_; }
+    double equity() const { return equity_; }
+    double position(data::SymbolId symbol) const {
+        return symbol < positions_.size() ? positions_[symbol] : 0.0;
+    }
+
+    // 本进程内记录的订单历史与资金曲线；从检查点恢复时只包含恢复之后的部分
+    const std::vector<execution::Order>& order_history() const { return order_history_; }
+    const std::vector<std::pair<data::Timestamp, double>>& equity_curve() const { return equity_curve_; }
+
+private:
+    // 确保持仓数组覆盖该品种编号
+    void ensure_symbol_slot(data::SymbolId symbol) {
+        if (symbol >= positions_.size()) {
+            positions_.resize(static_cast<std::size_t>(symbol) + 1, 0.0);
+            last_prices_.resize(static_cast<std::size_t>(symbol) + 1, 0.0);
+        }
+    }
+
+    double commission_rate_;
+    bool use_fractional_shares_;
+
+    double cash_;                     // 当前现金
+    double equity_;                   // 当前总资产
+    double market_value_ = 0.0;       // 当前持仓市值
+    std::vector<double> positions_;   // 当前持仓，按品种编号索引
+    std::vector<double> last_prices_; // 各品种最新价格，按品种编号索引
+
+    bool has_bar_ = false;
+    bool finished_ = false;           // finish()已追加最后一个资金曲线点
+    data::Timestamp current_time_ = 0;
+
+    std::vector<execution::Order> order_history_;  // 订单历史
+    std::vector<std::pair<data::Timestamp, double>> equity_curve_;  // 资金曲线
+    analysis::EquityStatistics equity_statistics_;  // 已记入资金曲线的点的统计量
+    analysis::TradeStatistics trade_statistics_;
+
+    // 检查点之前的订单数与资金曲线点数（不在上面的数组中），以及已写出的订单数与点数，均从头计数
+    std::uint64_t orders_before_ = 0;
+    std::uint64_t points_before_ = 0;
+    std::uint64_t orders_written_ = 0;
+    std::uint64_t points_written_ = 0;
+};
+
+} // namespace backtest
+} // namespace quant
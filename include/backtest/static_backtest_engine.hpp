@@ -0,0 +1,99 @@
+#pragma once
+
+#include "backtest/backtest_engine.hpp"
+#include "backtest/portfolio.hpp"
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace quant {
+namespace backtest {
+
+// 以策略类型为模板参数的回测引擎
+//
+// 策略按值持有，on_data通过具体类型调用，不经过虚函数表；配合final策略（如
+// StaticMovingAverageStrategy）和头文件中的Portfolio::begin_bar/mark，编译器可以把指标更新、
+// 信号判断和组合估值内联进同一个循环。成交与估值逻辑与BacktestEngine共用，结果一致。
+//
+// StrategyT只需提供initialize()和on_data(const data::MarketData&)（返回std::optional<Signal>），
+// 不要求继承strategy::Strategy。运行时按名字创建的策略（StrategyFactory）仍使用BacktestEngine。
+template <typename StrategyT>
+class StaticBacktestEngine {
+public:
+    StaticBacktestEngine(
+        std::shared_ptr<data::DataFeed> data_feed,
+        StrategyT strategy,
+        BacktestConfig config)
+        : data_feed_(std::move(data_feed)),
+          strategy_(std::move(strategy)),
+          config_(std::move(config)),
+          portfolio_(config_.initial_capital, config_.commission_rate, config_.use_fractional_shares) {
+        if (!data_feed_) {
+            throw std::invalid_argument("Data feed cannot be null");
+        }
+    }
+
+    // 运行回测
+    void run() {
+        strategy_.initialize();
+
+        // 预热区间的K线只更新策略状态，与BacktestEngine相同
+        data::MergedBarStream warmup(make_warmup_sources(data_feed_, config_));
+        data::BarData bar;
+        while (warmup.next(bar)) {
+            strategy_.on_data(bar);
+        }
+
+        auto sources = make_chunk_sources(data_feed_, config_);
+        if (sources.size() == 1) {
+            // 单品种直接遍历各块，不经过归并
+            for (auto chunk = sources.front()->next_chunk(); !chunk.empty();
+                 chunk = sources.front()->next_chunk()) {
+                const data::BarSeriesView& bars = chunk.view();
+                for (std::size_t i = 0; i < bars.size(); ++i) {
+                    step(bars[i]);
+                }
+            }
+        } else {
+            data::MergedBarStream stream(std::move(sources));
+            while (stream.next(bar)) {
+                step(bar);
+            }
+        }
+        portfolio_.finish();
+
+        // 计算性能指标，由组合记录时累计的统计量得出，与BacktestEngine相同
+        performance_report_ = portfolio_.report(config_.initial_capital);
+    }
+
+    analysis::PerformanceReport get_performance_report() const { return performance_report_; }
+    const std::vector<execution::Order>& get_order_history() const { return portfolio_.order_history(); }
+    const std::vector<std::pair<data::Timestamp, double>>& get_equity_curve() const {
+        return portfolio_.equity_curve();
+    }
+    double get_position(data::SymbolId symbol) const { return portfolio_.position(symbol); }
+
+    StrategyT& strategy() { return strategy_; }
+    const StrategyT& strategy() const { return strategy_; }
+
+private:
+    // 处理一根K线，与BacktestEngine的逐根处理顺序相同
+    void step(const data::BarData& bar) {
+        portfolio_.begin_bar(bar.timestamp);
+        auto signal = strategy_.on_data(bar);
+        if (signal) {
+            portfolio_.execute(signal->type, signal->symbol, signal->timestamp, bar.close);
+        }
+        portfolio_.mark(bar.symbol, bar.close);
+    }
+
+    std::shared_ptr<data::DataFeed> data_feed_;
+    StrategyT strategy_;
+    BacktestConfig config_;
+    Portfolio portfolio_;
+    analysis::PerformanceReport performance_report_;
+};
+
+} // namespace backtest
+} // namespace quant
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "backtest/parameter_sweep.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace quant {
+namespace backtest {
+
+// 逐轮淘汰的选项
+struct HalvingOptions {
+    std::string metric = "sharpe_ratio";  // 排序依据，取值见result_metric
+    bool maximize = true;
+    double eta = 3.0;                     // 每轮保留约1/eta的候选
+    std::size_t min_survivors = 1;        // 每轮至少保留的候选数
+    // 第一轮至少使用的历史比例，限制自动确定的轮数。第一轮应长于策略的预热期，
+    // 否则尚未产生交易的候选之间无法区分
+    double min_fraction = 0.05;
+    // 各轮截止位置占回测区间的比例（升序，最后一轮总是1.0）；为空时按eta几何递增自动确定
+    std::vector<double> fractions;
+};
+
+// 一轮的统计
+struct HalvingRound {
+    data::Timestamp end_time = 0;   // 本轮评估截止的时间戳
+    double fraction = 0.0;          // 截止位置占回测区间的比例
+    std::size_t candidates = 0;     // 参加本轮的候选数
+    std::size_t survivors = 0;      // 晋级下一轮的候选数（最后一轮为决选候选数）
+};
+
+// 逐轮淘汰的结果
+struct HalvingResult {
+    SweepResults finalists;   // 完整区间上的结果，按指标从优到劣排列
+    SweepResults eliminated;  // 被淘汰或运行失败的候选，报告为淘汰时的中途结果
+    std::vector<HalvingRound> rounds;
+    std::uint64_t bars_processed = 0;   // 全部候选实际处理的K线数
+    std::uint64_t exhaustive_bars = 0;  // 穷举全部候选需要处理的K线数
+
+    // 最优参数，没有候选跑完全程时抛出std::runtime_error
+    const SweepResult& best() const;
+};
+
+// 逐轮淘汰（successive halving）参数优化
+//
+// 全部候选先在回测区间开头的一小段上运行，按指标排序后只保留前1/eta，晋级者在更长的
+// 区间上继续，直到最后一轮跑完整个区间。晋级者的引擎、策略和指标状态在各轮之间保留，
+// 每轮只处理新增的K线，不从头重跑；跑完全程的候选，结果与单独运行BacktestEngine一致。
+// 与ParameterSweep相同，数据只加载一次，各候选在线程池上并行推进。
+//
+// 存活的候选在整个优化过程中各持有一个引擎，内存与候选数成正比。
+class SuccessiveHalving {
+public:
+    // 数据由load_backtest_data加载；threads为0时使用硬件并发数
+    SuccessiveHalving(
+        data::DataFeed& data_feed,
+        BacktestConfig config,
+        HalvingOptions options = HalvingOptions(),
+        std::size_t threads = 0);
+
+    // 使用已加载的数据
+    SuccessiveHalving(
+        std::shared_ptr<data::SeriesDataFeed> data,
+        BacktestConfig config,
+        HalvingOptions options = HalvingOptions(),
+        std::size_t threads = 0);
+
+    HalvingResult run(const ParameterGrid& grid, const StrategyBuilder& builder);
+    HalvingResult run(const std::vector<ParameterSet>& parameters, const StrategyBuilder& builder);
+
+    const HalvingOptions& options() const { return options_; }
+
+private:
+    // 各轮截止位置占回测区间的比例
+    std::vector<double> round_fractions(std::size_t candidates) const;
+
+    std::shared_ptr<data::SeriesDataFeed> data_;
+    BacktestConfig config_;
+    HalvingOptions options_;
+    utils::ThreadPool pool_;
+};
+
+} // namespace backtest
+} // namespace quant
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "backtest/backtest_engine.hpp"
+#include "data/bar_series.hpp"
+#include "strategy/vectorized_strategy.hpp"
+#include "utils/span.hpp"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace quant {
+namespace backtest {
+
+// 信号列中值的含义
+enum class SignalMode {
+    SIGNALS,  // >0买入、<0卖出、0无操作，按收盘价成交，规则与BacktestEngine相同
+    TARGETS   // 目标持仓市值占总资产的比例，值变化时按收盘价调仓，NaN表示维持当前持仓
+};
+
+// 一个品种的K线与逐根对齐的信号列
+struct SignalColumn {
+    data::BarSeriesView bars;
+    utils::Span<const double> signals;
+};
+
+// 向量化回测结果
+struct VectorizedResult {
+    std::vector<data::Timestamp> timestamps;  // 所有品种K线时间戳的并集
+    std::vector<double> equity;               // 各时间点的总资产
+    std::vector<execution::Order> orders;
+    double commission = 0.0;  // 手续费合计
+    double turnover = 0.0;    // 成交额合计与平均总资产之比
+    analysis::PerformanceReport report;
+
+    // 与BacktestEngine::get_equity_curve()格式相同的资金曲线
+    std::vector<std::pair<data::Timestamp, double>> equity_curve() const;
+};
+
+// 向量化回测
+//
+// 策略一次给出整列信号，成交、手续费、现金和资金曲线不再逐根K线推进：
+// 先只在有信号的K线上按时间顺序结算现金与持仓（成交数量取决于当时的现金，这一步只能顺序进行，
+// 但只访问信号所在的位置），两次成交之间现金与持仓不变，资金曲线按段用数组运算
+// 现金 + 持仓 × 收盘价 一次写出，循环按运行时CPU向量化。
+//
+// 信号模式下订单与BacktestEngine逐笔一致；资金曲线直接由持仓与收盘价计算，
+// 与引擎逐根累计的持仓市值只有舍入级别的差异。适用于按收盘价成交的市价单策略，
+// 不支持限价、止损等依赖盘中价格的订单。
+class VectorizedBacktest {
+public:
+    explicit VectorizedBacktest(BacktestConfig config, SignalMode mode = SignalMode::SIGNALS);
+
+    // 从data_feed加载config.symbols在回测区间（含预热时长）内的数据，逐品种生成信号后回测；
+    // 预热区间的信号丢弃，不计入资金曲线
+    VectorizedResult run(data::DataFeed& data_feed, strategy::VectorizedStrategy& strategy) const;
+
+    // 单品种，使用bars的全部K线，不按config的时间范围截取
+    VectorizedResult run(const data::BarSeriesView& bars, utils::Span<const double> signals) const;
+
+    // 多品种：同一时间戳上按columns中的顺序成交
+    VectorizedResult run(const std::vector<SignalColumn>& columns) const;
+
+    // 结果写入result并复用其中数组的容量，参数扫描等反复回测时避免重新分配大块内存
+    void run(const std::vector<SignalColumn>& columns, VectorizedResult& result) const;
+
+    const BacktestConfig& config() const { return config_; }
+    SignalMode mode() const { return mode_; }
+
+private:
+    BacktestConfig config_;
+    SignalMode mode_;
+};
+
+} // namespace backtest
+} // namespace quant
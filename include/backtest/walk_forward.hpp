@@ -0,0 +1,104 @@
+#pragma once
+
+#include "backtest/parameter_sweep.hpp"
+#include "indicators/indicator_columns.hpp"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace quant {
+namespace backtest {
+
+// 样本内窗口的推进方式
+enum class WindowMode {
+    ROLLING,   // 固定长度，随各折一起向前滚动
+    ANCHORED   // 起点固定在数据开头，长度逐折增加
+};
+
+// 滚动验证选项
+struct WalkForwardOptions {
+    WindowMode mode = WindowMode::ROLLING;
+    data::Timestamp in_sample = 0;       // 样本内窗口长度（秒），锚定模式下为第一折的长度
+    data::Timestamp out_of_sample = 0;   // 样本外窗口长度（秒），也是相邻两折的间隔
+    data::Timestamp warmup = 0;          // 每个窗口开始前只用于策略预热的时长（秒）
+    std::string metric = "sharpe_ratio"; // 样本内选优的指标，取值见result_metric
+    bool maximize = true;
+};
+
+// 一折的结果
+struct WalkForwardFold {
+    data::Timestamp in_sample_start = 0;
+    data::Timestamp in_sample_end = 0;
+    data::Timestamp out_of_sample_start = 0;
+    data::Timestamp out_of_sample_end = 0;
+
+    ParameterSet parameters;                   // 样本内最优参数
+    analysis::PerformanceReport in_sample;     // 最优参数的样本内表现
+    analysis::PerformanceReport out_of_sample; // 最优参数的样本外表现
+    std::vector<std::pair<data::Timestamp, double>> equity_curve;  // 样本外资金曲线，从初始资金开始
+    std::vector<execution::Order> orders;      // 样本外订单
+    std::string error;                         // 非空表示该折没有可用结果
+
+    bool ok() const { return error.empty(); }
+};
+
+// 滚动验证结果
+struct WalkForwardResult {
+    std::vector<WalkForwardFold> folds;
+    // 各折样本外资金曲线按收益率首尾相接：每折以上一折的期末资金为起点等比例缩放
+    std::vector<std::pair<data::Timestamp, double>> equity_curve;
+    std::vector<execution::Order> orders;  // 各折样本外订单，数量未缩放
+    analysis::PerformanceReport report;    // 拼接曲线的性能指标，交易按折分别配对
+    std::size_t backtests = 0;             // 运行的回测次数
+};
+
+// 滚动验证（walk-forward analysis）
+//
+// 把数据划分为若干折，每折在样本内窗口上对全部候选参数回测并按指标选出最优，再用最优
+// 参数在紧随其后的样本外窗口上回测，最后把各折样本外资金曲线拼接成一条。
+//
+// 所有折的样本内回测展开为一个任务列表在线程池上并行运行，之后各折的样本外回测并行运行。
+// 数据只加载一次，各窗口取共享存储的切片；columns()提供的指标列缓存在整段历史上计算，
+// 策略通过它读取指标时，重叠窗口之间不再重复计算，窗口开头也无需预热。
+class WalkForward {
+public:
+    // 数据由load_backtest_data加载；threads为0时使用硬件并发数
+    WalkForward(
+        data::DataFeed& data_feed,
+        BacktestConfig config,
+        WalkForwardOptions options,
+        std::size_t threads = 0);
+
+    // 使用已加载的数据
+    WalkForward(
+        std::shared_ptr<data::SeriesDataFeed> data,
+        BacktestConfig config,
+        WalkForwardOptions options,
+        std::size_t threads = 0);
+
+    WalkForwardResult run(const ParameterGrid& grid, const StrategyBuilder& builder);
+    WalkForwardResult run(const std::vector<ParameterSet>& parameters, const StrategyBuilder& builder);
+
+    // 在已加载数据上共享的指标列缓存，供StrategyBuilder创建读取指标列的策略
+    const std::shared_ptr<indicators::IndicatorColumnCache>& columns() const { return columns_; }
+
+    const std::shared_ptr<data::SeriesDataFeed>& data() const { return data_; }
+    const WalkForwardOptions& options() const { return options_; }
+
+    // 按数据范围划分的各折窗口（只填写时间字段）
+    std::vector<WalkForwardFold> make_folds() const;
+
+private:
+    BacktestConfig window_config(data::Timestamp start_time, data::Timestamp end_time) const;
+
+    std::shared_ptr<data::SeriesDataFeed> data_;
+    BacktestConfig config_;
+    WalkForwardOptions options_;
+    std::shared_ptr<indicators::IndicatorColumnCache> columns_;
+    utils::ThreadPool pool_;
+};
+
+} // namespace backtest
+} // namespace quant
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "bar_series.hpp"
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace quant {
+namespace data {
+
+// 缓存统计
+struct BarCacheStats {
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t evictions = 0;
+    std::size_t memory_bytes = 0;
+    std::size_t segments = 0;
+};
+
+// 按(品种, 周期)组织的区间缓存
+//
+// 每个键下保存互不重叠的已覆盖时间区间；插入时与重叠或相邻的区间合并，
+// 查询区间被某个已缓存区间完全覆盖时直接返回共享存储的子序列。
+// 总内存超过预算时按最近最少使用淘汰区间。线程安全。
+class BarCache {
+public:
+    explicit BarCache(std::size_t memory_budget_bytes);
+
+    // 查询[start_time, end_time]，完全命中时写入out并返回true
+    bool lookup(
+        SymbolId symbol,
+        const std::string& timeframe,
+        Timestamp start_time,
+        Timestamp end_time,
+        BarSeries& out);
+
+    // 记录[start_time, end_time]的查询结果（series可以为空，表示该区间无数据）
+    void insert(
+        SymbolId symbol,
+        const std::string& timeframe,
+        Timestamp start_time,
+        Timestamp end_time,
+        const BarSeries& series);
+
+    void set_budget(std::size_t memory_budget_bytes);
+    std::size_t budget() const;
+    void clear();
+    BarCacheStats stats() const;
+
+private:
+    struct Key {
+        SymbolId symbol;
+        std::string timeframe;
+
+        bool operator==(const Key& other) const {
+            return symbol == other.symbol && timeframe == other.timeframe;
+        }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const {
+            return std::hash<std::string>()(key.timeframe) * 31 + key.symbol;
+        }
+    };
+
+    struct LruEntry {
+        Key key;
+        Timestamp start;
+    };
+
+    struct Segment {
+        Timestamp end;
+        BarSeries series;
+        std::list<LruEntry>::iterator lru;
+    };
+
+    using SegmentMap = std::map<Timestamp, Segment>;  // 以区间起点为键
+
+    void erase_segment(const Key& key, SegmentMap& segments, SegmentMap::iterator it);
+    void evict_to_budget();
+
+    mutable std::mutex mutex_;
+    std::size_t budget_;
+    std::size_t memory_bytes_ = 0;
+    std::uint64_t hits_ = 0;
+    std::uint64_t misses_ = 0;
+    std::uint64_t evictions_ = 0;
+    std::unordered_map<Key, SegmentMap, KeyHash> entries_;
+    std::list<LruEntry> lru_;  // 头部为最近使用
+};
+
+} // namespace data
+} // namespace quant
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "data_types.hpp"
+#include "utils/span.hpp"
+#include <memory>
+#include <vector>
+
+namespace quant {
+namespace data {
+
+// 单品种K线的列式（SoA）非拥有视图
+// 时间戳与OHLCV各自连续存放，只读取close的指标不会把其他字段拉进缓存
+class BarSeriesView {
+public:
+    BarSeriesView() = default;
+    BarSeriesView(
+        SymbolId symbol,
+        const Timestamp* timestamp,
+        const double* open,
+        const double* high,
+        const double* low,
+        const double* close,
+        const double* volume,
+        std::size_t size)
+        : symbol_(symbol), timestamp_(timestamp), open_(open), high_(high),
+          low_(low), close_(close), volume_(volume), size_(size) {}
+
+    SymbolId symbol() const { return symbol_; }
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    utils::Span<const Timestamp> timestamps() const { return {timestamp_, size_}; }
+    utils::Span<const double> open() const { return {open_, size_}; }
+    utils::Span<const double> high() const { return {high_, size_}; }
+    utils::Span<const double> low() const { return {low_, size_}; }
+    utils::Span<const double> close() const { return {close_, size_}; }
+    utils::Span<const double> volume() const { return {volume_, size_}; }
+
+    Timestamp timestamp_at(std::size_t index) const { return timestamp_[index]; }
+    Timestamp first_timestamp() const { return timestamp_[0]; }
+    Timestamp last_timestamp() const { return timestamp_[size_ - 1]; }
+
+    // 按行取出一根K线（纯值拷贝，无内存分配）
+    BarData operator[](std::size_t index) const {
+        BarData bar;
+        bar.timestamp = timestamp_[index];
+        bar.symbol = symbol_;
+        bar.open = open_[index];
+        bar.high = high_[index];
+        bar.low = low_[index];
+        bar.close = close_[index];
+        bar.volume = volume_[index];
+        return bar;
+    }
+
+    // 下标区间[first, last)的子视图
+    BarSeriesView slice(std::size_t first, std::size_t last) const;
+
+    // 时间区间[start_time, end_time]的子视图（二分查找）
+    BarSeriesView range(Timestamp start_time, Timestamp end_time) const;
+
+    // 第一个时间戳不小于t的下标
+    std::size_t lower_bound(Timestamp t) const;
+
+    // 第一个时间戳大于t的下标
+    std::size_t upper_bound(Timestamp t) const;
+
+private:
+    SymbolId symbol_ = kInvalidSymbolId;
+    const Timestamp* timestamp_ = nullptr;
+    const double* open_ = nullptr;
+    const double* high_ = nullptr;
+    const double* low_ = nullptr;
+    const double* close_ = nullptr;
+    const double* volume_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+// 共享所有权的不可变K线序列
+// 底层存储可以是自有的列数组，也可以是内存映射文件等外部缓冲区；
+// 复制和切片只增加引用计数，不复制数据
+class BarSeries {
+public:
+    BarSeries() = default;
+
+    // 包装外部存储，owner负责保持view指向的内存有效
+    BarSeries(BarSeriesView view, std::shared_ptr<const void> owner)
+        : owner_(std::move(owner)), view_(view) {}
+
+    // 从行式K线构建（按时间排序）
+    static BarSeries from_bars(const std::vector<BarData>& bars, SymbolId symbol = kInvalidSymbolId);
+
+    const BarSeriesView& view() const { return view_; }
+    operator const BarSeriesView&() const { return view_; }
+
+    SymbolId symbol() const { return view_.symbol(); }
+    std::size_t size() const { return view_.size(); }
+    bool empty() const { return view_.empty(); }
+
+    utils::Span<const Timestamp> timestamps() const { return view_.timestamps(); }
+    utils::Span<const double> open() const { return view_.open(); }
+    utils::Span<const double> high() const { return view_.high(); }
+    utils::Span<const double> low() const { return view_.low(); }
+    utils::Span<const double> close() const { return view_.close(); }
+    utils::Span<const double> volume() const { return view_.volume(); }
+
+    BarData operator[](std::size_t index) const { return view_[index]; }
+
+    // 共享同一存储的子序列
+    BarSeries slice(std::size_t first, std::size_t last) const {
+        return BarSeries(view_.slice(first, last), owner_);
+    }
+
+    BarSeries range(Timestamp start_time, Timestamp end_time) const {
+        return BarSeries(view_.range(start_time, end_time), owner_);
+    }
+
+    // 转换为行式K线（用于兼容旧接口）
+    std::vector<BarData> to_bars() const;
+
+    // 底层存储占用的字节数估计
+    std::size_t memory_bytes() const {
+        return view_.size() * (sizeof(Timestamp) + 5 * sizeof(double));
+    }
+
+private:
+    std::shared_ptr<const void> owner_;
+    BarSeriesView view_;
+};
+
+// 逐根追加构建BarSeries
+class BarSeriesBuilder {
+public:
+    explicit BarSeriesBuilder(SymbolId symbol = kInvalidSymbolId) : symbol_(symbol) {}
+
+    void reserve(std::size_t capacity);
+    void push_back(const BarData& bar);
+    void append(const BarSeriesView& view);
+
+    std::size_t size() const { return timestamp_.size(); }
+    bool empty() const { return timestamp_.empty(); }
+
+    // 生成序列，若追加顺序不是按时间升序则先稳定排序；构建后builder被清空
+    BarSeries build();
+
+private:
+    SymbolId symbol_;
+    bool sorted_ = true;
+    std::vector<Timestamp> timestamp_;
+    std::vector<double> open_;
+    std::vector<double> high_;
+    std::vector<double> low_;
+    std::vector<double> close_;
+    std::vector<double> volume_;
+};
+
+} // namespace data
+} // namespace quant
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "data_feed.hpp"
+#include "utils/mapped_file.hpp"
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace quant {
+namespace data {
+
+// 列式K线存储文件格式
+//
+// [BarStoreHeader]
+// 每个品种: [timestamp列][open列][high列][low列][close列][volume列][稀疏时间索引]
+// [BarStoreSymbolEntry] * symbol_count   (目录位于文件末尾，由header指向)
+//
+// 同一品种的K线按时间升序连续存放，每列按64字节对齐，
+// 查询时直接在映射内存上二分定位，无需解析也无需逐条分配内存。
+namespace bar_store {
+
+constexpr char kMagic[8] = {'Q', 'F', 'B', 'A', 'R', 'S', '0', '1'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::size_t kColumnAlignment = 64;
+constexpr std::size_t kSymbolLength = 32;
+constexpr std::size_t kTimeframeLength = 8;
+// 稀疏索引步长：每隔kIndexStride根K线记录一个时间戳
+constexpr std::size_t kIndexStride = 1024;
+
+enum Column : std::size_t {
+    TIMESTAMP = 0,
+    OPEN,
+    HIGH,
+    LOW,
+    CLOSE,
+    VOLUME,
+    COLUMN_COUNT
+};
+
+struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t symbol_count;
+    std::uint64_t bar_count;
+    std::uint64_t directory_offset;
+    char timeframe[kTimeframeLength];
+    std::uint8_t reserved[24];
+};
+
+struct SymbolEntry {
+    char symbol[kSymbolLength];
+    std::uint64_t bar_count;
+    std::int64_t first_timestamp;
+    std::int64_t last_timestamp;
+    std::uint64_t column_offsets[COLUMN_COUNT];
+    std::uint64_t index_offset;
+    std::uint64_t index_count;
+};
+
+static_assert(sizeof(Header) == 64, "Unexpected bar store header layout");
+static_assert(sizeof(Timestamp) == sizeof(std::int64_t), "Bar store requires 64-bit timestamps");
+
+} // namespace bar_store
+
+// 列式K线存储写入器，按品种逐个追加，适合从CSV等格式一次性转换
+class BarStoreWriter {
+public:
+    BarStoreWriter(const std::string& path, const std::string& timeframe);
+    ~BarStoreWriter();
+
+    BarStoreWriter(const BarStoreWriter&) = delete;
+    BarStoreWriter& operator=(const BarStoreWriter&) = delete;
+
+    // 追加一个品种的全部K线，bars须按时间升序排列
+    void add_symbol(const std::string& symbol, const std::vector<BarData>& bars);
+
+    // 写入目录并回填文件头，析构时若未调用会自动执行
+    void finish();
+
+private:
+    void write_column(const void* data, std::size_t bytes, std::uint64_t& offset);
+    void pad_to_alignment();
+
+    std::ofstream out_;
+    std::string timeframe_;
+    std::vector<bar_store::SymbolEntry> entries_;
+    std::unordered_map<std::string, std::size_t> seen_symbols_;
+    std::uint64_t position_ = 0;
+    std::uint64_t bar_count_ = 0;
+    bool finished_ = false;
+};
+
+// 基于内存映射的列式K线数据源
+class MmapBarStore : public DataSource {
+public:
+    explicit MmapBarStore(const std::string& path);
+
+    // 零拷贝区间查询，返回[start_time, end_time]内指向映射内存的列视图，
+    // 视图在存储对象存活期间有效
+    BarSeriesView query(const std::string& symbol, Timestamp start_time, Timestamp end_time) const;
+
+    bool has_symbol(const std::string& symbol) const;
+    std::vector<std::string> symbols() const;
+    const std::string& timeframe() const { return timeframe_; }
+    std::uint64_t bar_count() const { return header_->bar_count; }
+
+    std::vector<BarData> get_historical_bars(
+        const std::string& symbol,
+        const Timestamp& start_time,
+        const Timestamp& end_time,
+        const std::string& timeframe) override;
+
+    // 返回与映射文件共享所有权的序列，即使存储对象销毁也保持有效
+    BarSeries get_bar_series(
+        const std::string& symbol,
+        const Timestamp& start_time,
+        const Timestamp& end_time,
+        const std::string& timeframe) override;
+
+    // 存储文件只提供历史数据
+    void subscribe_market_data(
+        const std::string& symbol,
+        std::function<void(const MarketData&)> callback) override;
+
+    void unsubscribe_market_data(const std::string& symbol) override;
+
+private:
+    const bar_store::SymbolEntry* find_entry(const std::string& symbol) const;
+    template <typename T>
+    const T* column_at(std::uint64_t offset) const {
+        return reinterpret_cast<const T*>(file_->data() + offset);
+    }
+
+    std::shared_ptr<const utils::MappedFile> file_;
+    const bar_store::Header* header_ = nullptr;
+    const bar_store::SymbolEntry* directory_ = nullptr;
+    std::string timeframe_;
+    std::unordered_map<std::string, std::size_t> symbol_index_;
+};
+
+} // namespace data
+} // namespace quant
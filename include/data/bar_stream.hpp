@@ -0,0 +1,99 @@
+#pragma once
+
+#include "bar_series.hpp"
+#include "data_feed.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace quant {
+namespace data {
+
+// 单品种K线的分块来源，按时间升序逐块提供数据
+class BarChunkSource {
+public:
+    virtual ~BarChunkSource() = default;
+
+    // 返回下一块数据，空序列表示已取完
+    virtual BarSeries next_chunk() = 0;
+};
+
+// 把已加载的序列切成固定大小的块（切片共享存储，不复制）
+class SeriesChunkSource : public BarChunkSource {
+public:
+    SeriesChunkSource(BarSeries series, std::size_t chunk_size);
+
+    BarSeries next_chunk() override;
+
+private:
+    BarSeries series_;
+    std::size_t chunk_size_;
+    std::size_t position_ = 0;
+};
+
+// 按时间窗口分段向DataFeed查询，内存占用与窗口大小而非历史长度成正比
+class DataFeedChunkSource : public BarChunkSource {
+public:
+    DataFeedChunkSource(
+        std::shared_ptr<DataFeed> data_feed,
+        std::string symbol,
+        Timestamp start_time,
+        Timestamp end_time,
+        std::string timeframe,
+        Timestamp window_seconds);
+
+    BarSeries next_chunk() override;
+
+private:
+    std::shared_ptr<DataFeed> data_feed_;
+    std::string symbol_;
+    Timestamp cursor_;
+    Timestamp end_time_;
+    std::string timeframe_;
+    Timestamp window_seconds_;
+    bool exhausted_ = false;
+};
+
+// 多品种按时间归并的流式迭代器
+//
+// 每个来源只缓存当前一块，以(时间戳, 来源序号)为键的二叉堆做k路归并，
+// 按全局时间顺序输出K线，无需加载全部历史，也无需全局排序。
+// 时间戳相同时按来源序号输出，结果是确定的。
+class MergedBarStream {
+public:
+    explicit MergedBarStream(std::vector<std::unique_ptr<BarChunkSource>> sources);
+
+    // 取出下一根K线，全部来源耗尽时返回false
+    bool next(BarData& bar);
+
+    // 下一根K线的时间戳，流已耗尽时无意义
+    Timestamp peek_timestamp() const;
+
+    bool empty() const { return heap_.empty(); }
+    std::size_t source_count() const { return sources_.size(); }
+    std::size_t active_sources() const { return heap_.size(); }
+
+private:
+    struct Cursor {
+        BarSeries chunk;
+        std::size_t position = 0;
+    };
+
+    // 当前块读完后拉取下一块，来源耗尽时返回false
+    bool advance(std::uint32_t index);
+    bool less(std::uint32_t a, std::uint32_t b) const;
+    void sift_down(std::size_t slot);
+    void sift_up(std::size_t slot);
+    Timestamp key(std::uint32_t index) const {
+        const auto& cursor = cursors_[index];
+        return cursor.chunk.view().timestamp_at(cursor.position);
+    }
+
+    std::vector<std::unique_ptr<BarChunkSource>> sources_;
+    std::vector<Cursor> cursors_;
+    std::vector<std::uint32_t> heap_;
+};
+
+} // namespace data
+} // namespace quant
@@ -0,0 +1,193 @@
+#pragma once
+
+#include "bar_series.hpp"
+#include "bar_stream.hpp"
+#include "data_feed.hpp"
+#include "utils/mapped_file.hpp"
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace quant {
+namespace data {
+
+// 压缩时间序列存储文件格式
+//
+// [Header]
+// 数据块 * N，每块: [BlockHeader][位流载荷][补齐到8字节 + 8字节零填充]
+// 每个序列: [块偏移表 uint64 * block_count]
+// [SymbolEntry] * entry_count   (目录位于文件末尾，由header指向)
+//
+// 每块最多block_size条记录，可以独立解码；块头记录时间范围，查询时跳过不相交的块。
+// 时间戳按二阶差分编码，规则周期的K线每根只占1位；价格和成交量每块每列自动选择编码：
+// 能以不超过9位小数精确表示的列转为定点整数，按64个一组差分后定宽位打包，
+// 否则使用Gorilla风格的XOR编码。两种编码都是无损的。
+namespace compressed_store {
+
+constexpr char kMagic[8] = {'Q', 'F', 'C', 'T', 'S', '0', '0', '1'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::size_t kSymbolLength = 32;
+constexpr std::size_t kTimeframeLength = 8;
+constexpr std::size_t kDefaultBlockSize = 4096;
+// 块载荷之后的零填充，保证位流读取器可以整字读取
+constexpr std::size_t kBlockPadding = 8;
+
+enum class SeriesKind : std::uint32_t {
+    BARS = 1,
+    TRADES = 2
+};
+
+struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t entry_count;
+    std::uint64_t record_count;
+    std::uint64_t directory_offset;
+    char timeframe[kTimeframeLength];
+    std::uint8_t reserved[24];
+};
+
+struct BlockHeader {
+    std::uint32_t record_count;
+    std::uint32_t payload_bytes;
+    std::int64_t min_timestamp;
+    std::int64_t max_timestamp;
+    SeriesKind kind;
+    std::uint32_t reserved;
+};
+
+struct SymbolEntry {
+    char symbol[kSymbolLength];
+    SeriesKind kind;
+    std::uint32_t block_count;
+    std::uint64_t record_count;
+    std::int64_t first_timestamp;
+    std::int64_t last_timestamp;
+    std::uint64_t block_table_offset;
+};
+
+static_assert(sizeof(Header) == 64, "Unexpected compressed store header layout");
+static_assert(sizeof(BlockHeader) == 32, "Unexpected compressed block header layout");
+static_assert(sizeof(Timestamp) == sizeof(std::int64_t), "Compressed store requires 64-bit timestamps");
+
+// 把一块K线编码为完整的数据块（含块头和填充）追加到out
+void encode_bar_block(const BarSeriesView& bars, std::vector<std::uint8_t>& out);
+
+// 把一块成交编码为完整的数据块追加到out
+void encode_trade_block(const Trade* trades, std::size_t count, std::vector<std::uint8_t>& out);
+
+// 解码K线块到各列的[0, record_count)，调用方保证各列容量足够
+void decode_bar_block(const BlockHeader& header, const std::uint8_t* payload,
+                      Timestamp* timestamp, double* open, double* high,
+                      double* low, double* close, double* volume);
+
+// 解码成交块，追加到out
+void decode_trade_block(const BlockHeader& header, const std::uint8_t* payload,
+                        SymbolId symbol, std::vector<Trade>& out);
+
+} // namespace compressed_store
+
+// 压缩存储写入器，按序列逐个追加
+class CompressedStoreWriter {
+public:
+    CompressedStoreWriter(const std::string& path, const std::string& timeframe,
+                          std::size_t block_size = compressed_store::kDefaultBlockSize);
+    ~CompressedStoreWriter();
+
+    CompressedStoreWriter(const CompressedStoreWriter&) = delete;
+    CompressedStoreWriter& operator=(const CompressedStoreWriter&) = delete;
+
+    // 追加一个品种的K线，须按时间升序排列
+    void add_bars(const std::string& symbol, const BarSeriesView& bars);
+    void add_bars(const std::string& symbol, const std::vector<BarData>& bars);
+
+    // 追加一个品种的成交，须按时间升序排列
+    void add_trades(const std::string& symbol, const std::vector<Trade>& trades);
+
+    // 写入目录并回填文件头，析构时若未调用会自动执行
+    void finish();
+
+    // 已写入的字节数
+    std::uint64_t bytes_written() const { return position_; }
+
+private:
+    compressed_store::SymbolEntry make_entry(const std::string& symbol, compressed_store::SeriesKind kind);
+    void write_block(const std::vector<std::uint8_t>& block, std::vector<std::uint64_t>& offsets);
+    void commit_entry(compressed_store::SymbolEntry entry, const std::vector<std::uint64_t>& offsets);
+
+    std::ofstream out_;
+    std::string timeframe_;
+    std::size_t block_size_;
+    std::vector<compressed_store::SymbolEntry> entries_;
+    std::map<std::pair<std::string, compressed_store::SeriesKind>, std::size_t> seen_;
+    std::uint64_t position_ = 0;
+    std::uint64_t record_count_ = 0;
+    bool finished_ = false;
+};
+
+// 基于内存映射的压缩存储数据源
+//
+// 区间查询只解码与区间相交的块；for_each_*和open_stream逐块解码，
+// 内存占用与块大小而非历史长度成正比。
+class CompressedStore : public DataSource {
+public:
+    explicit CompressedStore(const std::string& path);
+
+    bool has_bars(const std::string& symbol) const;
+    bool has_trades(const std::string& symbol) const;
+    std::vector<std::string> symbols() const;
+    const std::string& timeframe() const { return timeframe_; }
+    std::uint64_t record_count() const { return header_->record_count; }
+    std::uint64_t file_bytes() const { return file_->size(); }
+
+    // 逐块回调[start_time, end_time]内的K线
+    void for_each_bar_block(const std::string& symbol, Timestamp start_time, Timestamp end_time,
+                            const std::function<void(const BarSeriesView&)>& callback) const;
+
+    // 逐块回调[start_time, end_time]内的成交
+    void for_each_trade_block(const std::string& symbol, Timestamp start_time, Timestamp end_time,
+                              const std::function<void(const std::vector<Trade>&)>& callback) const;
+
+    std::vector<Trade> get_trades(const std::string& symbol, Timestamp start_time, Timestamp end_time) const;
+
+    // 逐块解码的流式来源，可直接交给MergedBarStream；来源持有映射文件的引用，不依赖存储对象存活
+    std::unique_ptr<BarChunkSource> open_stream(const std::string& symbol,
+                                                Timestamp start_time, Timestamp end_time) const;
+
+    std::vector<BarData> get_historical_bars(
+        const std::string& symbol,
+        const Timestamp& start_time,
+        const Timestamp& end_time,
+        const std::string& timeframe) override;
+
+    BarSeries get_bar_series(
+        const std::string& symbol,
+        const Timestamp& start_time,
+        const Timestamp& end_time,
+        const std::string& timeframe) override;
+
+    // 存储文件只提供历史数据
+    void subscribe_market_data(
+        const std::string& symbol,
+        std::function<void(const MarketData&)> callback) override;
+
+    void unsubscribe_market_data(const std::string& symbol) override;
+
+private:
+    const compressed_store::SymbolEntry* find_entry(const std::string& symbol,
+                                                    compressed_store::SeriesKind kind) const;
+
+    std::shared_ptr<const utils::MappedFile> file_;
+    const compressed_store::Header* header_ = nullptr;
+    const compressed_store::SymbolEntry* directory_ = nullptr;
+    std::string timeframe_;
+    std::map<std::pair<std::string, compressed_store::SeriesKind>, std::size_t> entry_index_;
+};
+
+} // namespace data
+} // namespace quant
@@ -1,11 +1,18 @@
 #pragma once
 
 #include "data_types.hpp"
+#include "bar_series.hpp"
+#include "bar_cache.hpp"
+#include "utils/thread_pool.hpp"
+#include <chrono>
 #include <memory>
 #include <functional>
 #include <string>
 #include <vector>
 #include <future>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
 
 namespace quant {
 namespace data {
@@ -21,6 +28,14 @@ public:
         const Timestamp& start_time,
         const Timestamp& end_time,
         const std::string& timeframe) = 0;
+    
+    // 获取列式历史数据，默认由get_historical_bars转换；
+    // 能直接提供列式存储的数据源应重写以避免拷贝
+    virtual BarSeries get_bar_series(
+        const std::string& symbol,
+        const Timestamp& start_time,
+        const Timestamp& end_time,
+        const std::string& timeframe);
         
     // 订阅实时数据
     virtual void subscribe_market_data(
@@ -31,9 +46,28 @@ public:
     virtual void unsubscribe_market_data(const std::string& symbol) = 0;
 };
 
+// 批量获取中的单个请求
+struct FetchRequest {
+    std::string symbol;
+    Timestamp start_time;
+    Timestamp end_time;
+    std::string timeframe;
+};
+
+// 异步获取选项
+struct FetchOptions {
+    // 对冲延迟：当前数据源超过该时间仍未返回时，并行向下一个数据源发起同样的请求，
+    // 先返回数据者胜出；0表示不对冲，仅在失败或无数据时依次回退。
+    // 对冲请求与普通请求共用线程池，线程数应大于可能同时阻塞的慢请求数
+    std::chrono::milliseconds hedge_delay{0};
+};
+
 // 数据馈送类，管理多个数据源
 class DataFeed {
 public:
+    DataFeed() = default;
+    virtual ~DataFeed();
+    
     // 添加数据源
     void add_data_source(std::shared_ptr<DataSource> source);
     
@@ -43,6 +77,13 @@ public:
         const Timestamp& start_time,
         const Timestamp& end_time,
         const std::string& timeframe);
+    
+    // 获取列式历史数据，自动选择合适的数据源
+    virtual BarSeries get_bar_series(
+        const std::string& symbol,
+        const Timestamp& start_time,
+        const Timestamp& end_time,
+        const std::string& timeframe);
         
     // 订阅实时数据
     virtual void subscribe_market_data(
@@ -52,9 +93,73 @@ public:
     // 取消订阅
     virtual void unsubscribe_market_data(const std::string& symbol);
     
+    // 启用历史数据缓存并设置内存预算（字节），0表示关闭缓存
+    void set_cache_budget(std::size_t bytes);
+    
+    // 清空缓存
+    void clear_cache();
+    
+    // 缓存统计，未启用缓存时返回空统计
+    BarCacheStats cache_stats() const;
+    
+    // 批量异步获取，请求在内部线程池上并行执行，按请求顺序返回future
+    // 未完成的请求引用本对象，DataFeed须在所有结果就绪前保持存活
+    std::vector<std::future<BarSeries>> fetch_bar_series_async(
+        const std::vector<FetchRequest>& requests,
+        const FetchOptions& options = FetchOptions());
+    
+    // 回调形式：每个请求完成时在工作线程上以请求下标调用on_complete，
+    // 返回的future在全部请求完成后就绪
+    std::future<void> fetch_bar_series_async(
+        const std::vector<FetchRequest>& requests,
+        std::function<void(std::size_t, BarSeries)> on_complete,
+        const FetchOptions& options = FetchOptions());
+    
+    // 设置异步获取的线程数，0表示硬件并发数；须在首次异步获取前调用
+    void set_fetch_threads(std::size_t threads);
+    
 private:
+    struct FetchState;
+    
+    // 为单个请求启动异步获取，完成时调用completion
+    void start_fetch(
+        const FetchRequest& request,
+        const FetchOptions& options,
+        std::function<void(BarSeries)> completion);
+    
+    // 向第attempt个候选数据源发起一次尝试；该候选已被发起（下一个待尝试的不是attempt）时什么也不做
+    void launch_attempt(const std::shared_ptr<FetchState>& state, std::size_t attempt);
+    
+    // 一次尝试结束后的处理
+    void finish_attempt(
+        const std::shared_ptr<FetchState>& state,
+        const std::shared_ptr<DataSource>& source,
+        BarSeries series);
+    
+    utils::ThreadPool& fetch_pool();
+    
+    // 返回已知拥有该品种的数据源
+    std::shared_ptr<DataSource> find_source(const std::string& symbol) const;
+    
+    // 记住拥有该品种的数据源
+    void remember_source(const std::string& symbol, const std::shared_ptr<DataSource>& source);
+    
+    // 从数据源加载（不经过缓存）。所有数据源都出错或都没有数据时返回std::nullopt，
+    // 该结果可能只是暂时的，调用方不应缓存
+    std::optional<BarSeries> load_bar_series(
+        const std::string& symbol,
+        const Timestamp& start_time,
+        const Timestamp& end_time,
+        const std::string& timeframe);
+    
     std::vector<std::shared_ptr<DataSource>> data_sources_;
     std::unordered_map<std::string, std::shared_ptr<DataSource>> symbol_to_source_;
+    mutable std::mutex source_mutex_;  // 保护symbol_to_source_
+    std::shared_ptr<BarCache> cache_;
+    
+    std::mutex pool_mutex_;
+    std::size_t fetch_threads_ = 0;
+    std::unique_ptr<utils::ThreadPool> fetch_pool_;  // 首次异步获取时创建，最先析构
 };
 
 } // namespace data
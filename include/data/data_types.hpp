@@ -1,5 +1,6 @@
 #pragma once
 
+#include "symbol_table.hpp"
 #include <string>
 #include <chrono>
 #include <vector>
@@ -15,7 +16,7 @@ using Timestamp = std::time_t;
 // 价格数据结构
 struct BarData {
     Timestamp timestamp;
-    std::string symbol;
+    SymbolId symbol;
     double open;
     double high;
     double low;
@@ -38,7 +39,7 @@ struct BarData {
     }
 };
 
-// 订单簿数据
+// 订单簿快照，需要增量维护时使用order_book.hpp中的L2OrderBook
 struct OrderBookLevel {
     double price;
     double volume;
@@ -46,7 +47,7 @@ struct OrderBookLevel {
 
 struct OrderBook {
     Timestamp timestamp;
-    std::string symbol;
+    SymbolId symbol;
     std::vector<OrderBookLevel> bids;
     std::vector<OrderBookLevel> asks;
 };
@@ -54,7 +55,7 @@ struct OrderBook {
 // 交易数据
 struct Trade {
     Timestamp timestamp;
-    std::string symbol;
+    SymbolId symbol;
     double price;
     double volume;
     bool is_buyer_maker;
@@ -0,0 +1,181 @@
+#pragma once
+
+#include "data_feed.hpp"
+#include "market_data_dispatcher.hpp"
+#include "order_book.hpp"
+#include "utils/latency_histogram.hpp"
+#include "utils/mapped_file.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace quant {
+namespace data {
+
+// 行情录制文件格式
+//
+// [Header][MarketEvent * event_count][品种名 char[32] * symbol_count]
+//
+// 事件按采集顺序存放，symbol字段为文件内的品种序号，publish_ns字段保存采集时刻
+// （单调时钟纳秒），回放时据此还原事件间隔。
+namespace feed_log {
+
+constexpr char kMagic[8] = {'Q', 'F', 'F', 'E', 'E', 'D', '0', '1'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::size_t kSymbolLength = 32;
+
+struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t symbol_count;
+    std::uint64_t event_count;
+    std::uint64_t symbol_table_offset;
+    std::uint8_t reserved[32];
+};
+
+static_assert(sizeof(Header) == sizeof(MarketEvent), "Feed log header must keep events cache-line aligned");
+
+} // namespace feed_log
+
+// 行情录制器
+class FeedRecorder {
+public:
+    explicit FeedRecorder(const std::string& path);
+    ~FeedRecorder();
+
+    FeedRecorder(const FeedRecorder&) = delete;
+    FeedRecorder& operator=(const FeedRecorder&) = delete;
+
+    // capture_ns为采集时刻（steady_clock_ns），0表示取当前时刻；采集时刻须单调不减
+    void record(const MarketEvent& event, std::uint64_t capture_ns = 0);
+    void record(const BarData& bar, std::uint64_t capture_ns = 0);
+    void record(const Trade& trade, std::uint64_t capture_ns = 0);
+    void record(SymbolId symbol, Timestamp timestamp, const BookDelta& delta, std::uint64_t capture_ns = 0);
+
+    // 作为ConsumerThread的handler录制分发器上的事件，采集时刻取事件的发布时刻
+    void operator()(const MarketEvent& event) { record(event, event.publish_ns); }
+
+    // 写入品种表并回填文件头，析构时若未调用会自动执行
+    void close();
+
+    std::uint64_t event_count() const { return event_count_; }
+
+private:
+    std::uint32_t local_symbol(SymbolId symbol);
+
+    std::ofstream out_;
+    std::vector<std::uint32_t> local_ids_;  // 按SymbolId索引的文件内序号
+    std::vector<std::string> names_;
+    std::uint64_t event_count_ = 0;
+    std::uint64_t last_capture_ns_ = 0;
+    bool closed_ = false;
+};
+
+struct ReplayOptions {
+    // 回放倍速：1为原速，N为N倍速，<=0为不等待、尽可能快
+    double speed = 1.0;
+    // 重复回放的轮数，后一轮的时间轴接在前一轮之后，用于长时间压测
+    std::size_t loops = 1;
+    // 距离计划时刻不足该值时忙等而不是休眠，换取更准确的发布时刻
+    std::chrono::microseconds spin_window{200};
+};
+
+struct ReplayStats {
+    std::uint64_t events_published = 0;
+    double elapsed_seconds = 0.0;
+    double events_per_second = 0.0;
+    utils::LatencyHistogram schedule_lag;      // 实际发布时刻落后于计划时刻的时间
+    // 回放线程上从取得发布时间戳到调用第k个订阅回调之前的延迟，包含dispatcher->publish
+    // 和排在前面的订阅回调的执行时间，不是端到端延迟（端到端延迟用LatencyProbe测量）
+    utils::LatencyHistogram dispatch_delay;
+};
+
+// 行情回放器
+//
+// 读取录制文件，按原始事件间隔（可加速）通过订阅接口发布，用来在没有行情商连接时
+// 测试实时路径。K线通过subscribe_market_data送达；subscribe_events可以收到包括成交和
+// 订单簿增量在内的全部事件；设置分发器后所有事件同时发布到分发器。
+// 订阅关系在每次回放开始时生效。
+class FeedReplayer : public DataSource {
+public:
+    explicit FeedReplayer(const std::string& path);
+    ~FeedReplayer() override;
+
+    std::size_t event_count() const { return event_count_; }
+    std::vector<std::string> symbols() const;
+
+    // 录制时长（纳秒）
+    std::uint64_t duration_ns() const;
+
+    void set_dispatcher(MarketDataDispatcher* dispatcher);
+
+    // 订阅品种的全部事件类型
+    void subscribe_events(const std::string& symbol, std::function<void(const MarketEvent&)> callback);
+
+    // 在调用线程上回放，返回统计
+    ReplayStats replay(const ReplayOptions& options = {});
+
+    // 在后台线程上回放，wait()等待结束并取回统计，stop()提前结束
+    void start(const ReplayOptions& options = {});
+    ReplayStats wait();
+    void stop();
+    bool running() const { return running_.load(std::memory_order_acquire); }
+
+    // 录制文件中[start_time, end_time]内的K线，timeframe不做检查
+    std::vector<BarData> get_historical_bars(
+        const std::string& symbol,
+        const Timestamp& start_time,
+        const Timestamp& end_time,
+        const std::string& timeframe) override;
+
+    void subscribe_market_data(
+        const std::string& symbol,
+        std::function<void(const MarketData&)> callback) override;
+
+    // 取消该品种的全部订阅（包括subscribe_events）
+    void unsubscribe_market_data(const std::string& symbol) override;
+
+private:
+    struct Subscriber {
+        std::function<void(const MarketData&)> on_bar;
+        std::function<void(const MarketEvent&)> on_event;
+    };
+
+    void add_subscriber(const std::string& symbol, Subscriber subscriber);
+
+    std::shared_ptr<const utils::MappedFile> file_;
+    const MarketEvent* events_ = nullptr;
+    std::size_t event_count_ = 0;
+    std::vector<SymbolId> symbol_map_;  // 文件内序号 -> 全局SymbolId
+
+    std::mutex mutex_;
+    std::vector<std::vector<Subscriber>> subscribers_;  // 按SymbolId索引
+    MarketDataDispatcher* dispatcher_ = nullptr;
+
+    std::atomic<bool> running_{false};
+    std::atomic<bool> stop_requested_{false};
+    std::thread thread_;
+    ReplayStats background_stats_;
+};
+
+// 包装消费者handler，记录每个事件从分发器发布到被处理的延迟
+template <typename Handler>
+struct LatencyProbe {
+    Handler handler;
+    utils::LatencyHistogram latency;
+
+    void operator()(const MarketEvent& event) {
+        latency.record(steady_clock_ns() - event.publish_ns);
+        handler(event);
+    }
+};
+
+} // namespace data
+} // namespace quant
@@ -0,0 +1,301 @@
+#pragma once
+
+#include "data_feed.hpp"
+#include "data_types.hpp"
+#include "order_book.hpp"
+#include "../utils/cpu_affinity.hpp"
+#include "../utils/lockfree_queue.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace quant {
+namespace data {
+
+// 单调时钟纳秒数，用于测量行情从发布到回调的延迟
+inline std::uint64_t steady_clock_ns() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+enum class MarketEventType : std::uint8_t {
+    BAR = 0,
+    TRADE = 1,
+    BOOK_DELTA = 2
+};
+
+// 定长POD行情事件，恰好占一个缓存行，可以直接按值在环形队列中传递
+struct alignas(64) MarketEvent {
+    MarketEventType type;
+    std::uint8_t flags;        // TRADE: kBuyerMaker表示买方为挂单方；BOOK_DELTA: 买卖方向和增量类型
+    std::uint16_t reserved;
+    SymbolId symbol;
+    Timestamp timestamp;
+    std::uint64_t publish_ns;  // 进入分发器的时刻（steady_clock_ns）
+    double open;
+    double high;
+    double low;
+    double close;              // TRADE: 成交价；BOOK_DELTA: 价位
+    double volume;             // BOOK_DELTA: 该价位的挂单量
+
+    static constexpr std::uint8_t kBuyerMaker = 1;
+
+    static MarketEvent from_bar(const BarData& bar);
+    static MarketEvent from_trade(const Trade& trade);
+    static MarketEvent from_book_delta(SymbolId symbol, Timestamp timestamp, const BookDelta& delta);
+
+    BarData to_bar() const;
+    Trade to_trade() const;
+    BookDelta to_book_delta() const;
+};
+
+static_assert(std::is_trivially_copyable<MarketEvent>::value, "MarketEvent must stay POD");
+static_assert(sizeof(MarketEvent) == 64, "MarketEvent must fit in one cache line");
+
+enum class ChannelMode {
+    SPSC,       // 只有一个发布线程
+    MPSC,       // 多个发布线程
+    CONFLATING  // 每个品种只保留最新一条，慢消费者不会积压
+};
+
+struct ChannelOptions {
+    ChannelMode mode = ChannelMode::MPSC;
+    // 队列模式下为队列容量；合并模式下为可容纳的品种ID上限
+    std::size_t capacity = 1 << 14;
+};
+
+// 行情分发器到单个消费线程的通道
+//
+// 队列模式下事件按发布顺序逐条送达，队列满时新事件被丢弃并计数；
+// 合并模式下每个品种占一个槽位，消费者来不及处理的旧事件被新事件覆盖，
+// 同一品种在待处理列表中最多出现一次。
+class EventChannel {
+public:
+    explicit EventChannel(ChannelOptions options = {});
+
+    EventChannel(const EventChannel&) = delete;
+    EventChannel& operator=(const EventChannel&) = delete;
+
+    // 由发布线程调用，事件被丢弃时返回false
+    bool push(const MarketEvent& event);
+
+    // 由消费线程调用，对最多max_events条事件调用handler，返回处理的条数
+    template <typename Handler>
+    std::size_t poll(Handler&& handler,
+                     std::size_t max_events = std::numeric_limits<std::size_t>::max());
+
+    ChannelMode mode() const { return mode_; }
+    std::uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+    std::uint64_t conflated() const { return conflated_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr std::size_t kEventWords = sizeof(MarketEvent) / sizeof(std::uint64_t);
+
+    // 合并模式下的品种槽位，用序号锁（seqlock）保证读到完整的事件
+    struct alignas(utils::kCacheLineSize) Slot {
+        std::atomic<std::uint32_t> sequence{0};
+        std::atomic<std::uint8_t> pending{0};
+        std::uint32_t delivered = 0;  // 消费者最后送达的版本，仅消费线程访问
+        std::atomic<std::uint64_t> words[kEventWords];
+    };
+
+    bool store_latest(const MarketEvent& event);
+    bool load_latest(Slot& slot, MarketEvent& event);
+
+    ChannelMode mode_;
+    std::unique_ptr<utils::SpscQueue<MarketEvent>> spsc_;
+    std::unique_ptr<utils::MpscQueue<MarketEvent>> mpsc_;
+    std::unique_ptr<utils::MpscQueue<SymbolId>> pending_symbols_;
+    std::unique_ptr<Slot[]> slots_;
+    std::size_t slot_count_ = 0;
+
+    std::atomic<std::uint64_t> dropped_{0};
+    std::atomic<std::uint64_t> conflated_{0};
+};
+
+// 实时行情分发器
+//
+// 行情线程通过publish把事件写入订阅了该品种的各个通道，策略线程各自轮询自己的通道。
+// 发布路径不加锁、不分配内存、不经过std::function；订阅关系以不可变路由表的形式
+// 原子替换，旧表保留到分发器析构，因此订阅可以在发布进行中修改。
+class MarketDataDispatcher {
+public:
+    MarketDataDispatcher() = default;
+    ~MarketDataDispatcher();
+
+    MarketDataDispatcher(const MarketDataDispatcher&) = delete;
+    MarketDataDispatcher& operator=(const MarketDataDispatcher&) = delete;
+
+    // 创建一个通道，其生命周期由分发器管理
+    EventChannel& create_channel(ChannelOptions options = {});
+
+    // 通道订阅单个品种，或订阅全部品种
+    void subscribe(EventChannel& channel, SymbolId symbol);
+    void subscribe(EventChannel& channel, const std::string& symbol);
+    void subscribe_all(EventChannel& channel);
+    void unsubscribe(EventChannel& channel, SymbolId symbol);
+
+    // 发布事件，返回成功写入的通道数
+    std::size_t publish(const MarketEvent& event);
+    std::size_t publish(const BarData& bar) { return publish(MarketEvent::from_bar(bar)); }
+    std::size_t publish(const Trade& trade) { return publish(MarketEvent::from_trade(trade)); }
+
+    // 把数据源的回调式订阅接入分发器：数据源线程上的回调只负责发布，策略在各自的通道上消费
+    void attach(DataSource& source, const std::string& symbol);
+    void detach(DataSource& source, const std::string& symbol);
+
+private:
+    struct Routes {
+        std::vector<std::vector<EventChannel*>> by_symbol;
+        std::vector<EventChannel*> wildcard;
+    };
+
+    // 在锁内基于当前路由表生成新表并发布
+    template <typename Mutator>
+    void update_routes(Mutator&& mutate);
+
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<EventChannel>> channels_;
+    std::vector<std::unique_ptr<const Routes>> route_versions_;
+    std::atomic<const Routes*> routes_{nullptr};
+};
+
+// 消费者等待策略
+enum class WaitStrategy {
+    BUSY_SPIN,  // 一直自旋，延迟最低，独占一个核心
+    YIELD,      // 空闲时让出时间片
+    BACKOFF     // 先自旋，再让出，长时间空闲后短暂休眠
+};
+
+struct ConsumerOptions {
+    int cpu = -1;  // 绑定的CPU核心，-1表示不绑定
+    WaitStrategy wait = WaitStrategy::BUSY_SPIN;
+    std::size_t batch_size = 256;
+};
+
+// 在独立线程上轮询通道并调用handler的消费者
+//
+// Handler以模板参数给出，签名为void(const MarketEvent&)，调用可被内联。
+// stop()会先排空通道中剩余的事件再返回。
+template <typename Handler>
+class ConsumerThread {
+public:
+    ConsumerThread(EventChannel& channel, Handler handler, ConsumerOptions options = {})
+        : channel_(channel), handler_(std::move(handler)), options_(options) {}
+
+    ~ConsumerThread() { stop(); }
+
+    ConsumerThread(const ConsumerThread&) = delete;
+    ConsumerThread& operator=(const ConsumerThread&) = delete;
+
+    void start() {
+        if (thread_.joinable()) {
+            return;
+        }
+        running_.store(true, std::memory_order_relaxed);
+        thread_ = std::thread([this] { run(); });
+    }
+
+    void stop() {
+        if (!thread_.joinable()) {
+            return;
+        }
+        running_.store(false, std::memory_order_relaxed);
+        thread_.join();
+    }
+
+    bool running() const { return thread_.joinable(); }
+
+    // 是否成功绑定到指定核心（线程启动后有效）
+    bool pinned() const { return pinned_.load(std::memory_order_acquire); }
+
+    // 消费线程停止后访问handler的状态
+    Handler& handler() { return handler_; }
+
+private:
+    void run() {
+        if (options_.cpu >= 0) {
+            pinned_.store(utils::pin_current_thread(options_.cpu), std::memory_order_release);
+        }
+
+        std::size_t idle = 0;
+        while (running_.load(std::memory_order_relaxed)) {
+            if (channel_.poll(handler_, options_.batch_size) > 0) {
+                idle = 0;
+                continue;
+            }
+            wait(++idle);
+        }
+        while (channel_.poll(handler_, options_.batch_size) > 0) {
+        }
+    }
+
+    void wait(std::size_t idle) const {
+        switch (options_.wait) {
+            case WaitStrategy::BUSY_SPIN:
+                utils::cpu_relax();
+                break;
+            case WaitStrategy::YIELD:
+                std::this_thread::yield();
+                break;
+            case WaitStrategy::BACKOFF:
+                if (idle < 64) {
+                    utils::cpu_relax();
+                } else if (idle < 256) {
+                    std::this_thread::yield();
+                } else {
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+                }
+                break;
+        }
+    }
+
+    EventChannel& channel_;
+    Handler handler_;
+    ConsumerOptions options_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> pinned_{false};
+    std::thread thread_;
+};
+
+template <typename Handler>
+std::size_t EventChannel::poll(Handler&& handler, std::size_t max_events) {
+    std::size_t count = 0;
+    MarketEvent event;
+    switch (mode_) {
+        case ChannelMode::SPSC:
+            while (count < max_events && spsc_->try_pop(event)) {
+                handler(static_cast<const MarketEvent&>(event));
+                ++count;
+            }
+            break;
+        case ChannelMode::MPSC:
+            while (count < max_events && mpsc_->try_pop(event)) {
+                handler(static_cast<const MarketEvent&>(event));
+                ++count;
+            }
+            break;
+        case ChannelMode::CONFLATING: {
+            SymbolId symbol;
+            while (count < max_events && pending_symbols_->try_pop(symbol)) {
+                if (load_latest(slots_[symbol], event)) {
+                    handler(static_cast<const MarketEvent&>(event));
+                    ++count;
+                }
+            }
+            break;
+        }
+    }
+    return count;
+}
+
+} // namespace data
+} // namespace quant
@@ -0,0 +1,294 @@
+#pragma once
+
+#include "data_types.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+namespace quant {
+namespace data {
+
+enum class BookSide : std::uint8_t {
+    BID,
+    ASK
+};
+
+enum class DeltaAction : std::uint8_t {
+    ADD,
+    MODIFY,
+    REMOVE  // 不用DELETE，避免与Windows头文件中的宏冲突
+};
+
+// L2增量：新增和修改都把该价位的挂单量设为volume，删除忽略volume
+struct BookDelta {
+    BookSide side;
+    DeltaAction action;
+    double price;
+    double volume;
+};
+
+// 单边价位阶梯
+//
+// 价格和挂单量分两个定长数组存放，按优劣升序排列，最优价位在末尾：
+// 行情变动集中在盘口附近，这样插入和删除只需移动盘口之上的少量元素。
+// 超出Depth档的价位不保留。
+template <std::size_t Depth, bool IsBid>
+class BookLadder {
+public:
+    std::size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    bool full() const { return count_ == Depth; }
+
+    // 第i档（0为最优）
+    double price(std::size_t level) const { return prices_[count_ - 1 - level]; }
+    double volume(std::size_t level) const { return volumes_[count_ - 1 - level]; }
+
+    double best_price() const {
+        return count_ ? prices_[count_ - 1] : std::numeric_limits<double>::quiet_NaN();
+    }
+    double best_volume() const { return count_ ? volumes_[count_ - 1] : 0.0; }
+
+    // 全部已跟踪档位的挂单量之和
+    double total_volume() const { return total_volume_; }
+
+    // 前levels档的挂单量之和
+    double volume_within(std::size_t levels) const {
+        if (levels >= count_) {
+            return total_volume_;
+        }
+        double sum = 0.0;
+        for (std::size_t i = count_ - levels; i < count_; ++i) {
+            sum += volumes_[i];
+        }
+        return sum;
+    }
+
+    // 设置价位的挂单量，volume<=0等同删除；返回盘口是否改变
+    bool set(double price, double volume) {
+        if (!(volume > 0.0)) {
+            return remove(price);
+        }
+
+        std::ptrdiff_t i = static_cast<std::ptrdiff_t>(count_) - 1;
+        while (i >= 0 && better(prices_[i], price)) {
+            --i;
+        }
+        const bool top = i == static_cast<std::ptrdiff_t>(count_) - 1;
+
+        if (i >= 0 && prices_[i] == price) {
+            total_volume_ += volume - volumes_[i];
+            volumes_[i] = volume;
+            return top;
+        }
+
+        if (count_ == Depth) {
+            // 比已跟踪的最差价位还差，超出深度
+            if (i < 0) {
+                return false;
+            }
+            // 挤掉最差一档，[1, i]整体下移
+            total_volume_ -= volumes_[0];
+            for (std::ptrdiff_t j = 0; j < i; ++j) {
+                prices_[j] = prices_[j + 1];
+                volumes_[j] = volumes_[j + 1];
+            }
+            prices_[i] = price;
+            volumes_[i] = volume;
+        } else {
+            // [i+1, count)整体上移
+            for (std::ptrdiff_t j = static_cast<std::ptrdiff_t>(count_); j > i + 1; --j) {
+                prices_[j] = prices_[j - 1];
+                volumes_[j] = volumes_[j - 1];
+            }
+            prices_[i + 1] = price;
+            volumes_[i + 1] = volume;
+            ++count_;
+        }
+        total_volume_ += volume;
+        return top;
+    }
+
+    // 删除价位，价位不存在时忽略；返回盘口是否改变
+    bool remove(double price) {
+        std::ptrdiff_t i = static_cast<std::ptrdiff_t>(count_) - 1;
+        while (i >= 0 && better(prices_[i], price)) {
+            --i;
+        }
+        if (i < 0 || prices_[i] != price) {
+            return false;
+        }
+
+        const bool top = i == static_cast<std::ptrdiff_t>(count_) - 1;
+        total_volume_ -= volumes_[i];
+        for (std::size_t j = static_cast<std::size_t>(i); j + 1 < count_; ++j) {
+            prices_[j] = prices_[j + 1];
+            volumes_[j] = volumes_[j + 1];
+        }
+        --count_;
+        if (count_ == 0) {
+            total_volume_ = 0.0;  // 清掉增量累加的舍入误差
+        }
+        return top;
+    }
+
+    void clear() {
+        count_ = 0;
+        total_volume_ = 0.0;
+    }
+
+private:
+    static bool better(double a, double b) { return IsBid ? a > b : a < b; }
+
+    std::array<double, Depth> prices_{};
+    std::array<double, Depth> volumes_{};
+    std::size_t count_ = 0;
+    double total_volume_ = 0.0;
+};
+
+// 增量维护的定深L2订单簿
+//
+// 每边最多保留Depth档，内存固定、无堆分配，适合同时维护大量品种。
+// 盘口价格、价差、中间价、总挂单量和不平衡度均为O(1)；前N档的统计为O(N)。
+// 价格按double精确比较，增量中的价格应与快照使用相同的解析方式。
+template <std::size_t Depth = 32>
+class L2OrderBook {
+    static_assert(Depth > 0, "L2OrderBook depth must be positive");
+
+public:
+    using BidLadder = BookLadder<Depth, true>;
+    using AskLadder = BookLadder<Depth, false>;
+
+    static constexpr std::size_t max_depth() { return Depth; }
+
+    explicit L2OrderBook(SymbolId symbol = kInvalidSymbolId) : symbol_(symbol) {}
+
+    SymbolId symbol() const { return symbol_; }
+    Timestamp timestamp() const { return timestamp_; }
+    std::uint64_t update_count() const { return update_count_; }
+
+    // 应用一条增量，返回盘口（任一边最优价位）是否改变
+    bool apply(const BookDelta& delta) {
+        ++update_count_;
+        if (delta.side == BookSide::BID) {
+            return delta.action == DeltaAction::REMOVE ? bids_.remove(delta.price)
+                                                       : bids_.set(delta.price, delta.volume);
+        }
+        return delta.action == DeltaAction::REMOVE ? asks_.remove(delta.price)
+                                                   : asks_.set(delta.price, delta.volume);
+    }
+
+    bool apply(const BookDelta& delta, Timestamp timestamp) {
+        timestamp_ = timestamp;
+        return apply(delta);
+    }
+
+    // 用快照重建订单簿，快照各边须按从优到劣排列
+    void apply_snapshot(const OrderBook& snapshot) {
+        clear();
+        symbol_ = snapshot.symbol;
+        timestamp_ = snapshot.timestamp;
+        for (const auto& level : snapshot.bids) {
+            bids_.set(level.price, level.volume);
+        }
+        for (const auto& level : snapshot.asks) {
+            asks_.set(level.price, level.volume);
+        }
+        ++update_count_;
+    }
+
+    // 导出前levels档的快照
+    OrderBook to_snapshot(std::size_t levels = Depth) const {
+        OrderBook snapshot;
+        snapshot.timestamp = timestamp_;
+        snapshot.symbol = symbol_;
+        std::size_t bid_levels = levels < bids_.size() ? levels : bids_.size();
+        std::size_t ask_levels = levels < asks_.size() ? levels : asks_.size();
+        snapshot.bids.reserve(bid_levels);
+        snapshot.asks.reserve(ask_levels);
+        for (std::size_t i = 0; i < bid_levels; ++i) {
+            snapshot.bids.push_back({bids_.price(i), bids_.volume(i)});
+        }
+        for (std::size_t i = 0; i < ask_levels; ++i) {
+            snapshot.asks.push_back({asks_.price(i), asks_.volume(i)});
+        }
+        return snapshot;
+    }
+
+    void clear() {
+        bids_.clear();
+        asks_.clear();
+    }
+
+    const BidLadder& bids() const { return bids_; }
+    const AskLadder& asks() const { return asks_; }
+
+    // 第level档（0为最优），越界抛出std::out_of_range
+    OrderBookLevel bid_level(std::size_t level) const {
+        if (level >= bids_.size()) {
+            throw std::out_of_range("Bid level out of range");
+        }
+        return {bids_.price(level), bids_.volume(level)};
+    }
+
+    OrderBookLevel ask_level(std::size_t level) const {
+        if (level >= asks_.size()) {
+            throw std::out_of_range("Ask level out of range");
+        }
+        return {asks_.price(level), asks_.volume(level)};
+    }
+
+    // 盘口；对应一边为空时价格为NaN
+    double best_bid() const { return bids_.best_price(); }
+    double best_ask() const { return asks_.best_price(); }
+    double best_bid_volume() const { return bids_.best_volume(); }
+    double best_ask_volume() const { return asks_.best_volume(); }
+
+    bool has_two_sides() const { return !bids_.empty() && !asks_.empty(); }
+    bool crossed() const { return has_two_sides() && best_bid() >= best_ask(); }
+
+    double spread() const { return best_ask() - best_bid(); }
+    double mid_price() const { return (best_bid() + best_ask()) * 0.5; }
+
+    // 按盘口挂单量加权的中间价
+    double micro_price() const {
+        double bid_volume = best_bid_volume();
+        double ask_volume = best_ask_volume();
+        double total = bid_volume + ask_volume;
+        if (total <= 0.0) {
+            return mid_price();
+        }
+        return (best_bid() * ask_volume + best_ask() * bid_volume) / total;
+    }
+
+    // 盘口不平衡度 (买量-卖量)/(买量+卖量)，取值[-1, 1]
+    double top_imbalance() const {
+        return imbalance(best_bid_volume(), best_ask_volume());
+    }
+
+    // 全部已跟踪档位的不平衡度
+    double depth_imbalance() const {
+        return imbalance(bids_.total_volume(), asks_.total_volume());
+    }
+
+    // 前levels档的不平衡度
+    double depth_imbalance(std::size_t levels) const {
+        return imbalance(bids_.volume_within(levels), asks_.volume_within(levels));
+    }
+
+private:
+    static double imbalance(double bid_volume, double ask_volume) {
+        double total = bid_volume + ask_volume;
+        return total > 0.0 ? (bid_volume - ask_volume) / total : 0.0;
+    }
+
+    BidLadder bids_;
+    AskLadder asks_;
+    SymbolId symbol_;
+    Timestamp timestamp_ = 0;
+    std::uint64_t update_count_ = 0;
+};
+
+} // namespace data
+} // namespace quant
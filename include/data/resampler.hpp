@@ -0,0 +1,96 @@
+#pragma once
+
+#include "bar_series.hpp"
+#include "data_feed.hpp"
+#include <memory>
+#include <string>
+
+namespace quant {
+namespace data {
+
+// K线周期
+struct Timeframe {
+    Timestamp seconds = 0;  // 周期长度（秒）
+    Timestamp origin = 0;   // 周期对齐的起点（Unix秒），周线默认对齐到周一00:00 UTC
+
+    // 解析"30s"、"1m"/"5min"、"1h"、"4h"、"1d"、"1w"等格式的周期字符串
+    // 按自然月等非固定长度的周期不受支持
+    static Timeframe parse(const std::string& text);
+};
+
+// 增量K线重采样器
+//
+// 把成交或细粒度K线单遍聚合为粗粒度OHLCV K线。K线以所在周期的起点作为时间戳，
+// session_offset把周期边界整体平移（例如按交易所时区或开盘时间对齐日线）。
+// 每个实例只处理一个品种，输入须按时间升序。
+class BarResampler {
+public:
+    explicit BarResampler(Timeframe timeframe, Timestamp session_offset = 0);
+
+    // 输入一根细粒度K线；若其开启了新周期，上一根已完成的K线写入completed并返回true
+    bool update(const BarData& bar, BarData& completed);
+
+    // 输入一笔成交
+    bool update(const Trade& trade, BarData& completed);
+
+    // 输出当前未完成的K线（数据结束时调用）
+    bool flush(BarData& completed);
+
+    // 时间t所在周期的起点
+    Timestamp bucket_start(Timestamp t) const;
+
+    bool has_partial() const { return has_partial_; }
+    const BarData& partial() const { return current_; }
+    const Timeframe& timeframe() const { return timeframe_; }
+
+    void reset() { has_partial_ = false; }
+
+private:
+    // 切换到新周期时返回true并输出已完成的K线
+    bool roll(Timestamp bucket, SymbolId symbol, BarData& completed);
+
+    Timeframe timeframe_;
+    Timestamp anchor_;
+    BarData current_{};
+    bool has_partial_ = false;
+};
+
+// 把细粒度序列一次性重采样为粗粒度序列
+BarSeries resample(const BarSeriesView& bars, const Timeframe& timeframe, Timestamp session_offset = 0);
+
+// 重采样数据源：底层只存储最细粒度（base_timeframe）的数据，
+// 其他周期在读取时由细粒度数据即时聚合
+class ResamplingDataSource : public DataSource {
+public:
+    ResamplingDataSource(
+        std::shared_ptr<DataSource> source,
+        std::string base_timeframe,
+        Timestamp session_offset = 0);
+
+    std::vector<BarData> get_historical_bars(
+        const std::string& symbol,
+        const Timestamp& start_time,
+        const Timestamp& end_time,
+        const std::string& timeframe) override;
+
+    BarSeries get_bar_series(
+        const std::string& symbol,
+        const Timestamp& start_time,
+        const Timestamp& end_time,
+        const std::string& timeframe) override;
+
+    void subscribe_market_data(
+        const std::string& symbol,
+        std::function<void(const MarketData&)> callback) override;
+
+    void unsubscribe_market_data(const std::string& symbol) override;
+
+private:
+    std::shared_ptr<DataSource> source_;
+    std::string base_timeframe_;
+    Timeframe base_;
+    Timestamp session_offset_;
+};
+
+} // namespace data
+} // namespace quant
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "data_feed.hpp"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace quant {
+namespace data {
+
+// 预先加载到内存的只读数据馈送
+//
+// 每个品种保存一段完整的列式序列，区间查询返回共享存储的切片，不复制数据。
+// 构造后内容不再改变，可以被多个线程上的回测引擎同时读取；参数扫描等需要在同一段
+// 行情上运行大量回测的场景，数据只需从原始数据源加载一次。
+// 只保存加载时的K线周期，查询时忽略timeframe参数。
+class SeriesDataFeed : public DataFeed {
+public:
+    SeriesDataFeed() = default;
+
+    // 从data_feed加载各品种[start_time, end_time]内的数据
+    static std::shared_ptr<SeriesDataFeed> load(
+        DataFeed& data_feed,
+        const std::vector<std::string>& symbols,
+        const Timestamp& start_time,
+        const Timestamp& end_time,
+        const std::string& timeframe);
+
+    // 设置品种的序列，只能在开始读取之前调用
+    void set_series(const std::string& symbol, BarSeries series);
+
+    // 品种的完整序列，未加载的品种返回空序列
+    BarSeries series(const std::string& symbol) const;
+
+    std::vector<BarData> get_historical_bars(
+        const std::string& symbol,
+        const Timestamp& start_time,
+        const Timestamp& end_time,
+        const std::string& timeframe) override;
+
+    BarSeries get_bar_series(
+        const std::string& symbol,
+        const Timestamp& start_time,
+        const Timestamp& end_time,
+        const std::string& timeframe) override;
+
+    // 数据固定不变，不支持实时订阅
+    void subscribe_market_data(
+        const std::string& symbol,
+        std::function<void(const MarketData&)> callback) override;
+    void unsubscribe_market_data(const std::string& symbol) override;
+
+    std::size_t memory_bytes() const;
+
+private:
+    std::unordered_map<std::string, BarSeries> series_;
+};
+
+} // namespace data
+} // namespace quant
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace quant {
+namespace data {
+
+// 交易品种的整数编号，从0开始连续分配，可直接用作数组下标
+using SymbolId = std::uint32_t;
+
+constexpr SymbolId kInvalidSymbolId = std::numeric_limits<SymbolId>::max();
+
+// 全局品种表：把品种字符串驻留为稠密的32位编号
+// 字符串只在数据输入/输出边界出现，行情、信号、订单和持仓内部一律使用编号
+class SymbolTable {
+public:
+    static SymbolTable& instance();
+
+    // 返回品种编号，首次出现时分配新编号（线程安全）
+    SymbolId intern(std::string_view symbol);
+
+    // 查找已存在的品种，不存在时返回kInvalidSymbolId
+    SymbolId find(std::string_view symbol) const;
+
+    // 编号对应的品种名称，返回的引用在进程生命周期内有效
+    const std::string& name(SymbolId id) const;
+
+    std::size_t size() const;
+
+private:
+    SymbolTable() = default;
+
+    mutable std::shared_mutex mutex_;
+    std::deque<std::string> names_;  // deque保证元素地址稳定
+    std::unordered_map<std::string_view, SymbolId> ids_;
+};
+
+inline SymbolId intern_symbol(std::string_view symbol) {
+    return SymbolTable::instance().intern(symbol);
+}
+
+inline const std::string& symbol_name(SymbolId id) {
+    return SymbolTable::instance().name(id);
+}
+
+} // namespace data
+} // namespace quant
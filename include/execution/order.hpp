@@ -35,7 +35,7 @@ enum class OrderStatus {
 // 订单结构
 struct Order {
     std::string id;                  // 订单ID
-    std::string symbol;              // 交易品种
+    data::SymbolId symbol;           // 交易品种
     data::Timestamp timestamp;       // 订单时间
     OrderType type;                  // 订单类型
     OrderSide side;                  // 买卖方向
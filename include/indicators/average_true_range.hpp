@@ -0,0 +1,94 @@
+#pragma once
+
+#include "data/data_types.hpp"
+#include "utils/binary_stream.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+
+namespace quant {
+namespace indicators {
+
+// 平均真实波幅 (ATR)
+//
+// 真实波幅取 high - low、|high - 前收盘|、|low - 前收盘| 中的最大值（第一根K线为high - low）。
+// 前period根K线的真实波幅取均值作为初始ATR，之后按Wilder平滑递推，不需要保存窗口。
+class AverageTrueRange {
+public:
+    explicit AverageTrueRange(size_t period) : period_(period) {
+        if (period == 0) {
+            throw std::invalid_argument("Period must be greater than 0");
+        }
+    }
+
+    void update(double high, double low, double close) {
+        double true_range = high - low;
+        if (count_ > 0) {
+            true_range = std::max({true_range, std::fabs(high - prev_close_), std::fabs(low - prev_close_)});
+        }
+        prev_close_ = close;
+
+        if (count_ < period_) {
+            // 预热期：累计真实波幅
+            atr_ += true_range;
+            if (++count_ == period_) {
+                atr_ /= static_cast<double>(period_);
+            }
+        } else {
+            atr_ = (atr_ * static_cast<double>(period_ - 1) + true_range) / static_cast<double>(period_);
+        }
+        last_true_range_ = true_range;
+    }
+
+    void update(const data::BarData& bar) {
+        update(bar.high, bar.low, bar.close);
+    }
+
+    double get_value() const {
+        if (!is_valid()) {
+            throw std::runtime_error("Not enough data points");
+        }
+        return atr_;
+    }
+
+    // 最近一根K线的真实波幅
+    double true_range() const { return last_true_range_; }
+
+    bool is_valid() const { return count_ >= period_; }
+
+    void reset() {
+        count_ = 0;
+        atr_ = 0.0;
+        prev_close_ = 0.0;
+        last_true_range_ = 0.0;
+    }
+
+    size_t period() const { return period_; }
+
+    void save_state(utils::BinaryWriter& writer) const {
+        writer.write<std::uint64_t>(period_);
+        writer.write<std::uint64_t>(count_);
+        writer.write(atr_);
+        writer.write(prev_close_);
+        writer.write(last_true_range_);
+    }
+
+    void load_state(utils::BinaryReader& reader) {
+        reader.expect<std::uint64_t>(period_, "ATR period");
+        count_ = static_cast<size_t>(reader.read<std::uint64_t>());
+        atr_ = reader.read<double>();
+        prev_close_ = reader.read<double>();
+        last_true_range_ = reader.read<double>();
+    }
+
+private:
+    size_t period_;
+    size_t count_ = 0;
+    double atr_ = 0.0;  // 预热期内为累计值
+    double prev_close_ = 0.0;
+    double last_true_range_ = 0.0;
+};
+
+} // namespace indicators
+} // namespace quant
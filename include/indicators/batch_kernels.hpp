@@ -0,0 +1,66 @@
+#pragma once
+
+#include "utils/span.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace quant {
+namespace indicators {
+
+// 批量指标内核
+//
+// 对整段连续列（例如BarSeries::close()）一次算出指标的完整输出序列，并支持在一次遍历中
+// 同时计算多个周期。运行时按CPU支持选择AVX-512 / AVX2 / 标量实现，结果与逐点更新的
+// 指标类一致（EMA、RSI逐位相同；SMA使用补偿前缀和，误差在1ulp量级）。
+//
+// 输出约定：
+// - 单周期函数的output长度须与input相同；
+// - 多周期函数的output按周期行优先排列，第k行（长度为input.size()）对应periods[k]；
+// - 预热期内（指标尚无有效值）输出NaN。
+namespace batch {
+
+enum class SimdLevel {
+    SCALAR,
+    AVX2,
+    AVX512
+};
+
+// 当前CPU支持的最高指令集
+SimdLevel detected_simd_level();
+
+// 实际使用的指令集，默认为detected_simd_level()
+SimdLevel active_simd_level();
+
+// 限制使用的指令集（用于对比测试和基准），超过CPU支持的级别时按CPU支持的级别处理
+void set_simd_level(SimdLevel level);
+
+const char* simd_level_name(SimdLevel level);
+
+enum class EmaSeed {
+    FIRST_VALUE,  // 以第一个值为初始值，与ExponentialMovingAverage一致，无预热期
+    SMA           // 以前period个值的SMA为初始值，与utils::EMA::calculate(vector)一致
+};
+
+void sma(utils::Span<const double> input, std::size_t period, utils::Span<double> output);
+void ema(utils::Span<const double> input, std::size_t period, utils::Span<double> output,
+         EmaSeed seed = EmaSeed::FIRST_VALUE);
+// Wilder平滑的RSI，与utils::RSI::calculate(vector)一致，前period个位置为NaN
+void rsi(utils::Span<const double> input, std::size_t period, utils::Span<double> output);
+
+void sma_multi(utils::Span<const double> input, utils::Span<const std::size_t> periods,
+               utils::Span<double> output);
+void ema_multi(utils::Span<const double> input, utils::Span<const std::size_t> periods,
+               utils::Span<double> output, EmaSeed seed = EmaSeed::FIRST_VALUE);
+void rsi_multi(utils::Span<const double> input, utils::Span<const std::size_t> periods,
+               utils::Span<double> output);
+
+// 返回新分配输出的便捷版本
+std::vector<double> sma(utils::Span<const double> input, std::size_t period);
+std::vector<double> ema(utils::Span<const double> input, std::size_t period,
+                        EmaSeed seed = EmaSeed::FIRST_VALUE);
+std::vector<double> rsi(utils::Span<const double> input, std::size_t period);
+
+} // namespace batch
+
+} // namespace indicators
+} // namespace quant
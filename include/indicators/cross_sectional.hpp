@@ -0,0 +1,108 @@
+#pragma once
+
+#include "utils/span.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace quant {
+namespace indicators {
+
+// 横截面指标
+//
+// 一个对象保存同一指标在N个品种上的状态，状态按字段分别存放在连续数组中（SoA），
+// update()一次推进全部品种的一个时刻。循环按运行时CPU支持编译为AVX-512 / AVX2 / 基础
+// 版本，结果与逐品种使用单序列指标逐位一致。
+//
+// update()的输入长度须等于品种数，下标即品种序号（例如按SymbolId排列的收盘价）。
+// NaN表示该品种本时刻没有数据，按该品种最近一次的价格补齐；从未有过数据的品种
+// 保持未就绪。values()中未就绪的品种为NaN。
+
+// 横截面简单移动平均，窗口按[时刻][品种]存放
+class CrossSectionalSMA {
+public:
+    CrossSectionalSMA(size_t symbols, size_t period);
+
+    void update(utils::Span<const double> values);
+
+    utils::Span<const double> values() const { return output_; }
+    double value(size_t symbol) const { return output_[symbol]; }
+    bool is_valid(size_t symbol) const { return count_[symbol] >= static_cast<double>(period_); }
+
+    void reset();
+
+    size_t symbols() const { return output_.size(); }
+    size_t period() const { return period_; }
+
+private:
+    size_t period_;
+    size_t next_ = 0;  // 下一个写入的时刻槽位
+    std::vector<double> window_;
+    std::vector<double> sum_;
+    std::vector<double> compensation_;
+    std::vector<double> last_;
+    std::vector<double> count_;  // 计数与状态同宽存放，便于向量化
+    std::vector<double> output_;
+};
+
+// 横截面指数移动平均，以各品种第一个值作为初始值
+class CrossSectionalEMA {
+public:
+    CrossSectionalEMA(size_t symbols, size_t period);
+
+    void update(utils::Span<const double> values);
+
+    utils::Span<const double> values() const { return output_; }
+    double value(size_t symbol) const { return output_[symbol]; }
+    bool is_valid(size_t symbol) const { return count_[symbol] > 0.0; }
+
+    void reset();
+
+    size_t symbols() const { return output_.size(); }
+    size_t period() const { return period_; }
+    double alpha() const { return alpha_; }
+
+private:
+    size_t period_;
+    double alpha_;
+    double one_minus_alpha_;
+    std::vector<double> last_;
+    std::vector<double> count_;
+    std::vector<double> output_;
+};
+
+// 横截面RSI（Wilder平滑，前period个涨跌幅的均值作为初始值）
+class CrossSectionalRSI {
+public:
+    CrossSectionalRSI(size_t symbols, size_t period);
+
+    void update(utils::Span<const double> values);
+
+    utils::Span<const double> values() const { return output_; }
+    double value(size_t symbol) const { return output_[symbol]; }
+    bool is_valid(size_t symbol) const { return count_[symbol] > static_cast<double>(period_); }
+
+    void reset();
+
+    size_t symbols() const { return output_.size(); }
+    size_t period() const { return period_; }
+
+private:
+    size_t period_;
+    std::vector<double> last_;
+    std::vector<double> avg_gain_;  // 预热期内为累计值
+    std::vector<double> avg_loss_;
+    std::vector<double> count_;
+    std::vector<double> output_;
+};
+
+// 横截面百分位排名：有效值按升序排名，映射到[0, 1]（最小为0，最大为1，并列取平均名次，
+// 只有一个有效值时为0.5）；NaN输入输出NaN。scratch用于排序，可跨调用复用避免分配
+void cross_sectional_rank(utils::Span<const double> values, utils::Span<double> output,
+                          std::vector<size_t>& scratch);
+void cross_sectional_rank(utils::Span<const double> values, utils::Span<double> output);
+
+// 横截面Z分数：(x - 均值) / 总体标准差，只统计有效值；标准差为0时输出0，NaN输入输出NaN
+void cross_sectional_zscore(utils::Span<const double> values, utils::Span<double> output);
+
+} // namespace indicators
+} // namespace quant
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "data/series_data_feed.hpp"
+#include "indicators/indicator_graph.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+namespace quant {
+namespace indicators {
+
+// 在品种完整序列上预先计算的指标列，与series逐根对齐，未就绪的位置为NaN
+struct IndicatorColumn {
+    data::BarSeries series;
+    std::vector<double> values;
+
+    std::size_t size() const { return values.size(); }
+
+    // 时间戳所在的下标，不存在时返回size()
+    std::size_t find(data::Timestamp timestamp) const;
+};
+
+// 指标列缓存
+//
+// 按(品种, 字段, 类型, 周期)在SeriesDataFeed中的完整序列上计算一次指标列，之后所有请求
+// 共享同一列。参数扫描、滚动验证中大量回测实例使用重叠的时间窗口时，指标不再随每个
+// 窗口从头重算，只需按时间戳读取。列覆盖整段历史，窗口开头的值已经过完整预热。
+//
+// 线程安全：同一列只计算一次，其他线程等待计算完成后共享结果。
+// 计算结果与对应的流式指标一致（EMA以第一个值为初始值，RSI为Wilder平滑）。
+class IndicatorColumnCache {
+public:
+    explicit IndicatorColumnCache(std::shared_ptr<data::SeriesDataFeed> data);
+
+    // 品种未加载时返回空列
+    std::shared_ptr<const IndicatorColumn> get(
+        data::SymbolId symbol,
+        IndicatorType type,
+        std::size_t period,
+        PriceField field = PriceField::CLOSE);
+
+    std::size_t size() const;
+
+    // 实际计算的列数，用于确认复用效果
+    std::uint64_t computations() const;
+
+private:
+    using Key = std::tuple<data::SymbolId, PriceField, IndicatorType, std::size_t>;
+    using ColumnPtr = std::shared_ptr<const IndicatorColumn>;
+
+    ColumnPtr compute(const Key& key) const;
+
+    std::shared_ptr<data::SeriesDataFeed> data_;
+    mutable std::mutex mutex_;
+    std::map<Key, std::shared_future<ColumnPtr>> columns_;
+    std::uint64_t computations_ = 0;
+};
+
+} // namespace indicators
+} // namespace quant
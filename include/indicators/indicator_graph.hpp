@@ -0,0 +1,108 @@
+#pragma once
+
+#include "data/data_types.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace quant {
+namespace indicators {
+
+enum class PriceField {
+    OPEN,
+    HIGH,
+    LOW,
+    CLOSE,
+    VOLUME
+};
+
+enum class IndicatorType {
+    SMA,
+    EMA,
+    RSI,
+    ROLLING_MIN,
+    ROLLING_MAX,
+    ROLLING_STDDEV
+};
+
+using NodeId = std::uint32_t;
+
+// 共享指标计算图
+//
+// 策略按(类型, 周期, 输入)申请指标节点，相同的申请返回同一个节点；输入可以是某个品种
+// K线的一个字段，也可以是另一个节点（指标的指标）。多个策略实例共用一张图时，同一根
+// K线上每个节点只计算一次：各策略在on_data中都调用update(bar)，只有第一次调用实际计算，
+// 之后的调用直接返回。
+//
+// 节点按创建顺序存放，输入总是先于依赖它的节点创建，创建顺序即拓扑顺序。
+// 节点状态由所有使用者共享，不能由单个策略重置。非线程安全，同一张图只能在一个线程上使用。
+class IndicatorGraph {
+public:
+    IndicatorGraph();
+    ~IndicatorGraph();
+
+    IndicatorGraph(const IndicatorGraph&) = delete;
+    IndicatorGraph& operator=(const IndicatorGraph&) = delete;
+
+    // 品种K线字段的源节点
+    NodeId source(data::SymbolId symbol, PriceField field = PriceField::CLOSE);
+
+    // 以input节点为输入的指标节点，已存在相同节点时直接返回，
+    // 例如add(IndicatorType::SMA, 20, graph.source(symbol))
+    NodeId add(IndicatorType type, std::size_t period, NodeId input);
+
+    // 用bar推进其品种上的全部节点，按时间戳去重：同一品种同一时间戳的重复调用不再计算
+    // （在此之后新建的节点仍会补算这根K线）。返回是否有节点被计算
+    bool update(const data::MarketData& bar);
+
+    // 节点当前值，未就绪时为NaN
+    double value(NodeId node) const { return values_[node]; }
+    bool is_valid(NodeId node) const { return !std::isnan(values_[node]); }
+
+    // 清空所有节点的状态，节点本身保留
+    void reset();
+
+    std::size_t node_count() const { return nodes_.size(); }
+
+    // 累计计算的节点次数，用于确认去重效果
+    std::uint64_t evaluations() const { return evaluations_; }
+
+    class Node;
+
+private:
+    struct Key {
+        std::uint64_t kind;    // 源节点为字段，指标节点为类型
+        std::uint64_t param;   // 源节点为品种，指标节点为周期
+        std::uint64_t input;   // 源节点不使用，指标节点为输入节点
+        bool operator==(const Key& other) const {
+            return kind == other.kind && param == other.param && input == other.input;
+        }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const;
+    };
+
+    // 每个品种上的节点及其计算进度
+    struct SymbolNodes {
+        std::vector<NodeId> nodes;      // 创建顺序
+        data::Timestamp timestamp = 0;  // 最近一次计算的K线时间戳
+        std::size_t evaluated = 0;      // 该时间戳上已计算的节点个数
+        bool started = false;
+    };
+
+    NodeId insert(const Key& key, data::SymbolId symbol, std::unique_ptr<Node> node);
+
+    std::vector<std::unique_ptr<Node>> nodes_;
+    std::vector<double> values_;
+    std::vector<data::SymbolId> symbol_of_;
+    std::unordered_map<Key, NodeId, KeyHash> index_;
+    std::vector<SymbolNodes> symbols_;  // 按SymbolId索引
+    std::uint64_t evaluations_ = 0;
+};
+
+} // namespace indicators
+} // namespace quant
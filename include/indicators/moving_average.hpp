@@ -1,103 +1,164 @@
- #pragma once
+#pragma once
 
-#include <vector>
-#include <deque>
-#include <numeric>
-#include <algorithm>
+#include "utils/compensated_sum.hpp"
+#include "utils/ring_buffer.hpp"
+#include "utils/span.hpp"
 #include <stdexcept>
-#include <cmath>
 
 namespace quant {
 namespace indicators {
 
 // 简单移动平均线
+//
+// 窗口数据存放在定长环形缓冲区中，维护补偿的滑动和：每次更新加入新值、减去移出的旧值，
+// 与周期长短无关，且构造之后不再分配内存。
 class SimpleMovingAverage {
 public:
-    explicit SimpleMovingAverage(size_t period) : period_(period) {
-        if (period == 0) {
-            throw std::invalid_argument("Period must be greater than 0");
+    explicit SimpleMovingAverage(size_t period) : period_(period), window_(check_period(period)) {}
+
+    void update(double value) {
+        double evicted = 0.0;
+        if (window_.push(value, evicted)) {
+            sum_.add(-evicted);
         }
+        sum_.add(value);
     }
-    
-    void update(double value) {
-        values_.push_back(value);
-        
-        // 保持队列大小不超过周期
-        if (values_.size() > period_) {
-            values_.pop_front();
+
+    // 批量更新，可直接传入BarSeries的列视图
+    void update(utils::Span<const double> values) {
+        for (double value : values) {
+            update(value);
         }
     }
-    
+
     double get_value() const {
-        if (values_.size() < period_) {
+        if (!window_.full()) {
             throw std::runtime_error("Not enough data points");
         }
-        
-        return std::accumulate(values_.begin(), values_.end(), 0.0) / values_.size();
+
+        return sum_.value() / static_cast<double>(period_);
     }
-    
+
     bool is_valid() const {
-        return values_.size() >= period_;
+        return window_.full();
     }
-    
+
     void reset() {
-        values_.clear();
+        window_.clear();
+        sum_.reset();
     }
-    
+
+    size_t period() const { return period_; }
+
+    // 检查点：保存 / 恢复窗口与累计和，恢复时周期须与保存时相同
+    void save_state(utils::BinaryWriter& writer) const {
+        writer.write<std::uint64_t>(period_);
+        window_.save_state(writer);
+        sum_.save_state(writer);
+    }
+
+    void load_state(utils::BinaryReader& reader) {
+        reader.expect<std::uint64_t>(period_, "SMA period");
+        window_.load_state(reader);
+        sum_.load_state(reader);
+    }
+
+    // 序列最后period个值的均值（无状态计算）
+    static double window_mean(utils::Span<const double> values, size_t period) {
+        check_period(period);
+        if (values.size() < period) {
+            throw std::invalid_argument("Not enough data points");
+        }
+        utils::CompensatedSum sum;
+        for (double value : values.last(period)) {
+            sum.add(value);
+        }
+        return sum.value() / static_cast<double>(period);
+    }
+
 private:
+    static size_t check_period(size_t period) {
+        if (period == 0) {
+            throw std::invalid_argument("Period must be greater than 0");
+        }
+        return period;
+    }
+
     size_t period_;
-    std::deque<double> values_;
+    utils::RingBuffer<double> window_;
+    utils::CompensatedSum sum_;
 };
 
-// 指数移动平均线
+// 指数移动平均线，以第一个值（或seed给定的值）作为初始值
 class ExponentialMovingAverage {
 public:
-    explicit ExponentialMovingAverage(size_t period) : period_(period), alpha_(2.0 / (period + 1)), initialized_(false) {
+    explicit ExponentialMovingAverage(size_t period)
+        : period_(period), alpha_(2.0 / (period + 1)), one_minus_alpha_(1 - alpha_) {
         if (period == 0) {
             throw std::invalid_argument("Period must be greater than 0");
         }
     }
-    
+
     void update(double value) {
         if (!initialized_) {
             current_value_ = value;
             initialized_ = true;
         } else {
-            current_value_ = alpha_ * value + (1 - alpha_) * current_value_;
+            current_value_ = alpha_ * value + one_minus_alpha_ * current_value_;
         }
-        
-        values_.push_back(value);
-        
-        // 保持队列大小不超过初始化所需的数据量
-        if (values_.size() > period_) {
-            values_.pop_front();
+    }
+
+    // 批量更新，可直接传入BarSeries的列视图
+    void update(utils::Span<const double> values) {
+        for (double value : values) {
+            update(value);
         }
     }
-    
+
+    // 指定初始值（例如前period个值的SMA），之后的更新从该值开始递推
+    void seed(double value) {
+        current_value_ = value;
+        initialized_ = true;
+    }
+
     double get_value() const {
         if (!initialized_) {
             throw std::runtime_error("EMA not initialized");
         }
-        
+
         return current_value_;
     }
-    
+
     bool is_valid() const {
         return initialized_;
     }
-    
+
     void reset() {
         initialized_ = false;
-        values_.clear();
     }
-    
+
+    size_t period() const { return period_; }
+    double alpha() const { return alpha_; }
+
+    void save_state(utils::BinaryWriter& writer) const {
+        writer.write<std::uint64_t>(period_);
+        writer.write(current_value_);
+        writer.write_bool(initialized_);
+    }
+
+    void load_state(utils::BinaryReader& reader) {
+        reader.expect<std::uint64_t>(period_, "EMA period");
+        current_value_ = reader.read<double>();
+        initialized_ = reader.read_bool();
+    }
+
 private:
     size_t period_;
     double alpha_;
+    double one_minus_alpha_;
     double current_value_ = 0.0;
-    bool initialized_;
-    std::deque<double> values_;
+    bool initialized_ = false;
 };
 
 } // namespace indicators
-} // namespace quant 
\ No newline at end of file
+} // namespace quant
@@ -0,0 +1,402 @@
+#pragma once
+
+#include "utils/ring_buffer.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+namespace quant {
+namespace indicators {
+
+namespace detail {
+
+inline size_t check_period(size_t period) {
+    if (period == 0) {
+        throw std::invalid_argument("Period must be greater than 0");
+    }
+    return period;
+}
+
+// 单调队列：队首为窗口内的极值，每个值至多入队、出队各一次，均摊O(1)
+template <typename Dominates>
+class MonotonicWindow {
+public:
+    explicit MonotonicWindow(size_t period) : period_(period), queue_(period) {}
+
+    // index为该值的序号（从1开始连续递增）
+    void push(size_t index, double value) {
+        while (!queue_.empty() && queue_.front().index + period_ <= index) {
+            queue_.pop_front();
+        }
+        while (!queue_.empty() && !Dominates()(queue_.back().value, value)) {
+            queue_.pop_back();
+        }
+        queue_.push(Entry{index, value});
+    }
+
+    double extreme() const { return queue_.front().value; }
+
+    void clear() { queue_.clear(); }
+
+    void save_state(utils::BinaryWriter& writer) const { queue_.save_state(writer); }
+    void load_state(utils::BinaryReader& reader) { queue_.load_state(reader); }
+
+private:
+    struct Entry {
+        size_t index = 0;
+        double value = 0.0;
+    };
+
+    size_t period_;
+    utils::RingBuffer<Entry> queue_;
+};
+
+struct Less {
+    bool operator()(double a, double b) const { return a < b; }
+};
+
+struct Greater {
+    bool operator()(double a, double b) const { return a > b; }
+};
+
+} // namespace detail
+
+// 滚动最小值 / 最大值（唐奇安通道）
+class RollingMinMax {
+public:
+    explicit RollingMinMax(size_t period)
+        : period_(detail::check_period(period)), min_(period), max_(period) {}
+
+    void update(double value) {
+        ++count_;
+        min_.push(count_, value);
+        max_.push(count_, value);
+    }
+
+    double get_min() const {
+        check_valid();
+        return min_.extreme();
+    }
+
+    double get_max() const {
+        check_valid();
+        return max_.extreme();
+    }
+
+    bool is_valid() const { return count_ >= period_; }
+
+    void reset() {
+        count_ = 0;
+        min_.clear();
+        max_.clear();
+    }
+
+    size_t period() const { return period_; }
+
+    // 检查点：保存 / 恢复单调队列，恢复时周期须与保存时相同
+    void save_state(utils::BinaryWriter& writer) const {
+        writer.write<std::uint64_t>(period_);
+        writer.write<std::uint64_t>(count_);
+        min_.save_state(writer);
+        max_.save_state(writer);
+    }
+
+    void load_state(utils::BinaryReader& reader) {
+        reader.expect<std::uint64_t>(period_, "Rolling window period");
+        count_ = static_cast<size_t>(reader.read<std::uint64_t>());
+        min_.load_state(reader);
+        max_.load_state(reader);
+    }
+
+private:
+    void check_valid() const {
+        if (!is_valid()) {
+            throw std::runtime_error("Not enough data points");
+        }
+    }
+
+    size_t period_;
+    size_t count_ = 0;
+    detail::MonotonicWindow<detail::Less> min_;
+    detail::MonotonicWindow<detail::Greater> max_;
+};
+
+// 滚动均值 / 方差（滑动窗口Welford）
+//
+// 每次更新用新值替换窗口中最旧的值，增量修正均值和二阶中心矩。为避免长时间运行后
+// 舍入误差累积，每满一个周期按窗口数据精确重算一次，均摊仍为O(1)。
+class RollingVariance {
+public:
+    explicit RollingVariance(size_t period) : period_(detail::check_period(period)), window_(period) {}
+
+    void update(double value) {
+        double evicted = 0.0;
+        if (!window_.push(value, evicted)) {
+            double delta = value - mean_;
+            mean_ += delta / static_cast<double>(window_.size());
+            m2_ += delta * (value - mean_);
+            return;
+        }
+
+        if (++updates_since_resync_ == period_) {
+            resync();
+            return;
+        }
+        double old_mean = mean_;
+        mean_ += (value - evicted) / static_cast<double>(period_);
+        m2_ += (value - evicted) * (value - mean_ + evicted - old_mean);
+        if (m2_ < 0.0) {
+            m2_ = 0.0;
+        }
+    }
+
+    double get_mean() const {
+        check_valid();
+        return mean_;
+    }
+
+    // 总体方差
+    double get_variance() const {
+        check_valid();
+        return m2_ / static_cast<double>(period_);
+    }
+
+    // 样本方差（除以period - 1），period为1时返回0
+    double get_sample_variance() const {
+        check_valid();
+        return period_ > 1 ? m2_ / static_cast<double>(period_ - 1) : 0.0;
+    }
+
+    double get_stddev() const { return std::sqrt(get_variance()); }
+
+    bool is_valid() const { return window_.full(); }
+
+    void reset() {
+        window_.clear();
+        mean_ = 0.0;
+        m2_ = 0.0;
+        updates_since_resync_ = 0;
+    }
+
+    size_t period() const { return period_; }
+
+    void save_state(utils::BinaryWriter& writer) const {
+        writer.write<std::uint64_t>(period_);
+        window_.save_state(writer);
+        writer.write(mean_);
+        writer.write(m2_);
+        writer.write<std::uint64_t>(updates_since_resync_);
+    }
+
+    void load_state(utils::BinaryReader& reader) {
+        reader.expect<std::uint64_t>(period_, "Rolling window period");
+        window_.load_state(reader);
+        mean_ = reader.read<double>();
+        m2_ = reader.read<double>();
+        updates_since_resync_ = static_cast<size_t>(reader.read<std::uint64_t>());
+    }
+
+private:
+    void check_valid() const {
+        if (!is_valid()) {
+            throw std::runtime_error("Not enough data points");
+        }
+    }
+
+    void resync() {
+        double sum = 0.0;
+        for (size_t i = 0; i < window_.size(); ++i) {
+            sum += window_[i];
+        }
+        mean_ = sum / static_cast<double>(window_.size());
+        m2_ = 0.0;
+        for (size_t i = 0; i < window_.size(); ++i) {
+            double delta = window_[i] - mean_;
+            m2_ += delta * delta;
+        }
+        updates_since_resync_ = 0;
+    }
+
+    size_t period_;
+    utils::RingBuffer<double> window_;
+    double mean_ = 0.0;
+    double m2_ = 0.0;  // 窗口内离差平方和
+    size_t updates_since_resync_ = 0;
+};
+
+// 滚动Z分数：最新值相对窗口均值的标准差倍数，窗口内无波动时为0
+class RollingZScore {
+public:
+    explicit RollingZScore(size_t period) : variance_(period) {}
+
+    void update(double value) {
+        variance_.update(value);
+        last_ = value;
+    }
+
+    double get_value() const {
+        double stddev = variance_.get_stddev();
+        return stddev > 0.0 ? (last_ - variance_.get_mean()) / stddev : 0.0;
+    }
+
+    bool is_valid() const { return variance_.is_valid(); }
+
+    void reset() { variance_.reset(); }
+
+    size_t period() const { return variance_.period(); }
+
+    const RollingVariance& variance() const { return variance_; }
+
+    void save_state(utils::BinaryWriter& writer) const {
+        variance_.save_state(writer);
+        writer.write(last_);
+    }
+
+    void load_state(utils::BinaryReader& reader) {
+        variance_.load_state(reader);
+        last_ = reader.read<double>();
+    }
+
+private:
+    RollingVariance variance_;
+    double last_ = 0.0;
+};
+
+// 两个序列的滚动协方差 / 相关系数 / beta
+//
+// 与RollingVariance相同的滑动Welford更新，同时维护x、y的二阶矩和交叉矩，
+// 每满一个周期精确重算一次。
+class RollingCovariance {
+public:
+    explicit RollingCovariance(size_t period)
+        : period_(detail::check_period(period)), x_window_(period), y_window_(period) {}
+
+    void update(double x, double y) {
+        double evicted_x = 0.0;
+        double evicted_y = 0.0;
+        y_window_.push(y, evicted_y);
+        if (!x_window_.push(x, evicted_x)) {
+            double n = static_cast<double>(x_window_.size());
+            double dx = x - mean_x_;
+            double dy = y - mean_y_;
+            mean_x_ += dx / n;
+            mean_y_ += dy / n;
+            m2_x_ += dx * (x - mean_x_);
+            m2_y_ += dy * (y - mean_y_);
+            co_moment_ += dx * (y - mean_y_);
+            return;
+        }
+
+        if (++updates_since_resync_ == period_) {
+            resync();
+            return;
+        }
+        double n = static_cast<double>(period_);
+        double old_mean_x = mean_x_;
+        double old_mean_y = mean_y_;
+        mean_x_ += (x - evicted_x) / n;
+        mean_y_ += (y - evicted_y) / n;
+        m2_x_ += (x - evicted_x) * (x - mean_x_ + evicted_x - old_mean_x);
+        m2_y_ += (y - evicted_y) * (y - mean_y_ + evicted_y - old_mean_y);
+        // 交叉矩：加入(x, y)、移除(evicted_x, evicted_y)
+        co_moment_ += (x - old_mean_x) * (y - mean_y_) - (evicted_x - old_mean_x) * (evicted_y - mean_y_);
+        if (m2_x_ < 0.0) {
+            m2_x_ = 0.0;
+        }
+        if (m2_y_ < 0.0) {
+            m2_y_ = 0.0;
+        }
+    }
+
+    // 总体协方差
+    double get_covariance() const {
+        check_valid();
+        return co_moment_ / static_cast<double>(period_);
+    }
+
+    // 相关系数，任一序列在窗口内无波动时为0
+    double get_correlation() const {
+        check_valid();
+        double denominator = std::sqrt(m2_x_ * m2_y_);
+        return denominator > 0.0 ? co_moment_ / denominator : 0.0;
+    }
+
+    // x对y的beta（cov(x, y) / var(y)），y在窗口内无波动时为0
+    double get_beta() const {
+        check_valid();
+        return m2_y_ > 0.0 ? co_moment_ / m2_y_ : 0.0;
+    }
+
+    bool is_valid() const { return x_window_.full(); }
+
+    void reset() {
+        x_window_.clear();
+        y_window_.clear();
+        mean_x_ = mean_y_ = 0.0;
+        m2_x_ = m2_y_ = co_moment_ = 0.0;
+        updates_since_resync_ = 0;
+    }
+
+    size_t period() const { return period_; }
+
+    void save_state(utils::BinaryWriter& writer) const {
+        writer.write<std::uint64_t>(period_);
+        x_window_.save_state(writer);
+        y_window_.save_state(writer);
+        for (double value : {mean_x_, mean_y_, m2_x_, m2_y_, co_moment_}) {
+            writer.write(value);
+        }
+        writer.write<std::uint64_t>(updates_since_resync_);
+    }
+
+    void load_state(utils::BinaryReader& reader) {
+        reader.expect<std::uint64_t>(period_, "Rolling window period");
+        x_window_.load_state(reader);
+        y_window_.load_state(reader);
+        for (double* value : {&mean_x_, &mean_y_, &m2_x_, &m2_y_, &co_moment_}) {
+            *value = reader.read<double>();
+        }
+        updates_since_resync_ = static_cast<size_t>(reader.read<std::uint64_t>());
+    }
+
+private:
+    void check_valid() const {
+        if (!is_valid()) {
+            throw std::runtime_error("Not enough data points");
+        }
+    }
+
+    void resync() {
+        double sum_x = 0.0;
+        double sum_y = 0.0;
+        for (size_t i = 0; i < period_; ++i) {
+            sum_x += x_window_[i];
+            sum_y += y_window_[i];
+        }
+        mean_x_ = sum_x / static_cast<double>(period_);
+        mean_y_ = sum_y / static_cast<double>(period_);
+        m2_x_ = m2_y_ = co_moment_ = 0.0;
+        for (size_t i = 0; i < period_; ++i) {
+            double dx = x_window_[i] - mean_x_;
+            double dy = y_window_[i] - mean_y_;
+            m2_x_ += dx * dx;
+            m2_y_ += dy * dy;
+            co_moment_ += dx * dy;
+        }
+        updates_since_resync_ = 0;
+    }
+
+    size_t period_;
+    utils::RingBuffer<double> x_window_;
+    utils::RingBuffer<double> y_window_;
+    double mean_x_ = 0.0;
+    double mean_y_ = 0.0;
+    double m2_x_ = 0.0;
+    double m2_y_ = 0.0;
+    double co_moment_ = 0.0;
+    size_t updates_since_resync_ = 0;
+};
+
+} // namespace indicators
+} // namespace quant
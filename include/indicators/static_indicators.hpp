@@ -0,0 +1,296 @@
+#pragma once
+
+#include "utils/binary_stream.hpp"
+#include "utils/compensated_sum.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+
+namespace quant {
+namespace indicators {
+
+// 编译期周期的指标
+//
+// 周期作为模板参数，窗口存放在std::array中，系数为编译期常量，热路径上不分配内存、
+// 不抛异常，整条指标链可以被内联展开进策略的on_data。计算结果与对应的运行期周期
+// 指标（SimpleMovingAverage、ExponentialMovingAverage、batch::rsi）逐位一致。
+//
+// 所有指标满足同一组接口，可以放进Pipeline / Difference组合：
+//   double update(double value) noexcept;  // 更新并返回value()
+//   double value() const noexcept;         // 当前值，ready()之前无意义
+//   bool ready() const noexcept;
+//   void reset() noexcept;
+//   static constexpr std::size_t warmup;   // 第一次ready()所需的输入个数
+//   void save_state(utils::BinaryWriter&) const;  // 检查点：保存 / 恢复内部状态，
+//   void load_state(utils::BinaryReader&);        // 恢复后继续更新与不间断更新逐位一致
+
+// 简单移动平均线
+template <std::size_t N>
+class SMA {
+    static_assert(N > 0, "SMA period must be greater than 0");
+
+public:
+    static constexpr std::size_t period = N;
+    static constexpr std::size_t warmup = N;
+
+    double update(double value) noexcept {
+        if (count_ == N) {
+            sum_.add(-window_[next_]);
+        } else {
+            ++count_;
+        }
+        window_[next_] = value;
+        next_ = next_ + 1 == N ? 0 : next_ + 1;
+        sum_.add(value);
+        return this->value();
+    }
+
+    double value() const noexcept { return sum_.value() / static_cast<double>(N); }
+    bool ready() const noexcept { return count_ == N; }
+
+    void reset() noexcept {
+        next_ = 0;
+        count_ = 0;
+        sum_.reset();
+    }
+
+    void save_state(utils::BinaryWriter& writer) const {
+        writer.write<std::uint64_t>(N);
+        writer.write_array(window_.data(), N);
+        writer.write<std::uint64_t>(next_);
+        writer.write<std::uint64_t>(count_);
+        sum_.save_state(writer);
+    }
+
+    void load_state(utils::BinaryReader& reader) {
+        reader.expect<std::uint64_t>(N, "SMA period");
+        reader.read_array(window_.data(), N);
+        next_ = static_cast<std::size_t>(reader.read<std::uint64_t>());
+        count_ = static_cast<std::size_t>(reader.read<std::uint64_t>());
+        if (next_ >= N || count_ > N) {
+            throw std::runtime_error("Corrupted SMA snapshot");
+        }
+        sum_.load_state(reader);
+    }
+
+private:
+    std::array<double, N> window_{};
+    std::size_t next_ = 0;
+    std::size_t count_ = 0;
+    utils::CompensatedSum sum_;
+};
+
+// 指数移动平均线，以第一个值作为初始值
+template <std::size_t N>
+class EMA {
+    static_assert(N > 0, "EMA period must be greater than 0");
+
+public:
+    static constexpr std::size_t period = N;
+    static constexpr std::size_t warmup = 1;
+    static constexpr double alpha = 2.0 / (N + 1);
+    static constexpr double one_minus_alpha = 1 - alpha;
+
+    double update(double value) noexcept {
+        current_ = initialized_ ? alpha * value + one_minus_alpha * current_ : value;
+        initialized_ = true;
+        return current_;
+    }
+
+    double value() const noexcept { return current_; }
+    bool ready() const noexcept { return initialized_; }
+
+    void reset() noexcept {
+        current_ = 0.0;
+        initialized_ = false;
+    }
+
+    void save_state(utils::BinaryWriter& writer) const {
+        writer.write<std::uint64_t>(N);
+        writer.write(current_);
+        writer.write_bool(initialized_);
+    }
+
+    void load_state(utils::BinaryReader& reader) {
+        reader.expect<std::uint64_t>(N, "EMA period");
+        current_ = reader.read<double>();
+        initialized_ = reader.read_bool();
+    }
+
+private:
+    double current_ = 0.0;
+    bool initialized_ = false;
+};
+
+// Wilder平滑的相对强弱指标，前N个涨跌幅的均值作为初始平均涨跌幅
+template <std::size_t N>
+class RSI {
+    static_assert(N > 0, "RSI period must be greater than 0");
+
+public:
+    static constexpr std::size_t period = N;
+    static constexpr std::size_t warmup = N + 1;
+
+    double update(double value) noexcept {
+        if (count_ == 0) {
+            prev_ = value;
+            ++count_;
+            return this->value();
+        }
+
+        double change = value - prev_;
+        double gain = change > 0 ? change : 0.0;
+        double loss = change > 0 ? 0.0 : -change;
+        prev_ = value;
+
+        if (count_ <= N) {
+            // 预热期：累计前N个涨跌幅
+            avg_gain_ += gain;
+            avg_loss_ += loss;
+            if (++count_ == N + 1) {
+                avg_gain_ /= kPeriod;
+                avg_loss_ /= kPeriod;
+            }
+        } else {
+            avg_gain_ = (avg_gain_ * kPeriodMinusOne + gain) / kPeriod;
+            avg_loss_ = (avg_loss_ * kPeriodMinusOne + loss) / kPeriod;
+        }
+        return this->value();
+    }
+
+    double value() const noexcept {
+        if (avg_loss_ == 0.0) {
+            return 100.0;
+        }
+        double rs = avg_gain_ / avg_loss_;
+        return 100.0 - (100.0 / (1.0 + rs));
+    }
+
+    bool ready() const noexcept { return count_ > N; }
+
+    void reset() noexcept {
+        prev_ = 0.0;
+        avg_gain_ = 0.0;
+        avg_loss_ = 0.0;
+        count_ = 0;
+    }
+
+    void save_state(utils::BinaryWriter& writer) const {
+        writer.write<std::uint64_t>(N);
+        writer.write(prev_);
+        writer.write(avg_gain_);
+        writer.write(avg_loss_);
+        writer.write<std::uint64_t>(count_);
+    }
+
+    void load_state(utils::BinaryReader& reader) {
+        reader.expect<std::uint64_t>(N, "RSI period");
+        prev_ = reader.read<double>();
+        avg_gain_ = reader.read<double>();
+        avg_loss_ = reader.read<double>();
+        count_ = static_cast<std::size_t>(reader.read<std::uint64_t>());
+    }
+
+private:
+    static constexpr double kPeriod = static_cast<double>(N);
+    static constexpr double kPeriodMinusOne = kPeriod - 1;
+
+    double prev_ = 0.0;
+    double avg_gain_ = 0.0;  // 预热期内为累计值
+    double avg_loss_ = 0.0;
+    std::size_t count_ = 0;
+};
+
+// 串联：前一级的输出作为后一级的输入，例如Pipeline<SMA<10>, EMA<5>>。
+// 前一级ready()之后才开始向后一级输入，预热期的不完整值不会进入后一级
+template <typename First, typename... Rest>
+class Pipeline {
+public:
+    static constexpr std::size_t size = 1 + sizeof...(Rest);
+    static constexpr std::size_t warmup = (First::warmup + ... + Rest::warmup) - sizeof...(Rest);
+
+    double update(double value) noexcept {
+        feed<0>(value);
+        return this->value();
+    }
+
+    double value() const noexcept { return std::get<size - 1>(stages_).value(); }
+    bool ready() const noexcept { return std::get<size - 1>(stages_).ready(); }
+
+    void reset() noexcept {
+        std::apply([](auto&... stage) { (stage.reset(), ...); }, stages_);
+    }
+
+    void save_state(utils::BinaryWriter& writer) const {
+        std::apply([&writer](const auto&... stage) { (stage.save_state(writer), ...); }, stages_);
+    }
+
+    void load_state(utils::BinaryReader& reader) {
+        std::apply([&reader](auto&... stage) { (stage.load_state(reader), ...); }, stages_);
+    }
+
+    // 第I级指标
+    template <std::size_t I>
+    const auto& stage() const noexcept { return std::get<I>(stages_); }
+
+private:
+    template <std::size_t I>
+    void feed(double value) noexcept {
+        auto& stage = std::get<I>(stages_);
+        double output = stage.update(value);
+        if constexpr (I + 1 < size) {
+            if (stage.ready()) {
+                feed<I + 1>(output);
+            }
+        }
+    }
+
+    std::tuple<First, Rest...> stages_;
+};
+
+// 并联相减：同一输入分别送入A和B，输出A - B，例如MACD线Difference<EMA<12>, EMA<26>>
+template <typename A, typename B>
+class Difference {
+public:
+    static constexpr std::size_t warmup = A::warmup > B::warmup ? A::warmup : B::warmup;
+
+    double update(double value) noexcept {
+        a_.update(value);
+        b_.update(value);
+        return this->value();
+    }
+
+    double value() const noexcept { return a_.value() - b_.value(); }
+    bool ready() const noexcept { return a_.ready() && b_.ready(); }
+
+    void reset() noexcept {
+        a_.reset();
+        b_.reset();
+    }
+
+    void save_state(utils::BinaryWriter& writer) const {
+        a_.save_state(writer);
+        b_.save_state(writer);
+    }
+
+    void load_state(utils::BinaryReader& reader) {
+        a_.load_state(reader);
+        b_.load_state(reader);
+    }
+
+    const A& first() const noexcept { return a_; }
+    const B& second() const noexcept { return b_; }
+
+private:
+    A a_;
+    B b_;
+};
+
+// MACD信号线
+template <std::size_t Fast = 12, std::size_t Slow = 26, std::size_t Signal = 9>
+using MACDSignal = Pipeline<Difference<EMA<Fast>, EMA<Slow>>, EMA<Signal>>;
+
+} // namespace indicators
+} // namespace quant
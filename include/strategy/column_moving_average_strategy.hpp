@@ -0,0 +1,125 @@
+#pragma once
+
+#include "strategy/moving_average_strategy.hpp"
+#include "indicators/indicator_columns.hpp"
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace quant {
+namespace strategy {
+
+// 双均线策略，均线从预先计算的指标列中按时间戳读取，重叠窗口上的多个实例不再重复计算。
+// 列覆盖整段历史，从任意时间开始回测时均线都已完成预热；除此之外与MovingAverageStrategy(fast, slow)
+// 产生相同的信号
+class ColumnMovingAverageStrategy : public Strategy {
+public:
+    ColumnMovingAverageStrategy(int fast_period, int slow_period, std::shared_ptr<indicators::IndicatorColumnCache> columns)
+        : fast_period_(fast_period),
+          slow_period_(slow_period),
+          columns_(std::move(columns)) {
+        if (fast_period <= 0 || slow_period <= 0) {
+            throw std::invalid_argument("Period must be greater than 0");
+        }
+        if (!columns_) {
+            throw std::invalid_argument("Indicator column cache cannot be null");
+        }
+    }
+
+    void initialize() override {
+        index_ = 0;
+        crossover_.reset();
+    }
+
+    std::optional<Signal> on_data(const data::MarketData& data) override {
+        double fast_value;
+        double slow_value;
+        SignalType type;
+        if (!column_values(data.symbol, data.timestamp, fast_value, slow_value) ||
+            !crossover_.update(fast_value, slow_value, type)) {
+            return std::nullopt;
+        }
+        return MovingAverageCrossover::make_signal(data, type);
+    }
+
+    bool supports_batch() const override {
+        return true;
+    }
+
+    void on_data_batch(const data::BarSeriesView& bars, SignalBuffer& signals) override {
+        for (size_t i = 0; i < bars.size(); ++i) {
+            double fast_value;
+            double slow_value;
+            SignalType type;
+            if (column_values(bars.symbol(), bars.timestamp_at(i), fast_value, slow_value) &&
+                crossover_.update(fast_value, slow_value, type)) {
+                signals.emit(bars, i, type);
+            }
+        }
+    }
+
+    // 列按时间戳定位，只需保存交叉判断的前值
+    bool supports_checkpoint() const override {
+        return true;
+    }
+
+    void save_state(utils::BinaryWriter& writer) const override {
+        writer.write<std::int32_t>(fast_period_);
+        writer.write<std::int32_t>(slow_period_);
+        crossover_.save_state(writer);
+    }
+
+    void load_state(utils::BinaryReader& reader) override {
+        reader.expect<std::int32_t>(fast_period_, "Fast period");
+        reader.expect<std::int32_t>(slow_period_, "Slow period");
+        crossover_.load_state(reader);
+    }
+
+    std::string name() const override {
+        return "ColumnMovingAverageStrategy";
+    }
+
+    std::unordered_map<std::string, std::string> parameters() const override {
+        return {
+            {"fast_period", std::to_string(fast_period_)},
+            {"slow_period", std::to_string(slow_period_)}
+        };
+    }
+
+private:
+    // 从指标列读取该K线的快慢线，未就绪或列中没有该时间戳时返回false
+    bool column_values(data::SymbolId symbol, data::Timestamp timestamp, double& fast_value, double& slow_value) {
+        if (symbol != symbol_) {
+            fast_column_ = columns_->get(symbol, indicators::IndicatorType::SMA, fast_period_);
+            slow_column_ = columns_->get(symbol, indicators::IndicatorType::SMA, slow_period_);
+            symbol_ = symbol;
+            index_ = 0;
+        }
+        // K线按时间顺序到达，通常正好是上一根的下一根，否则按时间戳查找
+        auto timestamps = fast_column_->series.timestamps();
+        if (index_ >= timestamps.size() || timestamps[index_] != timestamp) {
+            index_ = fast_column_->find(timestamp);
+            if (index_ >= timestamps.size()) {
+                return false;
+            }
+        }
+        fast_value = fast_column_->values[index_];
+        slow_value = slow_column_->values[index_];
+        ++index_;
+        return !std::isnan(fast_value) && !std::isnan(slow_value);
+    }
+
+    int fast_period_;
+    int slow_period_;
+    std::shared_ptr<indicators::IndicatorColumnCache> columns_;
+    std::shared_ptr<const indicators::IndicatorColumn> fast_column_;
+    std::shared_ptr<const indicators::IndicatorColumn> slow_column_;
+    data::SymbolId symbol_ = data::kInvalidSymbolId;
+    std::size_t index_ = 0;  // 下一根K线在列中的预期下标
+    MovingAverageCrossover crossover_;
+};
+
+} // namespace strategy
+} // namespace quant
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "strategy/moving_average_strategy.hpp"
+#include "indicators/indicator_graph.hpp"
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace quant {
+namespace strategy {
+
+// 双均线策略，均线从共享的指标图中申请，多个实例的相同均线只计算一次。
+// 与MovingAverageStrategy(fast, slow)产生相同的信号。
+// 图中节点的状态由所有使用者共享：initialize()只重置交叉判断，不会重置节点，也不支持检查点
+class GraphMovingAverageStrategy : public Strategy {
+public:
+    GraphMovingAverageStrategy(int fast_period, int slow_period, std::shared_ptr<indicators::IndicatorGraph> graph)
+        : fast_period_(fast_period),
+          slow_period_(slow_period),
+          graph_(std::move(graph)) {
+        if (fast_period <= 0 || slow_period <= 0) {
+            throw std::invalid_argument("Period must be greater than 0");
+        }
+        if (!graph_) {
+            throw std::invalid_argument("Indicator graph cannot be null");
+        }
+    }
+
+    void initialize() override {
+        crossover_.reset();
+    }
+
+    std::optional<Signal> on_data(const data::MarketData& data) override {
+        if (data.symbol != symbol_) {
+            indicators::NodeId close = graph_->source(data.symbol);
+            fast_node_ = graph_->add(indicators::IndicatorType::SMA, fast_period_, close);
+            slow_node_ = graph_->add(indicators::IndicatorType::SMA, slow_period_, close);
+            symbol_ = data.symbol;
+        }
+        graph_->update(data);
+        if (!graph_->is_valid(fast_node_) || !graph_->is_valid(slow_node_)) {
+            return std::nullopt;
+        }
+
+        SignalType type;
+        if (!crossover_.update(graph_->value(fast_node_), graph_->value(slow_node_), type)) {
+            return std::nullopt;
+        }
+        return MovingAverageCrossover::make_signal(data, type);
+    }
+
+    std::string name() const override {
+        return "GraphMovingAverageStrategy";
+    }
+
+    std::unordered_map<std::string, std::string> parameters() const override {
+        return {
+            {"fast_period", std::to_string(fast_period_)},
+            {"slow_period", std::to_string(slow_period_)}
+        };
+    }
+
+private:
+    int fast_period_;
+    int slow_period_;
+    std::shared_ptr<indicators::IndicatorGraph> graph_;
+    data::SymbolId symbol_ = data::kInvalidSymbolId;
+    indicators::NodeId fast_node_ = 0;
+    indicators::NodeId slow_node_ = 0;
+    MovingAverageCrossover crossover_;
+};
+
+} // namespace strategy
+} // namespace quant
@@ -2,88 +2,158 @@
 
 #include "strategy.hpp"
 #include "indicators/moving_average.hpp"
+#include <cstdint>
 #include <memory>
 #include <string>
 
 namespace quant {
 namespace strategy {
 
+// 双均线交叉判断：金叉（快线上穿慢线）买入，死叉（快线下穿慢线）卖出。
+// 记录上一次的快慢线数值，供均线来源不同的双均线策略共用
+class MovingAverageCrossover {
+public:
+    // 用本次数值判断是否交叉并记录，交叉时写入type并返回true
+    bool update(double fast_value, double slow_value, SignalType& type) {
+        bool crossed = false;
+        if (prev_fast_value_ < prev_slow_value_ && fast_value > slow_value) {
+            type = SignalType::BUY;
+            crossed = true;
+        } else if (prev_fast_value_ > prev_slow_value_ && fast_value < slow_value) {
+            type = SignalType::SELL;
+            crossed = true;
+        }
+
+        // 更新前值
+        prev_fast_value_ = fast_value;
+        prev_slow_value_ = slow_value;
+        return crossed;
+    }
+
+    // 清空前值，重新开始时第一组数值不会触发交叉
+    void reset() {
+        prev_fast_value_ = 0.0;
+        prev_slow_value_ = 0.0;
+    }
+
+    void save_state(utils::BinaryWriter& writer) const {
+        writer.write(prev_fast_value_);
+        writer.write(prev_slow_value_);
+    }
+
+    void load_state(utils::BinaryReader& reader) {
+        prev_fast_value_ = reader.read<double>();
+        prev_slow_value_ = reader.read<double>();
+    }
+
+    // 该K线上的信号
+    static Signal make_signal(const data::MarketData& data, SignalType type) {
+        Signal signal;
+        signal.type = type;
+        signal.symbol = data.symbol;
+        signal.timestamp = data.timestamp;
+        return signal;
+    }
+
+private:
+    double prev_fast_value_ = 0.0;
+    double prev_slow_value_ = 0.0;
+};
+
+// 双均线策略，快慢两条SMA由策略自己持有并逐根更新。
+// 多个实例共用均线见GraphMovingAverageStrategy和ColumnMovingAverageStrategy
 class MovingAverageStrategy : public Strategy {
 public:
     MovingAverageStrategy(int fast_period = 10, int slow_period = 30)
         : fast_period_(fast_period),
           slow_period_(slow_period),
-          fast_ma_(std::make_shared<indicators::SimpleMovingAverage>(fast_period)),
-          slow_ma_(std::make_shared<indicators::SimpleMovingAverage>(slow_period)) {}
-    
+          fast_ma_(fast_period),
+          slow_ma_(slow_period) {}
+
     void initialize() override {
         // 重置指标
-        fast_ma_->reset();
-        slow_ma_->reset();
+        fast_ma_.reset();
+        slow_ma_.reset();
+        crossover_.reset();
     }
-    
+
     std::optional<Signal> on_data(const data::MarketData& data) override {
         // 更新指标
-        fast_ma_->update(data.close);
-        slow_ma_->update(data.close);
-        
+        fast_ma_.update(data.close);
+        slow_ma_.update(data.close);
+
         // 检查是否有足够的数据点
-        if (!fast_ma_->is_valid() || !slow_ma_->is_valid()) {
+        if (!fast_ma_.is_valid() || !slow_ma_.is_valid()) {
             return std::nullopt;
         }
-        
-        double fast_value = fast_ma_->get_value();
-        double slow_value = slow_ma_->get_value();
-        
+
         // 生成交易信号
-        if (prev_fast_value_ < prev_slow_value_ && fast_value > slow_value) {
-            // 金叉：快线上穿慢线，买入信号
-            Signal signal;
-            signal.type = SignalType::BUY;
-            signal.symbol = data.symbol;
-            signal.timestamp = data.timestamp;
-            
-            prev_fast_value_ = fast_value;
-            prev_slow_value_ = slow_value;
-            return signal;
+        SignalType type;
+        if (!crossover_.update(fast_ma_.get_value(), slow_ma_.get_value(), type)) {
+            return std::nullopt;
         }
-        else if (prev_fast_value_ > prev_slow_value_ && fast_value < slow_value) {
-            // 死叉：快线下穿慢线，卖出信号
-            Signal signal;
-            signal.type = SignalType::SELL;
-            signal.symbol = data.symbol;
-            signal.timestamp = data.timestamp;
-            
-            prev_fast_value_ = fast_value;
-            prev_slow_value_ = slow_value;
-            return signal;
+        return MovingAverageCrossover::make_signal(data, type);
+    }
+
+    // 直接在收盘价列上推进
+    bool supports_batch() const override {
+        return true;
+    }
+
+    void on_data_batch(const data::BarSeriesView& bars, SignalBuffer& signals) override {
+        auto closes = bars.close();
+        for (size_t i = 0; i < closes.size(); ++i) {
+            fast_ma_.update(closes[i]);
+            slow_ma_.update(closes[i]);
+            if (!fast_ma_.is_valid() || !slow_ma_.is_valid()) {
+                continue;
+            }
+
+            SignalType type;
+            if (crossover_.update(fast_ma_.get_value(), slow_ma_.get_value(), type)) {
+                signals.emit(bars, i, type);
+            }
         }
-        
-        // 更新前值
-        prev_fast_value_ = fast_value;
-        prev_slow_value_ = slow_value;
-        return std::nullopt;
     }
-    
+
+    bool supports_checkpoint() const override {
+        return true;
+    }
+
+    void save_state(utils::BinaryWriter& writer) const override {
+        writer.write<std::int32_t>(fast_period_);
+        writer.write<std::int32_t>(slow_period_);
+        crossover_.save_state(writer);
+        fast_ma_.save_state(writer);
+        slow_ma_.save_state(writer);
+    }
+
+    void load_state(utils::BinaryReader& reader) override {
+        reader.expect<std::int32_t>(fast_period_, "Fast period");
+        reader.expect<std::int32_t>(slow_period_, "Slow period");
+        crossover_.load_state(reader);
+        fast_ma_.load_state(reader);
+        slow_ma_.load_state(reader);
+    }
+
     std::string name() const override {
         return "MovingAverageStrategy";
     }
-    
+
     std::unordered_map<std::string, std::string> parameters() const override {
         return {
             {"fast_period", std::to_string(fast_period_)},
             {"slow_period", std::to_string(slow_period_)}
         };
     }
-    
+
 private:
     int fast_period_;
     int slow_period_;
-    std::shared_ptr<indicators::SimpleMovingAverage> fast_ma_;
-    std::shared_ptr<indicators::SimpleMovingAverage> slow_ma_;
-    double prev_fast_value_ = 0.0;
-    double prev_slow_value_ = 0.0;
+    indicators::SimpleMovingAverage fast_ma_;
+    indicators::SimpleMovingAverage slow_ma_;
+    MovingAverageCrossover crossover_;
 };
 
 } // namespace strategy
-} // namespace quant 
\ No newline at end of file
+} // namespace quant
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "strategy/moving_average_strategy.hpp"
+#include "indicators/static_indicators.hpp"
+#include <string>
+
+namespace quant {
+namespace strategy {
+
+// 编译期周期的双均线策略
+//
+// 与MovingAverageStrategy(Fast, Slow)产生相同的信号；均线直接作为成员、周期为模板参数，
+// on_data中的指标更新可以完全内联。类声明为final，通过具体类型调用时不走虚函数。
+template <std::size_t Fast, std::size_t Slow>
+class StaticMovingAverageStrategy final : public Strategy {
+    static_assert(Fast < Slow, "Fast period must be shorter than slow period");
+
+public:
+    void initialize() override {
+        fast_ma_.reset();
+        slow_ma_.reset();
+        crossover_.reset();
+    }
+
+    std::optional<Signal> on_data(const data::MarketData& data) override {
+        double fast_value = fast_ma_.update(data.close);
+        double slow_value = slow_ma_.update(data.close);
+        if (!slow_ma_.ready()) {
+            return std::nullopt;
+        }
+
+        SignalType type;
+        if (!crossover_.update(fast_value, slow_value, type)) {
+            return std::nullopt;
+        }
+        return MovingAverageCrossover::make_signal(data, type);
+    }
+
+    bool supports_batch() const override {
+        return true;
+    }
+
+    void on_data_batch(const data::BarSeriesView& bars, SignalBuffer& signals) override {
+        auto closes = bars.close();
+        for (std::size_t i = 0; i < closes.size(); ++i) {
+            double fast_value = fast_ma_.update(closes[i]);
+            double slow_value = slow_ma_.update(closes[i]);
+            if (!slow_ma_.ready()) {
+                continue;
+            }
+
+            SignalType type;
+            if (crossover_.update(fast_value, slow_value, type)) {
+                signals.emit(bars, i, type);
+            }
+        }
+    }
+
+    bool supports_checkpoint() const override {
+        return true;
+    }
+
+    void save_state(utils::BinaryWriter& writer) const override {
+        fast_ma_.save_state(writer);
+        slow_ma_.save_state(writer);
+        crossover_.save_state(writer);
+    }
+
+    void load_state(utils::BinaryReader& reader) override {
+        fast_ma_.load_state(reader);
+        slow_ma_.load_state(reader);
+        crossover_.load_state(reader);
+    }
+
+    std::string name() const override {
+        return "StaticMovingAverageStrategy";
+    }
+
+    std::unordered_map<std::string, std::string> parameters() const override {
+        return {
+            {"fast_period", std::to_string(Fast)},
+            {"slow_period", std::to_string(Slow)}
+        };
+    }
+
+private:
+    indicators::SMA<Fast> fast_ma_;
+    indicators::SMA<Slow> slow_ma_;
+    MovingAverageCrossover crossover_;
+};
+
+} // namespace strategy
+} // namespace quant
@@ -1,11 +1,15 @@
 #pragma once
 
+#include "data/bar_series.hpp"
 #include "data/data_types.hpp"
+#include "utils/binary_stream.hpp"
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <vector>
 #include <unordered_map>
 #include <functional>
+#include <mutex>
 #include <optional>
 
 namespace quant {
@@ -21,12 +25,47 @@ enum class SignalType {
 // 交易信号
 struct Signal {
     data::Timestamp timestamp;
-    std::string symbol;
+    data::SymbolId symbol;
     SignalType type;
     double strength = 1.0;  // 信号强度，0.0-1.0
     std::unordered_map<std::string, std::string> metadata;
 };
 
+// 批量接口输出的信号（POD，写入时不分配内存）
+struct BatchSignal {
+    std::uint32_t index;         // 信号所在K线在输入块中的下标
+    data::SymbolId symbol;
+    data::Timestamp timestamp;
+    SignalType type;
+    double strength;
+};
+
+// 调用方预先分配、跨批次复用的信号缓冲区
+class SignalBuffer {
+public:
+    explicit SignalBuffer(std::size_t capacity = 1024) { signals_.reserve(capacity); }
+
+    // 在预留容量内追加不分配内存，超出时自动扩容
+    void push(const BatchSignal& signal) { signals_.push_back(signal); }
+
+    // 为bars中第index根K线追加一个信号
+    void emit(const data::BarSeriesView& bars, std::size_t index, SignalType type, double strength = 1.0) {
+        signals_.push_back(BatchSignal{static_cast<std::uint32_t>(index), bars.symbol(),
+                                       bars.timestamp_at(index), type, strength});
+    }
+
+    void clear() { signals_.clear(); }
+
+    std::size_t size() const { return signals_.size(); }
+    bool empty() const { return signals_.empty(); }
+    const BatchSignal& operator[](std::size_t i) const { return signals_[i]; }
+    std::vector<BatchSignal>::const_iterator begin() const { return signals_.begin(); }
+    std::vector<BatchSignal>::const_iterator end() const { return signals_.end(); }
+
+private:
+    std::vector<BatchSignal> signals_;
+};
+
 // 策略接口
 class Strategy {
 public:
@@ -37,6 +76,23 @@ public:
     
     // 处理新的市场数据
     virtual std::optional<Signal> on_data(const data::MarketData& data) = 0;
+
+    // 是否实现了高效的批量接口；为true时回测引擎在单品种回测中按块调用on_data_batch
+    virtual bool supports_batch() const { return false; }
+
+    // 批量处理单一品种按时间升序的一段K线，把信号按K线顺序追加到signals（不清空）。
+    // 结果须与对每根K线依次调用on_data相同；默认实现即逐根调用on_data
+    virtual void on_data_batch(const data::BarSeriesView& bars, SignalBuffer& signals);
+
+    // 是否支持检查点；为true时回测引擎的checkpoint()/restore()通过save_state/load_state保存和恢复策略状态
+    virtual bool supports_checkpoint() const { return false; }
+
+    // 写出指标与信号判断所需的全部内部状态。恢复后继续处理新K线的结果须与不间断运行逐位一致；
+    // 默认实现抛出logic_error
+    virtual void save_state(utils::BinaryWriter& writer) const;
+
+    // 读取save_state写出的状态，参数与快照不符时抛出runtime_error；默认实现抛出logic_error
+    virtual void load_state(utils::BinaryReader& reader);
     
     // 策略名称
     virtual std::string name() const = 0;
@@ -45,7 +101,7 @@ public:
     virtual std::unordered_map<std::string, std::string> parameters() const = 0;
 };
 
-// 策略工厂，用于创建策略实例
+// 策略工厂，用于创建策略实例；注册表由互斥锁保护，可在多个线程上同时创建策略
 class StrategyFactory {
 public:
     using StrategyCreator = std::function<std::unique_ptr<Strategy>()>;
@@ -61,6 +117,7 @@ public:
     
 private:
     static std::unordered_map<std::string, StrategyCreator>& get_registry();
+    static std::mutex& get_mutex();
 };
 
 // 策略注册辅助宏
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "data/bar_series.hpp"
+#include "utils/span.hpp"
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+namespace quant {
+namespace strategy {
+
+// 向量化策略：一次由整段列式K线计算出与K线逐根对齐的信号列
+//
+// 列中值的含义由回测的SignalMode决定：信号模式下>0为买入、<0为卖出、0为无操作；
+// 目标仓位模式下为持仓市值占总资产的比例，NaN表示维持当前持仓。
+// generate应只依赖传入的K线，同一实例可用于多个品种。
+class VectorizedStrategy {
+public:
+    virtual ~VectorizedStrategy() = default;
+
+    // output与bars等长，调用前已全部置为0
+    virtual void generate(const data::BarSeriesView& bars, utils::Span<double> output) = 0;
+
+    virtual std::string name() const = 0;
+
+    virtual std::unordered_map<std::string, std::string> parameters() const { return {}; }
+};
+
+// 双均线交叉的向量化版本
+//
+// 先算出整列快慢线，再在两列上逐位比较得到交叉信号。均线按SimpleMovingAverage相同的
+// 补偿求和顺序计算，信号与MovingAverageStrategy逐根一致。
+class VectorizedMovingAverageStrategy : public VectorizedStrategy {
+public:
+    VectorizedMovingAverageStrategy(int fast_period = 10, int slow_period = 30);
+
+    void generate(const data::BarSeriesView& bars, utils::Span<double> output) override;
+
+    std::string name() const override {
+        return "VectorizedMovingAverageStrategy";
+    }
+
+    std::unordered_map<std::string, std::string> parameters() const override {
+        return {
+            {"fast_period", std::to_string(fast_period_)},
+            {"slow_period", std::to_string(slow_period_)}
+        };
+    }
+
+private:
+    std::size_t fast_period_;
+    std::size_t slow_period_;
+};
+
+} // namespace strategy
+} // namespace quant
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace quant {
+namespace utils {
+
+// 按字节写入定长数值、字符串与数组，用于状态快照
+//
+// 数值按本机字节序原样写入，快照只在字节序相同的平台之间通用。
+// 带填充字节的结构体应逐个字段写入，保证相同状态写出相同的字节。
+class BinaryWriter {
+public:
+    explicit BinaryWriter(std::vector<std::uint8_t>& out) : out_(out) {}
+
+    template <typename T>
+    void write(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "BinaryWriter requires trivially copyable values");
+        const std::size_t offset = out_.size();
+        out_.resize(offset + sizeof(T));
+        std::memcpy(out_.data() + offset, &value, sizeof(T));
+    }
+
+    void write_bool(bool value) { write<std::uint8_t>(value ? 1 : 0); }
+
+    // 长度在前
+    void write_string(const std::string& value) {
+        write<std::uint64_t>(value.size());
+        out_.insert(out_.end(), value.begin(), value.end());
+    }
+
+    // 元素个数在前
+    template <typename T>
+    void write_array(const T* values, std::size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "BinaryWriter requires trivially copyable values");
+        write<std::uint64_t>(count);
+        const auto* bytes = reinterpret_cast<const std::uint8_t*>(values);
+        out_.insert(out_.end(), bytes, bytes + count * sizeof(T));
+    }
+
+    template <typename T>
+    void write_vector(const std::vector<T>& values) {
+        write_array(values.data(), values.size());
+    }
+
+    // 预留additional字节，写出大块状态前调用以避免反复扩容
+    void reserve(std::size_t additional) { out_.reserve(out_.size() + additional); }
+
+    std::size_t size() const { return out_.size(); }
+
+private:
+    std::vector<std::uint8_t>& out_;
+};
+
+// 按BinaryWriter的格式读取，数据不足时抛出runtime_error
+class BinaryReader {
+public:
+    BinaryReader(const std::uint8_t* data, std::size_t size) : data_(data), size_(size) {}
+    explicit BinaryReader(const std::vector<std::uint8_t>& data) : BinaryReader(data.data(), data.size()) {}
+
+    template <typename T>
+    T read() {
+        static_assert(std::is_trivially_copyable<T>::value, "BinaryReader requires trivially copyable values");
+        require(sizeof(T));
+        T value;
+        std::memcpy(&value, data_ + position_, sizeof(T));
+        position_ += sizeof(T);
+        return value;
+    }
+
+    bool read_bool() { return read<std::uint8_t>() != 0; }
+
+    // 读取一个值并确认与expected相同（例如指标周期），不同时抛出runtime_error
+    template <typename T>
+    void expect(const T& expected, const char* what) {
+        if (read<T>() != expected) {
+            throw std::runtime_error(std::string(what) + " does not match snapshot");
+        }
+    }
+
+    std::string read_string() {
+        const std::size_t length = read_count(1);
+        std::string value(reinterpret_cast<const char*>(data_ + position_), length);
+        position_ += length;
+        return value;
+    }
+
+    // 读入恰好count个元素，快照中的个数不同时抛出runtime_error
+    template <typename T>
+    void read_array(T* values, std::size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "BinaryReader requires trivially copyable values");
+        if (read_count(sizeof(T)) != count) {
+            throw std::runtime_error("Snapshot array size mismatch");
+        }
+        if (count > 0) {
+            std::memcpy(values, data_ + position_, count * sizeof(T));
+            position_ += count * sizeof(T);
+        }
+    }
+
+    template <typename T>
+    std::vector<T> read_vector() {
+        static_assert(std::is_trivially_copyable<T>::value, "BinaryReader requires trivially copyable values");
+        std::vector<T> values(read_count(sizeof(T)));
+        if (!values.empty()) {
+            std::memcpy(values.data(), data_ + position_, values.size() * sizeof(T));
+            position_ += values.size() * sizeof(T);
+        }
+        return values;
+    }
+
+    std::size_t remaining() const { return size_ - position_; }
+    bool at_end() const { return position_ == size_; }
+
+private:
+    void require(std::size_t bytes) const {
+        if (bytes > size_ - position_) {
+            throw std::runtime_error("Snapshot truncated");
+        }
+    }
+
+    // 读取元素个数并确认后续数据足够
+    std::size_t read_count(std::size_t element_size) {
+        const std::uint64_t count = read<std::uint64_t>();
+        if (count > remaining() / element_size) {
+            throw std::runtime_error("Snapshot truncated");
+        }
+        return static_cast<std::size_t>(count);
+    }
+
+    const std::uint8_t* data_;
+    std::size_t size_;
+    std::size_t position_ = 0;
+};
+
+} // namespace utils
+} // namespace quant
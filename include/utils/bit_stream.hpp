@@ -0,0 +1,189 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_ARM64))
+#include <intrin.h>
+#define QUANT_BIT_SCAN64 1
+#endif
+
+namespace quant {
+namespace utils {
+
+// 最高位的1之上0的个数，value不能为0
+inline unsigned count_leading_zeros(std::uint64_t value) {
+#if defined(__GNUC__)
+    return static_cast<unsigned>(__builtin_clzll(value));
+#elif defined(QUANT_BIT_SCAN64)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return 63 - static_cast<unsigned>(index);
+#else
+    unsigned count = 0;
+    while (!(value & (std::uint64_t(1) << 63))) {
+        value <<= 1;
+        ++count;
+    }
+    return count;
+#endif
+}
+
+// 最低位的1之下0的个数，value不能为0
+inline unsigned count_trailing_zeros(std::uint64_t value) {
+#if defined(__GNUC__)
+    return static_cast<unsigned>(__builtin_ctzll(value));
+#elif defined(QUANT_BIT_SCAN64)
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return static_cast<unsigned>(index);
+#else
+    unsigned count = 0;
+    while (!(value & 1)) {
+        value >>= 1;
+        ++count;
+    }
+    return count;
+#endif
+}
+
+// 按位写入，高位在前
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<std::uint8_t>& out) : out_(out) {}
+
+    // 写入value的低bits位，bits取值[0, 64]
+    void write(std::uint64_t value, unsigned bits) {
+        if (bits == 0) {
+            return;
+        }
+        if (bits < 64) {
+            value &= (std::uint64_t(1) << bits) - 1;
+        }
+        unsigned free = 64 - used_;
+        if (bits < free) {
+            buffer_ |= value << (free - bits);
+            used_ += bits;
+        } else {
+            unsigned rest = bits - free;
+            buffer_ |= value >> rest;
+            flush_word();
+            if (rest > 0) {
+                buffer_ = value << (64 - rest);
+                used_ = rest;
+            }
+        }
+        bit_count_ += bits;
+    }
+
+    void write_bit(bool bit) { write(bit ? 1 : 0, 1); }
+
+    // 把未满一个字的剩余位按字节写出（末字节低位补零）
+    void flush() {
+        for (unsigned shift = 56; used_ > 0; shift -= 8) {
+            out_.push_back(static_cast<std::uint8_t>(buffer_ >> shift));
+            used_ = used_ > 8 ? used_ - 8 : 0;
+        }
+        buffer_ = 0;
+    }
+
+    std::uint64_t bit_count() const { return bit_count_; }
+
+private:
+    void flush_word() {
+        for (int shift = 56; shift >= 0; shift -= 8) {
+            out_.push_back(static_cast<std::uint8_t>(buffer_ >> shift));
+        }
+        buffer_ = 0;
+        used_ = 0;
+    }
+
+    std::vector<std::uint8_t>& out_;
+    std::uint64_t buffer_ = 0;
+    unsigned used_ = 0;
+    std::uint64_t bit_count_ = 0;
+};
+
+// 按位读取，与BitWriter配对
+//
+// 数据末尾之后至少有8字节可读时每次补充整字读取，否则逐字节读取；
+// 读到末尾之后返回0，不会越界访问。
+class BitReader {
+public:
+    BitReader(const std::uint8_t* data, std::size_t size) : data_(data), size_(size) {}
+
+    // 读取bits位，bits取值[0, 64]
+    std::uint64_t read(unsigned bits) {
+        if (bits == 0) {
+            return 0;
+        }
+        if (bits > 56) {
+            std::uint64_t high = read(bits - 32);
+            return (high << 32) | read(32);
+        }
+        if (available_ < bits) {
+            refill();
+        }
+        std::uint64_t value = buffer_ >> (64 - bits);
+        buffer_ <<= bits;
+        available_ -= bits;
+        return value;
+    }
+
+    bool read_bit() { return read(1) != 0; }
+
+    // 统计连续的1，最多max_ones个，遇到0时消耗该位
+    unsigned read_unary(unsigned max_ones) {
+        unsigned ones = 0;
+        while (ones < max_ones && read_bit()) {
+            ++ones;
+        }
+        return ones;
+    }
+
+private:
+    void refill() {
+        if (position_ + 8 <= size_) {
+            // 整字读取后只推进完整消耗的字节，多读的位在下次补充时以相同值重新或入
+            std::uint64_t word;
+            std::memcpy(&word, data_ + position_, sizeof(word));
+            word = to_big_endian(word);
+            buffer_ |= word >> available_;
+            unsigned bytes = (63 - available_) >> 3;
+            position_ += bytes;
+            available_ += bytes * 8;
+            return;
+        }
+        while (available_ <= 56) {
+            std::uint64_t byte = position_ < size_ ? data_[position_] : 0;
+            buffer_ |= byte << (56 - available_);
+            ++position_;
+            available_ += 8;
+        }
+    }
+
+    static std::uint64_t to_big_endian(std::uint64_t value) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        return value;
+#elif defined(__GNUC__)
+        return __builtin_bswap64(value);
+#else
+        std::uint64_t result = 0;
+        for (int i = 0; i < 8; ++i) {
+            result = (result << 8) | ((value >> (i * 8)) & 0xFF);
+        }
+        return result;
+#endif
+    }
+
+    const std::uint8_t* data_;
+    std::size_t size_;
+    std::size_t position_ = 0;
+    std::uint64_t buffer_ = 0;
+    unsigned available_ = 0;
+};
+
+} // namespace utils
+} // namespace quant
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "utils/binary_stream.hpp"
+#include <cmath>
+
+namespace quant {
+namespace utils {
+
+// Neumaier补偿求和
+//
+// 单独累计每次加法的舍入误差，滑动窗口反复加减时累计和不会随时间漂移。
+// 依赖严格的IEEE浮点语义，不能在-ffast-math下编译。
+class CompensatedSum {
+public:
+    void add(double value) {
+        double total = sum_ + value;
+        if (std::fabs(sum_) >= std::fabs(value)) {
+            compensation_ += (sum_ - total) + value;
+        } else {
+            compensation_ += (value - total) + sum_;
+        }
+        sum_ = total;
+    }
+
+    double value() const { return sum_ + compensation_; }
+
+    void reset() {
+        sum_ = 0.0;
+        compensation_ = 0.0;
+    }
+
+    void save_state(BinaryWriter& writer) const {
+        writer.write(sum_);
+        writer.write(compensation_);
+    }
+
+    void load_state(BinaryReader& reader) {
+        sum_ = reader.read<double>();
+        compensation_ = reader.read<double>();
+    }
+
+private:
+    double sum_ = 0.0;
+    double compensation_ = 0.0;
+};
+
+} // namespace utils
+} // namespace quant
@@ -0,0 +1,22 @@
+#pragma once
+
+namespace quant {
+namespace utils {
+
+// 把当前线程绑定到指定CPU核心，平台不支持或失败时返回false
+bool pin_current_thread(int cpu);
+
+// 可用的CPU核心数
+int cpu_count();
+
+// 自旋等待时的处理器提示，降低忙等对超线程兄弟核和功耗的影响
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+} // namespace utils
+} // namespace quant
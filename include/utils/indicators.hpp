@@ -1,5 +1,8 @@
 #pragma once
 
+#include "span.hpp"
+#include "compensated_sum.hpp"
+#include "indicators/moving_average.hpp"
 #include <vector>
 #include <deque>
 #include <numeric>
@@ -10,7 +13,7 @@
 namespace quant {
 namespace utils {
 
-// 简单移动平均线
+// 简单移动平均线：对序列末尾的窗口求均值，实现见indicators::SimpleMovingAverage
 class SMA {
 public:
     explicit SMA(size_t period) : period_(period) {
@@ -20,11 +23,7 @@ public:
     }
     
     double calculate(const std::vector<double>& data) const {
-        if (data.size() < period_) {
-            throw std::invalid_argument("Not enough data points");
-        }
-        
-        return std::accumulate(data.end() - period_, data.end(), 0.0) / period_;
+        return calculate(Span<const double>(data));
     }
     
     double calculate(const std::deque<double>& data) const {
@@ -32,7 +31,16 @@ public:
             throw std::invalid_argument("Not enough data points");
         }
         
-        return std::accumulate(data.end() - period_, data.end(), 0.0) / period_;
+        // 与window_mean相同的求和顺序，deque不连续，直接在迭代器上累加
+        CompensatedSum sum;
+        for (auto it = data.end() - period_; it != data.end(); ++it) {
+            sum.add(*it);
+        }
+        return sum.value() / static_cast<double>(period_);
+    }
+    
+    double calculate(Span<const double> data) const {
+        return indicators::SimpleMovingAverage::window_mean(data, period_);
     }
     
     void reset() {
@@ -43,24 +51,15 @@ private:
     size_t period_;
 };
 
-// 指数移动平均线
+// 指数移动平均线：递推由indicators::ExponentialMovingAverage完成，
+// 这里保留逐值和按序列计算的旧接口
 class EMA {
 public:
-    explicit EMA(size_t period) : period_(period), alpha_(2.0 / (period + 1)), initialized_(false) {
-        if (period == 0) {
-            throw std::invalid_argument("Period must be greater than 0");
-        }
-    }
+    explicit EMA(size_t period) : ema_(period) {}
     
     double calculate(double value) {
-        if (!initialized_) {
-            current_value_ = value;
-            initialized_ = true;
-        } else {
-            current_value_ = alpha_ * value + (1 - alpha_) * current_value_;
-        }
-        
-        return current_value_;
+        ema_.update(value);
+        return ema_.get_value();
     }
     
     double calculate(const std::vector<double>& data) {
@@ -68,36 +67,27 @@ public:
             throw std::invalid_argument("Data cannot be empty");
         }
         
-        if (!initialized_ && data.size() >= period_) {
-            // 使用SMA初始化
-            current_value_ = std::accumulate(data.begin(), data.begin() + period_, 0.0) / period_;
-            initialized_ = true;
-            
-            // 计算剩余数据的EMA
-            for (size_t i = period_; i < data.size(); ++i) {
-                current_value_ = alpha_ * data[i] + (1 - alpha_) * current_value_;
-            }
-        } else if (initialized_) {
+        Span<const double> values(data);
+        if (!ema_.is_valid() && data.size() >= ema_.period()) {
+            // 使用SMA初始化，再计算剩余数据的EMA
+            ema_.seed(indicators::SimpleMovingAverage::window_mean(values.first(ema_.period()), ema_.period()));
+            ema_.update(values.subspan(ema_.period(), values.size() - ema_.period()));
+        } else if (ema_.is_valid()) {
             // 继续计算EMA
-            for (double value : data) {
-                current_value_ = alpha_ * value + (1 - alpha_) * current_value_;
-            }
+            ema_.update(values);
         } else {
             throw std::invalid_argument("Not enough data points for initialization");
         }
         
-        return current_value_;
+        return ema_.get_value();
     }
     
     void reset() {
-        initialized_ = false;
+        ema_.reset();
     }
     
 private:
-    size_t period_;
-    double alpha_;
-    double current_value_ = 0.0;
-    bool initialized_;
+    indicators::ExponentialMovingAverage ema_;
 };
 
 // 相对强弱指标 (RSI)
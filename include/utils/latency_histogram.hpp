@@ -0,0 +1,47 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace quant {
+namespace utils {
+
+// 纳秒级延迟直方图
+//
+// 按2的幂分段、每段再线性细分16个桶，相对误差不超过1/16；
+// 记录为O(1)且不分配内存，可以放在行情回调的热路径上。单线程使用，跨线程汇总用merge。
+class LatencyHistogram {
+public:
+    void record(std::uint64_t nanoseconds);
+    void merge(const LatencyHistogram& other);
+    void reset();
+
+    std::uint64_t count() const { return count_; }
+    std::uint64_t min() const { return count_ ? min_ : 0; }
+    std::uint64_t max() const { return max_; }
+    double mean() const { return count_ ? static_cast<double>(sum_) / count_ : 0.0; }
+
+    // 分位数（0~100），返回所在桶的上界
+    std::uint64_t percentile(double percent) const;
+
+    // 形如"n=... mean=... p50=... p99=... p99.9=... max=..."的摘要（单位微秒）
+    std::string summary() const;
+
+private:
+    static constexpr unsigned kSubBucketBits = 4;
+    static constexpr unsigned kSubBuckets = 1u << kSubBucketBits;
+    static constexpr unsigned kBucketCount = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+    static unsigned bucket_index(std::uint64_t value);
+    static std::uint64_t bucket_upper_bound(unsigned index);
+
+    std::array<std::uint64_t, kBucketCount> buckets_{};
+    std::uint64_t count_ = 0;
+    std::uint64_t sum_ = 0;
+    std::uint64_t min_ = UINT64_MAX;
+    std::uint64_t max_ = 0;
+};
+
+} // namespace utils
+} // namespace quant
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+namespace quant {
+namespace utils {
+
+constexpr std::size_t kCacheLineSize = 64;
+
+inline std::size_t round_up_to_power_of_two(std::size_t value) {
+    std::size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+// 单生产者单消费者有界环形队列
+// 生产者和消费者各自缓存对方的下标，只有在缓存值不足时才读取对方的原子变量
+template <typename T>
+class SpscQueue {
+    static_assert(std::is_trivially_copyable<T>::value, "SpscQueue requires trivially copyable elements");
+
+public:
+    explicit SpscQueue(std::size_t capacity)
+        : mask_(round_up_to_power_of_two(capacity < 2 ? 2 : capacity) - 1),
+          buffer_(new T[mask_ + 1]) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // 仅由生产者线程调用，队列满时返回false
+    bool try_push(const T& value) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ > mask_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ > mask_) {
+                return false;
+            }
+        }
+        buffer_[tail & mask_] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 仅由消费者线程调用，队列空时返回false
+    bool try_pop(T& value) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) {
+                return false;
+            }
+        }
+        value = buffer_[head & mask_];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::size_t size_approx() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    std::size_t capacity() const { return mask_ + 1; }
+
+private:
+    const std::size_t mask_;
+    std::unique_ptr<T[]> buffer_;
+
+    alignas(kCacheLineSize) std::atomic<std::size_t> head_{0};  // 消费者写
+    std::size_t cached_tail_ = 0;                                 // 消费者缓存的tail
+
+    alignas(kCacheLineSize) std::atomic<std::size_t> tail_{0};  // 生产者写
+    std::size_t cached_head_ = 0;                                 // 生产者缓存的head
+};
+
+// 多生产者单消费者有界队列（Vyukov有界队列，每个槽位带序号）
+template <typename T>
+class MpscQueue {
+    static_assert(std::is_trivially_copyable<T>::value, "MpscQueue requires trivially copyable elements");
+
+public:
+    explicit MpscQueue(std::size_t capacity)
+        : mask_(round_up_to_power_of_two(capacity < 2 ? 2 : capacity) - 1),
+          cells_(new Cell[mask_ + 1]) {
+        for (std::size_t i = 0; i <= mask_; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // 可由任意线程调用，队列满时返回false
+    bool try_push(const T& value) {
+        std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells_[pos & mask_];
+            std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->data = value;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 仅由消费者线程调用，队列空时返回false
+    bool try_pop(T& value) {
+        Cell* cell = &cells_[dequeue_pos_ & mask_];
+        std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        if (sequence != dequeue_pos_ + 1) {
+            return false;
+        }
+        value = cell->data;
+        cell->sequence.store(dequeue_pos_ + mask_ + 1, std::memory_order_release);
+        ++dequeue_pos_;
+        return true;
+    }
+
+    std::size_t capacity() const { return mask_ + 1; }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        T data;
+    };
+
+    const std::size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+
+    alignas(kCacheLineSize) std::atomic<std::size_t> enqueue_pos_{0};
+    alignas(kCacheLineSize) std::size_t dequeue_pos_ = 0;
+};
+
+} // namespace utils
+} // namespace quant
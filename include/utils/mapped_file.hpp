@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace quant {
+namespace utils {
+
+// 只读内存映射文件
+// 数据按需由操作系统分页载入，常驻内存受页缓存约束
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    const char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    bool is_open() const { return data_ != nullptr; }
+    const std::string& path() const { return path_; }
+
+    // 提示操作系统即将顺序访问某段区域（可选优化）
+    void advise_sequential(std::size_t offset, std::size_t length) const;
+
+    void close();
+
+private:
+    std::string path_;
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+#ifdef _WIN32
+    void* file_handle_ = nullptr;
+    void* mapping_handle_ = nullptr;
+#endif
+};
+
+} // namespace utils
+} // namespace quant
@@ -0,0 +1,13 @@
+#pragma once
+
+// 热点循环的多版本编译
+//
+// 标注QUANT_MULTIVERSION的函数由编译器自动向量化；GCC在Linux上按运行时CPU支持生成多个版本
+// 并在加载时选择。关闭乘加融合，保证各版本之间、以及与逐个计算的结果逐位一致；不考虑浮点
+// 异常标志，编译器才能把分支转换为向量混合指令。
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__linux__)
+#define QUANT_MULTIVERSION \
+    __attribute__((target_clones("avx512f", "avx2", "default"), optimize("fp-contract=off", "no-trapping-math")))
+#else
+#define QUANT_MULTIVERSION
+#endif
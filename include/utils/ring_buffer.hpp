@@ -0,0 +1,102 @@
+#pragma once
+
+#include "utils/binary_stream.hpp"
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace quant {
+namespace utils {
+
+// 定长连续环形缓冲区
+//
+// 存储在构造时一次分配，之后的追加不再分配内存；写满后新元素覆盖最旧的元素。
+template <typename T>
+class RingBuffer {
+public:
+    explicit RingBuffer(std::size_t capacity) : data_(capacity) {
+        if (capacity == 0) {
+            throw std::invalid_argument("RingBuffer capacity must be greater than 0");
+        }
+    }
+
+    // 追加元素；缓冲区已满时覆盖最旧的元素，把它写入evicted并返回true
+    bool push(const T& value, T& evicted) {
+        const bool overwrite = size_ == data_.size();
+        if (overwrite) {
+            evicted = data_[next_];
+        } else {
+            ++size_;
+        }
+        data_[next_] = value;
+        if (++next_ == data_.size()) {
+            next_ = 0;
+        }
+        return overwrite;
+    }
+
+    void push(const T& value) {
+        T evicted;
+        push(value, evicted);
+    }
+
+    // 第index个元素，0为最旧
+    const T& operator[](std::size_t index) const {
+        std::size_t position = next_ + data_.size() - size_ + index;
+        if (position >= data_.size()) {
+            position -= data_.size();
+        }
+        return data_[position];
+    }
+
+    // 移除最旧 / 最新的元素，缓冲区不能为空
+    void pop_front() { --size_; }
+
+    void pop_back() {
+        next_ = next_ == 0 ? data_.size() - 1 : next_ - 1;
+        --size_;
+    }
+
+    const T& front() const { return (*this)[0]; }
+    const T& back() const { return data_[next_ == 0 ? data_.size() - 1 : next_ - 1]; }
+
+    std::size_t size() const { return size_; }
+    std::size_t capacity() const { return data_.size(); }
+    bool empty() const { return size_ == 0; }
+    bool full() const { return size_ == data_.size(); }
+
+    void clear() {
+        next_ = 0;
+        size_ = 0;
+    }
+
+    // 按从旧到新的顺序保存元素；恢复时容量须与保存时相同
+    void save_state(BinaryWriter& writer) const {
+        writer.write<std::uint64_t>(data_.size());
+        writer.write<std::uint64_t>(size_);
+        for (std::size_t i = 0; i < size_; ++i) {
+            writer.write((*this)[i]);
+        }
+    }
+
+    void load_state(BinaryReader& reader) {
+        reader.expect<std::uint64_t>(data_.size(), "RingBuffer capacity");
+        const std::uint64_t size = reader.read<std::uint64_t>();
+        if (size > data_.size()) {
+            throw std::runtime_error("Corrupted RingBuffer snapshot");
+        }
+        for (std::size_t i = 0; i < size; ++i) {
+            data_[i] = reader.read<T>();
+        }
+        size_ = static_cast<std::size_t>(size);
+        next_ = size_ == data_.size() ? 0 : size_;
+    }
+
+private:
+    std::vector<T> data_;
+    std::size_t next_ = 0;  // 下一个写入位置
+    std::size_t size_ = 0;
+};
+
+} // namespace utils
+} // namespace quant
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace quant {
+namespace utils {
+
+// 固定大小的线程池
+//
+// 析构时先丢弃尚未到期的延迟任务，再执行完队列中剩余的任务后退出；
+// 任务内部可以继续向线程池提交任务。
+class ThreadPool {
+public:
+    // threads为0时使用硬件并发数
+    explicit ThreadPool(std::size_t threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // 提交任务，返回结果的future
+    template <typename F>
+    auto submit(F&& task) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+        using Result = std::invoke_result_t<std::decay_t<F>>;
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        auto future = packaged->get_future();
+        post([packaged]() { (*packaged)(); });
+        return future;
+    }
+
+    // 提交不关心结果的任务
+    void post(std::function<void()> task);
+
+    // 延迟delay后再提交任务
+    void post_after(std::chrono::steady_clock::duration delay, std::function<void()> task);
+
+    // 对[0, count)中的每个下标调用body并等待全部完成。每个工作线程一个任务，循环领取下一个
+    // 下标，适合大量耗时不均的小任务；body抛出的第一个异常在全部任务结束后重新抛出。
+    // 不能在本线程池的任务中调用
+    void parallel_for(std::size_t count, const std::function<void(std::size_t)>& body);
+
+    std::size_t size() const { return workers_.size(); }
+
+private:
+    struct DelayedTask {
+        std::chrono::steady_clock::time_point deadline;
+        std::uint64_t sequence;
+        std::function<void()> task;
+
+        bool operator>(const DelayedTask& other) const {
+            return deadline > other.deadline ||
+                   (deadline == other.deadline && sequence > other.sequence);
+        }
+    };
+
+    void worker_loop();
+    void timer_loop();
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> tasks_;
+    bool stopping_ = false;
+    std::vector<std::thread> workers_;
+
+    std::mutex timer_mutex_;
+    std::condition_variable timer_cv_;
+    std::priority_queue<DelayedTask, std::vector<DelayedTask>, std::greater<DelayedTask>> delayed_;
+    std::uint64_t delayed_sequence_ = 0;
+    bool timer_stopping_ = false;
+    std::thread timer_;  // 首次使用post_after时启动
+};
+
+} // namespace utils
+} // namespace quant
@@ -1,101 +1,197 @@
 #include "analysis/performance.hpp"
 #include <algorithm>
-#include <numeric>
 #include <cmath>
 #include <chrono>
 
 namespace quant {
 namespace analysis {
 
-PerformanceReport calculate_performance(
-    const std::vector<std::pair<data::Timestamp, double>>& equity_curve,
-    const std::vector<execution::Order>& orders,
-    double initial_capital) {
-    
-    PerformanceReport report;
-    
-    if (equity_curve.empty()) {
-        return report;
+void EquityStatistics::apply(PerformanceReport& report, double initial_capital) const {
+    if (count_ == 0) {
+        return;
     }
-    
+
     // 计算总回报率
-    double final_equity = equity_curve.back().second;
-    report.total_return = (final_equity - initial_capital) / initial_capital;
-    
+    report.total_return = (last_equity_ - initial_capital) / initial_capital;
+
     // 计算年化回报率
-    auto start_time = equity_curve.front().first;
-    auto end_time = equity_curve.back().first;
-    double duration_seconds = difftime(end_time, start_time);
+    double duration_seconds = difftime(last_time_, first_time_);
     double years = duration_seconds / (365.25 * 24 * 60 * 60);
     if (years > 0) {
         report.annualized_return = std::pow(1 + report.total_return, 1 / years) - 1;
     }
-    
-    // 计算最大回撤
-    report.max_drawdown = calculate_max_drawdown(equity_curve);
-    
-    // 计算波动率
-    report.volatility = calculate_volatility(equity_curve);
-    
-    // 计算夏普比率
-    report.sharpe_ratio = calculate_sharpe_ratio(equity_curve);
-    
-    // 计算交易统计
-    report.total_trades = orders.size();
-    
-    double total_profit = 0.0;
-    double total_loss = 0.0;
-    report.largest_profit = 0.0;
-    report.largest_loss = 0.0;
-    
-    for (size_t i = 0; i < orders.size(); i += 2) {
-        if (i + 1 >= orders.size()) {
-            break;  // 忽略未平仓的交易
-        }
-        
-        const auto& entry = orders[i];
-        const auto& exit = orders[i + 1];
-        
-        double entry_value = entry.quantity * entry.price;
-        double exit_value = exit.quantity * exit.price;
-        
-        double profit = 0.0;
-        if (entry.side == execution::OrderSide::BUY) {
-            profit = exit_value - entry_value;
-        } else {
-            profit = entry_value - exit_value;
-        }
-        
-        if (profit > 0) {
-            report.winning_trades++;
-            total_profit += profit;
-            report.largest_profit = std::max(report.largest_profit, profit);
-        } else {
-            report.losing_trades++;
-            total_loss += std::abs(profit);
-            report.largest_loss = std::max(report.largest_loss, std::abs(profit));
+
+    report.max_drawdown = max_drawdown_;
+
+    // 波动率与夏普比率使用同一组收益率，与calculate_volatility、calculate_sharpe_ratio结果逐位一致
+    if (return_count_ > 0) {
+        double std_dev = return_std_dev();
+        report.volatility = std_dev * std::sqrt(252);
+        if (std_dev != 0.0) {
+            report.sharpe_ratio = mean_return() / std_dev;
         }
     }
-    
+}
+
+void EquityStatistics::save_state(utils::BinaryWriter& writer) const {
+    writer.write(count_);
+    writer.write<std::int64_t>(first_time_);
+    writer.write<std::int64_t>(last_time_);
+    writer.write(last_equity_);
+    writer.write(peak_);
+    writer.write(max_drawdown_);
+    writer.write(return_count_);
+    writer.write(sum_returns_);
+    writer.write(running_mean_);
+    writer.write(squared_deviations_);
+}
+
+void EquityStatistics::load_state(utils::BinaryReader& reader) {
+    count_ = reader.read<std::uint64_t>();
+    first_time_ = static_cast<data::Timestamp>(reader.read<std::int64_t>());
+    last_time_ = static_cast<data::Timestamp>(reader.read<std::int64_t>());
+    last_equity_ = reader.read<double>();
+    peak_ = reader.read<double>();
+    max_drawdown_ = reader.read<double>();
+    return_count_ = reader.read<std::uint64_t>();
+    sum_returns_ = reader.read<double>();
+    running_mean_ = reader.read<double>();
+    squared_deviations_ = reader.read<double>();
+}
+
+void TradeStatistics::add(const execution::Order& order) {
+    ++order_count_;
+    double value = order.quantity * order.price;
+    if (!has_entry_) {
+        has_entry_ = true;
+        entry_side_ = order.side;
+        entry_value_ = value;
+        return;
+    }
+    has_entry_ = false;
+
+    double profit = 0.0;
+    if (entry_side_ == execution::OrderSide::BUY) {
+        profit = value - entry_value_;
+    } else {
+        profit = entry_value_ - value;
+    }
+
+    if (profit > 0) {
+        winning_trades_++;
+        total_profit_ += profit;
+        largest_profit_ = std::max(largest_profit_, profit);
+    } else {
+        losing_trades_++;
+        total_loss_ += std::abs(profit);
+        largest_loss_ = std::max(largest_loss_, std::abs(profit));
+    }
+}
+
+void TradeStatistics::apply(PerformanceReport& report) const {
+    report.total_trades = order_count_;
+    report.winning_trades = winning_trades_;
+    report.losing_trades = losing_trades_;
+    report.largest_profit = largest_profit_;
+    report.largest_loss = largest_loss_;
+
     // 计算胜率
     if (report.total_trades > 0) {
         report.win_rate = static_cast<double>(report.winning_trades) / report.total_trades;
     }
-    
+
     // 计算盈亏比
-    if (report.losing_trades > 0 && total_loss > 0) {
-        report.profit_factor = total_profit / total_loss;
+    if (report.losing_trades > 0 && total_loss_ > 0) {
+        report.profit_factor = total_profit_ / total_loss_;
     }
-    
+
     // 计算平均盈利和亏损
     if (report.winning_trades > 0) {
-        report.average_profit = total_profit / report.winning_trades;
+        report.average_profit = total_profit_ / report.winning_trades;
     }
-    
+
     if (report.losing_trades > 0) {
-        report.average_loss = total_loss / report.losing_trades;
+        report.average_loss = total_loss_ / report.losing_trades;
     }
+}
+
+void TradeStatistics::save_state(utils::BinaryWriter& writer) const {
+    writer.write<std::int32_t>(order_count_);
+    writer.write_bool(has_entry_);
+    writer.write<std::uint8_t>(static_cast<std::uint8_t>(entry_side_));
+    writer.write(entry_value_);
+    writer.write<std::int32_t>(winning_trades_);
+    writer.write<std::int32_t>(losing_trades_);
+    writer.write(total_profit_);
+    writer.write(total_loss_);
+    writer.write(largest_profit_);
+    writer.write(largest_loss_);
+}
+
+void TradeStatistics::load_state(utils::BinaryReader& reader) {
+    order_count_ = reader.read<std::int32_t>();
+    has_entry_ = reader.read_bool();
+    entry_side_ = static_cast<execution::OrderSide>(reader.read<std::uint8_t>());
+    entry_value_ = reader.read<double>();
+    winning_trades_ = reader.read<std::int32_t>();
+    losing_trades_ = reader.read<std::int32_t>();
+    total_profit_ = reader.read<double>();
+    total_loss_ = reader.read<double>();
+    largest_profit_ = reader.read<double>();
+    largest_loss_ = reader.read<double>();
+}
+
+PerformanceReport calculate_performance(
+    const std::vector<std::pair<data::Timestamp, double>>& equity_curve,
+    const std::vector<execution::Order>& orders,
+    double initial_capital) {
     
+    std::vector<data::Timestamp> timestamps(equity_curve.size());
+    std::vector<double> equity(equity_curve.size());
+    for (size_t i = 0; i < equity_curve.size(); ++i) {
+        timestamps[i] = equity_curve[i].first;
+        equity[i] = equity_curve[i].second;
+    }
+    return calculate_performance(timestamps, equity, orders, initial_capital);
+}
+
+PerformanceReport calculate_performance(
+    utils::Span<const data::Timestamp> timestamps,
+    utils::Span<const double> equity,
+    const std::vector<execution::Order>& orders,
+    double initial_capital) {
+
+    TradeStatistics trades;
+    for (const auto& order : orders) {
+        trades.add(order);
+    }
+    return calculate_performance(timestamps, equity, trades, initial_capital);
+}
+
+PerformanceReport calculate_performance(
+    utils::Span<const data::Timestamp> timestamps,
+    utils::Span<const double> equity,
+    const TradeStatistics& trades,
+    double initial_capital) {
+
+    EquityStatistics statistics;
+    for (size_t i = 0; i < equity.size(); ++i) {
+        statistics.add(timestamps[i], equity[i]);
+    }
+    return calculate_performance(statistics, trades, initial_capital);
+}
+
+PerformanceReport calculate_performance(
+    const EquityStatistics& equity,
+    const TradeStatistics& trades,
+    double initial_capital) {
+
+    PerformanceReport report;
+    if (equity.empty()) {
+        return report;
+    }
+    equity.apply(report, initial_capital);
+    trades.apply(report);
     return report;
 }
 
@@ -148,84 +244,33 @@ double calculate_sharpe_ratio(
     const std::vector<std::pair<data::Timestamp, double>>& equity_curve,
     double risk_free_rate) {
     
-    if (equity_curve.size() < 2) {
-        return 0.0;
-    }
-    
-    // 计算每日回报率
-    std::vector<double> returns;
-    for (size_t i = 1; i < equity_curve.size(); ++i) {
-        double prev_equity = equity_curve[i - 1].second;
-        double curr_equity = equity_curve[i].second;
-        
-        if (prev_equity > 0) {
-            double daily_return = (curr_equity - prev_equity) / prev_equity;
-            returns.push_back(daily_return);
-        }
+    EquityStatistics statistics;
+    for (const auto& [timestamp, equity] : equity_curve) {
+        statistics.add(timestamp, equity);
     }
-    
-    if (returns.empty()) {
+    if (statistics.return_count() == 0) {
         return 0.0;
     }
     
-    // 计算平均回报率
-    double mean_return = std::accumulate(returns.begin(), returns.end(), 0.0) / returns.size();
-    
-    // 计算回报率标准差
-    double sum_squared_diff = 0.0;
-    for (double r : returns) {
-        double diff = r - mean_return;
-        sum_squared_diff += diff * diff;
-    }
-    
-    double std_dev = std::sqrt(sum_squared_diff / returns.size());
-    
+    double std_dev = statistics.return_std_dev();
     if (std_dev == 0.0) {
         return 0.0;
     }
     
     // 计算夏普比率
-    return (mean_return - risk_free_rate) / std_dev;
+    return (statistics.mean_return() - risk_free_rate) / std_dev;
 }
 
 double calculate_volatility(
     const std::vector<std::pair<data::Timestamp, double>>& equity_curve) {
     
-    if (equity_curve.size() < 2) {
-        return 0.0;
-    }
-    
-    // 计算每日回报率
-    std::vector<double> returns;
-    for (size_t i = 1; i < equity_curve.size(); ++i) {
-        double prev_equity = equity_curve[i - 1].second;
-        double curr_equity = equity_curve[i].second;
-        
-        if (prev_equity > 0) {
-            double daily_return = (curr_equity - prev_equity) / prev_equity;
-            returns.push_back(daily_return);
-        }
-    }
-    
-    if (returns.empty()) {
-        return 0.0;
-    }
-    
-    // 计算平均回报率
-    double mean_return = std::accumulate(returns.begin(), returns.end(), 0.0) / returns.size();
-    
-    // 计算回报率标准差
-    double sum_squared_diff = 0.0;
-    for (double r : returns) {
-        double diff = r - mean_return;
-        sum_squared_diff += diff * diff;
+    EquityStatistics statistics;
+    for (const auto& [timestamp, equity] : equity_curve) {
+        statistics.add(timestamp, equity);
     }
     
-    double variance = sum_squared_diff / returns.size();
-    double std_dev = std::sqrt(variance);
-    
     // 年化波动率（假设交易日为252天）
-    return std_dev * std::sqrt(252);
+    return statistics.return_std_dev() * std::sqrt(252);
 }
 
 } // namespace analysis
@@ -1,12 +1,108 @@
 #include "backtest/backtest_engine.hpp"
 #include <algorithm>
+#include <array>
+#include <cstdio>
+#include <fstream>
 #include <stdexcept>
 #include <iostream>
 #include <cmath>
+#include <limits>
 
 namespace quant {
 namespace backtest {
 
+namespace {
+
+constexpr std::array<char, 8> kCheckpointMagic = {'Q', 'F', 'C', 'K', 'P', 'T', '0', '1'};
+constexpr std::uint32_t kCheckpointVersion = 2;
+constexpr std::array<char, 8> kHistoryMagic = {'Q', 'F', 'H', 'I', 'S', 'T', '0', '1'};
+
+std::vector<std::uint8_t> read_file(const std::string& path, const char* what) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        throw std::runtime_error(std::string("Cannot open ") + what + ": " + path);
+    }
+    std::vector<std::uint8_t> bytes(static_cast<std::size_t>(in.tellg()));
+    in.seekg(0);
+    if (!in.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()))) {
+        throw std::runtime_error(std::string("Failed to read ") + what + ": " + path);
+    }
+    return bytes;
+}
+
+// 影响回测结果的配置项。结束时间与分块大小不影响已处理部分，续跑时允许改变
+void write_config(utils::BinaryWriter& writer, const BacktestConfig& config) {
+    writer.write(config.initial_capital);
+    writer.write(config.commission_rate);
+    writer.write_bool(config.use_fractional_shares);
+    writer.write<std::int64_t>(config.start_time);
+    writer.write<std::int64_t>(config.warmup_duration);
+    writer.write_string(config.timeframe);
+    writer.write<std::uint64_t>(config.symbols.size());
+    for (const auto& symbol : config.symbols) {
+        writer.write_string(symbol);
+    }
+}
+
+void check_config(utils::BinaryReader& reader, const BacktestConfig& config) {
+    reader.expect(config.initial_capital, "Initial capital");
+    reader.expect(config.commission_rate, "Commission rate");
+    reader.expect<std::uint8_t>(config.use_fractional_shares ? 1 : 0, "Fractional shares setting");
+    reader.expect<std::int64_t>(config.start_time, "Start time");
+    reader.expect<std::int64_t>(config.warmup_duration, "Warmup duration");
+    if (reader.read_string() != config.timeframe) {
+        throw std::runtime_error("Timeframe does not match snapshot");
+    }
+    reader.expect<std::uint64_t>(config.symbols.size(), "Symbol count");
+    for (const auto& symbol : config.symbols) {
+        if (reader.read_string() != symbol) {
+            throw std::runtime_error("Symbols do not match snapshot");
+        }
+    }
+}
+
+} // namespace
+
+std::vector<std::unique_ptr<data::BarChunkSource>> make_chunk_sources(
+    const std::shared_ptr<data::DataFeed>& data_feed,
+    const BacktestConfig& config) {
+    std::vector<std::unique_ptr<data::BarChunkSource>> sources;
+    sources.reserve(config.symbols.size());
+    for (const auto& symbol : config.symbols) {
+        sources.push_back(std::make_unique<data::DataFeedChunkSource>(
+            data_feed,
+            symbol,
+            config.start_time,
+            config.end_time,
+            config.timeframe,
+            config.chunk_duration));
+    }
+    return sources;
+}
+
+std::vector<std::unique_ptr<data::BarChunkSource>> make_warmup_sources(
+    const std::shared_ptr<data::DataFeed>& data_feed,
+    const BacktestConfig& config) {
+    if (config.warmup_duration <= 0) {
+        return {};
+    }
+    BacktestConfig warmup = config;
+    warmup.start_time = config.start_time - config.warmup_duration;
+    warmup.end_time = config.start_time - 1;
+    return make_chunk_sources(data_feed, warmup);
+}
+
+BacktestHistory load_history(const std::string& path) {
+    std::vector<std::uint8_t> bytes = read_file(path, "history");
+    utils::BinaryReader reader(bytes);
+    if (bytes.size() < kHistoryMagic.size() || reader.read<std::array<char, 8>>() != kHistoryMagic) {
+        throw std::runtime_error("Not a backtest history: " + path);
+    }
+    BacktestHistory history;
+    Portfolio::read_history(reader, history);
+    return history;
+}
+
 BacktestEngine::BacktestEngine(
     std::shared_ptr<data::DataFeed> data_feed,
     std::shared_ptr<strategy::Strategy> strategy,
@@ -14,8 +110,7 @@ BacktestEngine::BacktestEngine(
     : data_feed_(std::move(data_feed)),
       strategy_(std::move(strategy)),
       config_(std::move(config)),
-      cash_(config.initial_capital),
-      equity_(config.initial_capital) {
+      portfolio_(config_.initial_capital, config_.commission_rate, config_.use_fractional_shares) {
     
     if (!data_feed_) {
         throw std::invalid_argument("Data feed cannot be null");
@@ -26,131 +121,228 @@ BacktestEngine::BacktestEngine(
 }
 
 void BacktestEngine::run() {
-    // 初始化策略
-    strategy_->initialize();
+    if (strategy_->supports_batch() && config_.symbols.size() == 1) {
+        prepare_strategy();
+        run_batch();
+        complete();
+    } else {
+        start();
+        run_until(std::numeric_limits<data::Timestamp>::max());
+        finish();
+    }
+}
+
+void BacktestEngine::start() {
+    if (stream_) {
+        throw std::logic_error("Backtest already started");
+    }
     
-    // 获取所有交易品种的历史数据
-    // 这里简化为只处理一个品种
-    std::string symbol = "BTCUSDT";  // 示例
+    prepare_strategy();
     
-    auto bars = data_feed_->get_historical_bars(
-        symbol,
-        config_.start_time,
-        config_.end_time,
-        "1d"  // 日线数据
-    );
+    // 按全局时间顺序归并所有品种的数据
+    stream_ = std::make_unique<data::MergedBarStream>(make_chunk_sources(data_feed_, data_config()));
+}
+
+bool BacktestEngine::run_until(data::Timestamp time) {
+    if (!stream_) {
+        throw std::logic_error("Backtest not started");
+    }
     
-    // 按时间排序
-    std::sort(bars.begin(), bars.end(), [](const auto& a, const auto& b) {
-        return a.timestamp < b.timestamp;
-    });
+    data::BarData bar;
+    while (!stream_->empty() && stream_->peek_timestamp() <= time) {
+        stream_->next(bar);
+        process_bar(bar);
+    }
+    return !stream_->empty();
+}
+
+void BacktestEngine::finish() {
+    if (!stream_) {
+        throw std::logic_error("Backtest not started");
+    }
+    stream_.reset();
+    complete();
+}
+
+analysis::PerformanceReport BacktestEngine::current_report() const {
+    return portfolio_.report(config_.initial_capital);
+}
+
+std::vector<std::uint8_t> BacktestEngine::checkpoint() const {
+    if (!strategy_->supports_checkpoint()) {
+        throw std::logic_error("Strategy does not support checkpoints: " + strategy_->name());
+    }
     
-    // 遍历每个时间点的数据
-    for (const auto& bar : bars) {
-        // 将K线数据转换为MarketData
-        data::MarketData market_data = bar;
-        
-        // 调用策略处理数据
-        auto signal = strategy_->on_data(market_data);
-        
-        // 处理信号
-        if (signal) {
-            process_signal(*signal, bar);
+    std::vector<std::uint8_t> snapshot;
+    utils::BinaryWriter writer(snapshot);
+    writer.write(kCheckpointMagic);
+    writer.write(kCheckpointVersion);
+    write_config(writer, config_);
+    writer.write_string(strategy_->name());
+    writer.write(bars_processed_);
+    portfolio_.save_state(writer);
+    
+    // 策略状态带长度前缀，恢复时可以核对策略恰好读完自己的部分
+    std::vector<std::uint8_t> strategy_state;
+    utils::BinaryWriter strategy_writer(strategy_state);
+    strategy_->save_state(strategy_writer);
+    writer.write_vector(strategy_state);
+    return snapshot;
+}
+
+void BacktestEngine::save_checkpoint(const std::string& path) const {
+    std::vector<std::uint8_t> snapshot = checkpoint();
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Cannot create checkpoint: " + path);
         }
-        
-        // 更新投资组合
-        update_portfolio(bar);
-        
-        // 记录资金曲线
-        equity_curve_.emplace_back(bar.timestamp, equity_);
+        out.write(reinterpret_cast<const char*>(snapshot.data()), static_cast<std::streamsize>(snapshot.size()));
+        out.close();
+        if (!out) {
+            std::remove(temporary.c_str());
+            throw std::runtime_error("Failed to write checkpoint: " + path);
+        }
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        throw std::runtime_error("Failed to write checkpoint: " + path);
+    }
+}
+
+void BacktestEngine::restore(const std::vector<std::uint8_t>& snapshot) {
+    if (stream_ || restored_ || bars_processed_ > 0 || portfolio_.has_bar()) {
+        throw std::logic_error("Backtest already started");
     }
+    if (!strategy_->supports_checkpoint()) {
+        throw std::logic_error("Strategy does not support checkpoints: " + strategy_->name());
+    }
+    
+    utils::BinaryReader reader(snapshot);
+    if (snapshot.size() < kCheckpointMagic.size() || reader.read<std::array<char, 8>>() != kCheckpointMagic) {
+        throw std::runtime_error("Not a backtest checkpoint");
+    }
+    if (reader.read<std::uint32_t>() != kCheckpointVersion) {
+        throw std::runtime_error("Unsupported checkpoint version");
+    }
+    check_config(reader, config_);
+    if (reader.read_string() != strategy_->name()) {
+        throw std::runtime_error("Strategy does not match snapshot: " + strategy_->name());
+    }
+    bars_processed_ = reader.read<std::uint64_t>();
+    portfolio_.load_state(reader);
+    
+    std::vector<std::uint8_t> strategy_state = reader.read_vector<std::uint8_t>();
+    utils::BinaryReader strategy_reader(strategy_state);
+    strategy_->load_state(strategy_reader);
+    if (!strategy_reader.at_end() || !reader.at_end()) {
+        throw std::runtime_error("Corrupted checkpoint");
+    }
+    restored_ = true;
+}
+
+void BacktestEngine::load_checkpoint(const std::string& path) {
+    restore(read_file(path, "checkpoint"));
+}
+
+void BacktestEngine::append_history(const std::string& path) {
+    std::vector<std::uint8_t> bytes;
+    utils::BinaryWriter writer(bytes);
+    std::ofstream out(path, std::ios::binary | std::ios::app);
+    if (!out) {
+        throw std::runtime_error("Cannot open history: " + path);
+    }
+    out.seekp(0, std::ios::end);
+    if (out.tellp() == 0) {
+        writer.write(kHistoryMagic);
+    }
+    portfolio_.append_history(writer);
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    out.close();
+    if (!out) {
+        throw std::runtime_error("Failed to write history: " + path);
+    }
+}
+
+BacktestConfig BacktestEngine::data_config() const {
+    BacktestConfig config = config_;
+    if (restored_ && portfolio_.has_bar()) {
+        config.start_time = std::max(config.start_time, portfolio_.current_time() + 1);
+    }
+    return config;
+}
+
+void BacktestEngine::prepare_strategy() {
+    // 策略状态已从检查点恢复
+    if (restored_) {
+        return;
+    }
+    
+    // 初始化策略
+    strategy_->initialize();
+    
+    // 预热区间的K线按时间顺序送给策略，产生的信号丢弃
+    data::MergedBarStream stream(make_warmup_sources(data_feed_, config_));
+    data::BarData bar;
+    while (stream.next(bar)) {
+        strategy_->on_data(bar);
+    }
+}
+
+void BacktestEngine::process_bar(const data::BarData& bar) {
+    // 同一时间点的所有品种处理完后记录一次资金曲线
+    portfolio_.begin_bar(bar.timestamp);
+    
+    // 调用策略处理数据
+    auto signal = strategy_->on_data(bar);
+    
+    // 处理信号
+    if (signal) {
+        process_signal(*signal, bar);
+    }
+    
+    // 更新投资组合
+    portfolio_.mark(bar.symbol, bar.close);
+    ++bars_processed_;
+}
+
+void BacktestEngine::complete() {
+    portfolio_.finish();
     
     // 计算性能指标
-    performance_report_ = analysis::calculate_performance(
-        equity_curve_,
-        order_history_,
-        config_.initial_capital
-    );
+    performance_report_ = portfolio_.report(config_.initial_capital);
 }
 
-void BacktestEngine::process_signal(const strategy::Signal& signal, const data::BarData& bar) {
-    if (signal.type == strategy::SignalType::BUY) {
-        // 计算可用资金的90%用于买入
-        double amount_to_invest = cash_ * 0.9;
-        double price = bar.close;
-        double quantity = amount_to_invest / price;
-        
-        if (!config_.use_fractional_shares) {
-            quantity = std::floor(quantity);
-        }
-        
-        if (quantity <= 0) {
-            return;  // 资金不足
-        }
-        
-        // 创建订单
-        execution::Order order;
-        order.symbol = signal.symbol;
-        order.timestamp = signal.timestamp;
-        order.type = execution::OrderType::MARKET;
-        order.side = execution::OrderSide::BUY;
-        order.quantity = quantity;
-        order.price = price;
-        order.status = execution::OrderStatus::FILLED;
-        
-        // 计算手续费
-        double commission = amount_to_invest * config_.commission_rate;
-        
-        // 更新现金和持仓
-        cash_ -= (quantity * price + commission);
-        positions_[signal.symbol] += quantity;
-        
-        // 记录订单
-        order_history_.push_back(order);
+void BacktestEngine::run_batch() {
+    // 单品种不需要归并，整块交给策略，再按K线顺序撮合信号、更新组合
+    auto sources = make_chunk_sources(data_feed_, data_config());
+    strategy::SignalBuffer signals;
+    
+    for (auto chunk = sources.front()->next_chunk(); !chunk.empty(); chunk = sources.front()->next_chunk()) {
+        const data::BarSeriesView& bars = chunk.view();
+        signals.clear();
+        strategy_->on_data_batch(bars, signals);
         
-    } else if (signal.type == strategy::SignalType::SELL) {
-        // 获取当前持仓
-        auto it = positions_.find(signal.symbol);
-        if (it == positions_.end() || it->second <= 0) {
-            return;  // 没有持仓
+        auto closes = bars.close();
+        std::size_t next_signal = 0;
+        for (std::size_t i = 0; i < bars.size(); ++i) {
+            const double close = closes[i];
+            portfolio_.begin_bar(bars.timestamp_at(i));
+            
+            for (; next_signal < signals.size() && signals[next_signal].index <= i; ++next_signal) {
+                const auto& signal = signals[next_signal];
+                portfolio_.execute(signal.type, signal.symbol, signal.timestamp, close);
+            }
+            
+            portfolio_.mark(bars.symbol(), close);
         }
-        
-        double quantity = it->second;
-        double price = bar.close;
-        
-        // 创建订单
-        execution::Order order;
-        order.symbol = signal.symbol;
-        order.timestamp = signal.timestamp;
-        order.type = execution::OrderType::MARKET;
-        order.side = execution::OrderSide::SELL;
-        order.quantity = quantity;
-        order.price = price;
-        order.status = execution::OrderStatus::FILLED;
-        
-        // 计算手续费
-        double commission = quantity * price * config_.commission_rate;
-        
-        // 更新现金和持仓
-        cash_ += (quantity * price - commission);
-        positions_[signal.symbol] = 0;
-        
-        // 记录订单
-        order_history_.push_back(order);
+        bars_processed_ += bars.size();
     }
 }
 
-void BacktestEngine::update_portfolio(const data::BarData& bar) {
-    // 计算当前持仓市值
-    double position_value = 0.0;
-    for (const auto& [symbol, quantity] : positions_) {
-        if (symbol == bar.symbol) {
-            position_value += quantity * bar.close;
-        }
-    }
-    
-    // 更新总资产
-    equity_ = cash_ + position_value;
+void BacktestEngine::process_signal(const strategy::Signal& signal, const data::BarData& bar) {
+    portfolio_.execute(signal.type, signal.symbol, signal.timestamp, bar.close);
 }
 
 analysis::PerformanceReport BacktestEngine::get_performance_report() const {
@@ -158,11 +350,15 @@ analysis::PerformanceReport BacktestEngine::get_performance_report() const {
 }
 
 const std::vector<execution::Order>& BacktestEngine::get_order_history() const {
-    return order_history_;
+    return portfolio_.order_history();
 }
 
 const std::vector<std::pair<data::Timestamp, double>>& BacktestEngine::get_equity_curve() const {
-    return equity_curve_;
+    return portfolio_.equity_curve();
+}
+
+double BacktestEngine::get_position(data::SymbolId symbol) const {
+    return portfolio_.position(symbol);
 }
 
 } // namespace backtest
@@ -0,0 +1,302 @@
+#include "backtest/parameter_sweep.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace quant {
+namespace backtest {
+
+// ---------------------------------------------------------------------------
+// ParameterSet / ParameterGrid
+// ---------------------------------------------------------------------------
+
+void ParameterSet::set(const std::string& name, double value) {
+    for (auto& entry : values_) {
+        if (entry.first == name) {
+            entry.second = value;
+            return;
+        }
+    }
+    values_.emplace_back(name, value);
+}
+
+double ParameterSet::get(const std::string& name) const {
+    for (const auto& entry : values_) {
+        if (entry.first == name) {
+            return entry.second;
+        }
+    }
+    throw std::out_of_range("Unknown parameter: " + name);
+}
+
+int ParameterSet::get_int(const std::string& name) const {
+    return static_cast<int>(std::lround(get(name)));
+}
+
+bool ParameterSet::contains(const std::string& name) const {
+    for (const auto& entry : values_) {
+        if (entry.first == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string ParameterSet::to_string() const {
+    std::ostringstream out;
+    for (std::size_t i = 0; i < values_.size(); ++i) {
+        if (i > 0) {
+            out << ',';
+        }
+        out << values_[i].first << '=' << values_[i].second;
+    }
+    return out.str();
+}
+
+ParameterGrid& ParameterGrid::add(const std::string& name, std::vector<double> values) {
+    if (values.empty()) {
+        throw std::invalid_argument("Parameter has no values: " + name);
+    }
+    for (const auto& axis : axes_) {
+        if (axis.first == name) {
+            throw std::invalid_argument("Duplicate parameter: " + name);
+        }
+    }
+    axes_.emplace_back(name, std::move(values));
+    return *this;
+}
+
+ParameterGrid& ParameterGrid::add_range(const std::string& name, double first, double last, double step) {
+    if (!(step > 0.0) || last < first) {
+        throw std::invalid_argument("Invalid parameter range: " + name);
+    }
+    // 按下标计算每个取值，避免累加误差；容差保证last本身被包含
+    std::size_t count = static_cast<std::size_t>(std::floor((last - first) / step + 1e-9)) + 1;
+    std::vector<double> values(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        values[i] = first + static_cast<double>(i) * step;
+    }
+    return add(name, std::move(values));
+}
+
+ParameterGrid& ParameterGrid::where(std::function<bool(const ParameterSet&)> constraint) {
+    constraints_.push_back(std::move(constraint));
+    return *this;
+}
+
+std::size_t ParameterGrid::cartesian_size() const {
+    if (axes_.empty()) {
+        return 0;
+    }
+    std::size_t size = 1;
+    for (const auto& axis : axes_) {
+        size *= axis.second.size();
+    }
+    return size;
+}
+
+std::vector<ParameterSet> ParameterGrid::combinations() const {
+    std::vector<ParameterSet> result;
+    const std::size_t total = cartesian_size();
+    if (total == 0) {
+        return result;
+    }
+
+    std::vector<std::size_t> digits(axes_.size(), 0);
+    for (std::size_t n = 0; n < total; ++n) {
+        ParameterSet parameters;
+        for (std::size_t a = 0; a < axes_.size(); ++a) {
+            parameters.set(axes_[a].first, axes_[a].second[digits[a]]);
+        }
+        bool accepted = std::all_of(constraints_.begin(), constraints_.end(),
+                                    [&parameters](const auto& constraint) { return constraint(parameters); });
+        if (accepted) {
+            result.push_back(std::move(parameters));
+        }
+
+        // 按混合进制递增，最后一个参数变化最快
+        for (std::size_t a = axes_.size(); a-- > 0;) {
+            if (++digits[a] < axes_[a].second.size()) {
+                break;
+            }
+            digits[a] = 0;
+        }
+    }
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// SweepResults
+// ---------------------------------------------------------------------------
+
+double result_metric(const SweepResult& result, const std::string& metric) {
+    const auto& report = result.report;
+    if (metric == "total_return") return report.total_return;
+    if (metric == "annualized_return") return report.annualized_return;
+    if (metric == "sharpe_ratio") return report.sharpe_ratio;
+    if (metric == "max_drawdown") return report.max_drawdown;
+    if (metric == "volatility") return report.volatility;
+    if (metric == "total_trades") return report.total_trades;
+    if (metric == "win_rate") return report.win_rate;
+    if (metric == "profit_factor") return report.profit_factor;
+    if (metric == "final_equity") return result.final_equity;
+    auto it = report.metrics.find(metric);
+    if (it != report.metrics.end()) {
+        return it->second;
+    }
+    throw std::invalid_argument("Unknown metric: " + metric);
+}
+
+std::size_t SweepResults::failures() const {
+    return static_cast<std::size_t>(std::count_if(rows_.begin(), rows_.end(),
+                                                  [](const SweepResult& row) { return !row.ok(); }));
+}
+
+void SweepResults::sort_by(const std::string& metric, bool descending) {
+    std::stable_sort(rows_.begin(), rows_.end(), [&](const SweepResult& a, const SweepResult& b) {
+        if (a.ok() != b.ok()) {
+            return a.ok();
+        }
+        if (!a.ok()) {
+            return false;
+        }
+        double x = result_metric(a, metric);
+        double y = result_metric(b, metric);
+        return descending ? x > y : x < y;
+    });
+}
+
+const SweepResult& SweepResults::best(const std::string& metric, bool maximize) const {
+    const SweepResult* best = nullptr;
+    double best_value = 0.0;
+    for (const auto& row : rows_) {
+        if (!row.ok()) {
+            continue;
+        }
+        double value = result_metric(row, metric);
+        if (!best || (maximize ? value > best_value : value < best_value)) {
+            best = &row;
+            best_value = value;
+        }
+    }
+    if (!best) {
+        throw std::runtime_error("No successful sweep results");
+    }
+    return *best;
+}
+
+void SweepResults::write_csv(std::ostream& out) const {
+    static const char* const kColumns[] = {
+        "total_return", "annualized_return", "sharpe_ratio", "max_drawdown",
+        "volatility", "total_trades", "win_rate", "profit_factor", "final_equity"};
+
+    if (rows_.empty()) {
+        return;
+    }
+    const auto& names = rows_.front().parameters.values();
+    for (const auto& entry : names) {
+        out << entry.first << ',';
+    }
+    for (const char* column : kColumns) {
+        out << column << ',';
+    }
+    out << "error\n";
+
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision(10);
+    for (const auto& row : rows_) {
+        for (const auto& entry : row.parameters.values()) {
+            out << entry.second << ',';
+        }
+        for (const char* column : kColumns) {
+            if (row.ok()) {
+                out << result_metric(row, column);
+            }
+            out << ',';
+        }
+        // 错误信息中的引号和逗号按CSV规则转义
+        if (!row.ok()) {
+            out << '"';
+            for (char c : row.error) {
+                out << c;
+                if (c == '"') {
+                    out << '"';
+                }
+            }
+            out << '"';
+        }
+        out << '\n';
+    }
+    out.precision(precision);
+    out.flags(flags);
+}
+
+// ---------------------------------------------------------------------------
+// 共享数据
+// ---------------------------------------------------------------------------
+
+std::shared_ptr<data::SeriesDataFeed> load_backtest_data(data::DataFeed& data_feed, const BacktestConfig& config) {
+    return data::SeriesDataFeed::load(
+        data_feed, config.symbols, config.start_time - config.warmup_duration, config.end_time, config.timeframe);
+}
+
+BacktestConfig shared_data_config(const std::shared_ptr<data::SeriesDataFeed>& data, BacktestConfig config) {
+    if (!data) {
+        throw std::invalid_argument("Data feed cannot be null");
+    }
+    // 数据已在内存中，每个引擎一次取出整个区间的切片
+    config.chunk_duration = 0;
+    return config;
+}
+
+// ---------------------------------------------------------------------------
+// ParameterSweep
+// ---------------------------------------------------------------------------
+
+ParameterSweep::ParameterSweep(data::DataFeed& data_feed, BacktestConfig config, std::size_t threads)
+    : ParameterSweep(load_backtest_data(data_feed, config), config, threads) {}
+
+ParameterSweep::ParameterSweep(
+    std::shared_ptr<data::SeriesDataFeed> data,
+    BacktestConfig config,
+    std::size_t threads)
+    : data_(std::move(data)),
+      config_(shared_data_config(data_, std::move(config))),
+      pool_(threads) {}
+
+SweepResults ParameterSweep::run(const ParameterGrid& grid, const StrategyBuilder& builder) {
+    return run(grid.combinations(), builder);
+}
+
+SweepResults ParameterSweep::run(const std::vector<ParameterSet>& parameters, const StrategyBuilder& builder) {
+    if (!builder) {
+        throw std::invalid_argument("Strategy builder cannot be empty");
+    }
+
+    std::vector<SweepResult> rows(parameters.size());
+    pool_.parallel_for(parameters.size(), [&](std::size_t i) {
+        rows[i] = run_one(parameters[i], builder);
+    });
+    return SweepResults(std::move(rows));
+}
+
+SweepResult ParameterSweep::run_one(const ParameterSet& parameters, const StrategyBuilder& builder) const {
+    SweepResult result;
+    result.parameters = parameters;
+    try {
+        BacktestEngine engine(data_, builder(parameters), config_);
+        engine.run();
+        result.report = engine.get_performance_report();
+        result.order_count = engine.get_order_history().size();
+        const auto& curve = engine.get_equity_curve();
+        result.final_equity = curve.empty() ? config_.initial_capital : curve.back().second;
+    } catch (const std::exception& e) {
+        result.error = e.what();
+    }
+    return result;
+}
+
+} // namespace backtest
+} // namespace quant
@@ -0,0 +1,268 @@
+#include "backtest/portfolio.hpp"
+#include "data/symbol_table.hpp"
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+namespace quant {
+namespace backtest {
+
+namespace {
+
+void write_order(utils::BinaryWriter& writer, const execution::Order& order) {
+    writer.write_string(order.id);
+    writer.write_string(data::symbol_name(order.symbol));
+    writer.write<std::int64_t>(order.timestamp);
+    writer.write<std::uint8_t>(static_cast<std::uint8_t>(order.type));
+    writer.write<std::uint8_t>(static_cast<std::uint8_t>(order.side));
+    writer.write(order.quantity);
+    writer.write(order.price);
+    writer.write(order.filled_quantity);
+    writer.write(order.average_price);
+    writer.write<std::uint8_t>(static_cast<std::uint8_t>(order.status));
+    std::map<std::string, std::string> metadata(order.metadata.begin(), order.metadata.end());
+    writer.write<std::uint64_t>(metadata.size());
+    for (const auto& [key, value] : metadata) {
+        writer.write_string(key);
+        writer.write_string(value);
+    }
+}
+
+execution::Order read_order(utils::BinaryReader& reader) {
+    execution::Order order;
+    order.id = reader.read_string();
+    order.symbol = data::intern_symbol(reader.read_string());
+    order.timestamp = static_cast<data::Timestamp>(reader.read<std::int64_t>());
+    order.type = static_cast<execution::OrderType>(reader.read<std::uint8_t>());
+    order.side = static_cast<execution::OrderSide>(reader.read<std::uint8_t>());
+    order.quantity = reader.read<double>();
+    order.price = reader.read<double>();
+    order.filled_quantity = reader.read<double>();
+    order.average_price = reader.read<double>();
+    order.status = static_cast<execution::OrderStatus>(reader.read<std::uint8_t>());
+    const std::uint64_t entries = reader.read<std::uint64_t>();
+    for (std::uint64_t e = 0; e < entries; ++e) {
+        std::string key = reader.read_string();
+        order.metadata[std::move(key)] = reader.read_string();
+    }
+    return order;
+}
+
+// pair含填充字节，逐个字段写出
+void write_point(utils::BinaryWriter& writer, const std::pair<data::Timestamp, double>& point) {
+    writer.write<std::int64_t>(point.first);
+    writer.write(point.second);
+}
+
+std::pair<data::Timestamp, double> read_point(utils::BinaryReader& reader) {
+    data::Timestamp time = static_cast<data::Timestamp>(reader.read<std::int64_t>());
+    return {time, reader.read<double>()};
+}
+
+} // namespace
+
+Portfolio::Portfolio(double initial_capital, double commission_rate, bool use_fractional_shares)
+    : commission_rate_(commission_rate),
+      use_fractional_shares_(use_fractional_shares),
+      cash_(initial_capital),
+      equity_(initial_capital) {}
+
+void Portfolio::execute(
+    strategy::SignalType type,
+    data::SymbolId symbol,
+    data::Timestamp timestamp,
+    double price) {
+    if (type == strategy::SignalType::BUY) {
+        // 计算可用资金的90%用于买入
+        double amount_to_invest = cash_ * 0.9;
+        double quantity = amount_to_invest / price;
+
+        if (!use_fractional_shares_) {
+            quantity = std::floor(quantity);
+        }
+
+        if (quantity <= 0) {
+            return;  // 资金不足
+        }
+
+        // 创建订单
+        execution::Order order;
+        order.symbol = symbol;
+        order.timestamp = timestamp;
+        order.type = execution::OrderType::MARKET;
+        order.side = execution::OrderSide::BUY;
+        order.quantity = quantity;
+        order.price = price;
+        order.status = execution::OrderStatus::FILLED;
+
+        // 计算手续费
+        double commission = amount_to_invest * commission_rate_;
+
+        // 更新现金和持仓
+        ensure_symbol_slot(symbol);
+        cash_ -= (quantity * price + commission);
+        positions_[symbol] += quantity;
+        market_value_ += quantity * last_prices_[symbol];
+
+        // 记录订单
+        trade_statistics_.add(order);
+        order_history_.push_back(order);
+
+    } else if (type == strategy::SignalType::SELL) {
+        // 获取当前持仓
+        if (symbol >= positions_.size() || positions_[symbol] <= 0) {
+            return;  // 没有持仓
+        }
+
+        double quantity = positions_[symbol];
+
+        // 创建订单
+        execution::Order order;
+        order.symbol = symbol;
+        order.timestamp = timestamp;
+        order.type = execution::OrderType::MARKET;
+        order.side = execution::OrderSide::SELL;
+        order.quantity = quantity;
+        order.price = price;
+        order.status = execution::OrderStatus::FILLED;
+
+        // 计算手续费
+        double commission = quantity * price * commission_rate_;
+
+        // 更新现金和持仓
+        cash_ += (quantity * price - commission);
+        positions_[symbol] = 0;
+        market_value_ -= quantity * last_prices_[symbol];
+
+        // 记录订单
+        trade_statistics_.add(order);
+        order_history_.push_back(order);
+    }
+}
+
+analysis::PerformanceReport Portfolio::report(double initial_capital) const {
+    analysis::EquityStatistics equity = equity_statistics_;
+    if (has_bar_) {
+        equity.add(current_time_, equity_);
+    }
+    return analysis::calculate_performance(equity, trade_statistics_, initial_capital);
+}
+
+void Portfolio::save_state(utils::BinaryWriter& writer) const {
+    writer.write(cash_);
+    writer.write(equity_);
+    writer.write(market_value_);
+    writer.write_bool(has_bar_);
+    writer.write<std::int64_t>(current_time_);
+
+    // 持仓与最新价格按品种名称排序写出，相同状态在任何进程中写出相同的字节
+    std::map<std::string, data::SymbolId> symbols;
+    for (data::SymbolId id = 0; id < positions_.size(); ++id) {
+        if (positions_[id] != 0.0 || last_prices_[id] != 0.0) {
+            symbols.emplace(data::symbol_name(id), id);
+        }
+    }
+    writer.write<std::uint64_t>(symbols.size());
+    for (const auto& [name, id] : symbols) {
+        writer.write_string(name);
+        writer.write(positions_[id]);
+        writer.write(last_prices_[id]);
+    }
+
+    equity_statistics_.save_state(writer);
+    trade_statistics_.save_state(writer);
+
+    // finish()追加的最后一个点不计入，恢复后继续处理新K线时由begin_bar照常记录
+    writer.write<std::uint64_t>(orders_before_ + order_history_.size());
+    writer.write<std::uint64_t>(points_before_ + equity_curve_.size() - (finished_ ? 1 : 0));
+    writer.write(orders_written_);
+    writer.write(points_written_);
+}
+
+void Portfolio::load_state(utils::BinaryReader& reader) {
+    cash_ = reader.read<double>();
+    equity_ = reader.read<double>();
+    market_value_ = reader.read<double>();
+    has_bar_ = reader.read_bool();
+    current_time_ = static_cast<data::Timestamp>(reader.read<std::int64_t>());
+    finished_ = false;
+
+    positions_.clear();
+    last_prices_.clear();
+    const std::uint64_t symbols = reader.read<std::uint64_t>();
+    for (std::uint64_t i = 0; i < symbols; ++i) {
+        data::SymbolId id = data::intern_symbol(reader.read_string());
+        ensure_symbol_slot(id);
+        positions_[id] = reader.read<double>();
+        last_prices_[id] = reader.read<double>();
+    }
+
+    equity_statistics_.load_state(reader);
+    trade_statistics_.load_state(reader);
+
+    order_history_.clear();
+    equity_curve_.clear();
+    orders_before_ = reader.read<std::uint64_t>();
+    points_before_ = reader.read<std::uint64_t>();
+    orders_written_ = reader.read<std::uint64_t>();
+    points_written_ = reader.read<std::uint64_t>();
+}
+
+void Portfolio::append_history(utils::BinaryWriter& writer) {
+    if (orders_written_ < orders_before_ || points_written_ < points_before_) {
+        throw std::logic_error("History before the checkpoint was not written");
+    }
+
+    const std::size_t first_order = static_cast<std::size_t>(orders_written_ - orders_before_);
+    writer.write<std::uint64_t>(order_history_.size() - first_order);
+    for (std::size_t i = first_order; i < order_history_.size(); ++i) {
+        write_order(writer, order_history_[i]);
+    }
+
+    // 当前时间点单独写出：之后若继续处理新K线，它会作为下一段的第一个点再次写出
+    const std::size_t first_point = static_cast<std::size_t>(points_written_ - points_before_);
+    const std::size_t points = equity_curve_.size() - (finished_ ? 1 : 0);
+    writer.write<std::uint64_t>(points - first_point);
+    for (std::size_t i = first_point; i < points; ++i) {
+        write_point(writer, equity_curve_[i]);
+    }
+    writer.write_bool(has_bar_);
+    if (has_bar_) {
+        write_point(writer, {current_time_, equity_});
+    }
+
+    orders_written_ = orders_before_ + order_history_.size();
+    points_written_ = points_before_ + points;
+}
+
+void Portfolio::read_history(utils::BinaryReader& reader, BacktestHistory& history) {
+    bool has_current = false;
+    std::pair<data::Timestamp, double> current;
+    while (!reader.at_end()) {
+        const std::uint64_t orders = reader.read<std::uint64_t>();
+        for (std::uint64_t i = 0; i < orders; ++i) {
+            history.orders.push_back(read_order(reader));
+        }
+        const std::uint64_t points = reader.read<std::uint64_t>();
+        // 每个点占16字节，先核对剩余长度，避免损坏的文件触发巨大的分配
+        if (points > reader.remaining() / 16) {
+            throw std::runtime_error("History truncated");
+        }
+        for (std::uint64_t i = 0; i < points; ++i) {
+            history.equity_curve.push_back(read_point(reader));
+        }
+        // 上一段的当前时间点已作为本段的第一个点写出，只保留最后一段的当前时间点
+        has_current = reader.read_bool();
+        if (has_current) {
+            current = read_point(reader);
+        }
+    }
+    if (has_current) {
+        history.equity_curve.push_back(current);
+    }
+}
+
+} // namespace backtest
+} // namespace quant
@@ -0,0 +1,219 @@
+#include "backtest/successive_halving.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace quant {
+namespace backtest {
+
+namespace {
+
+// 存活的候选及其引擎
+struct Candidate {
+    SweepResult result;
+    std::unique_ptr<BacktestEngine> engine;
+    double score = 0.0;
+    std::uint64_t bars_counted = 0;  // 已计入统计的K线数
+};
+
+HalvingOptions check_options(HalvingOptions options) {
+    if (!(options.eta > 1.0)) {
+        throw std::invalid_argument("Halving eta must be greater than 1");
+    }
+    if (options.min_survivors == 0) {
+        throw std::invalid_argument("Halving must keep at least one survivor");
+    }
+    if (!(options.min_fraction > 0.0) || options.min_fraction > 1.0) {
+        throw std::invalid_argument("Halving min_fraction must be in (0, 1]");
+    }
+    double previous = 0.0;
+    for (double fraction : options.fractions) {
+        if (!(fraction > previous) || fraction > 1.0) {
+            throw std::invalid_argument("Halving fractions must be ascending within (0, 1]");
+        }
+        previous = fraction;
+    }
+    // 提前检查指标名称
+    result_metric(SweepResult(), options.metric);
+    return options;
+}
+
+} // namespace
+
+const SweepResult& HalvingResult::best() const {
+    if (finalists.empty()) {
+        throw std::runtime_error("No candidate completed the backtest");
+    }
+    return finalists[0];
+}
+
+SuccessiveHalving::SuccessiveHalving(
+    data::DataFeed& data_feed,
+    BacktestConfig config,
+    HalvingOptions options,
+    std::size_t threads)
+    : SuccessiveHalving(
+          load_backtest_data(data_feed, config),
+          config,
+          std::move(options),
+          threads) {}
+
+SuccessiveHalving::SuccessiveHalving(
+    std::shared_ptr<data::SeriesDataFeed> data,
+    BacktestConfig config,
+    HalvingOptions options,
+    std::size_t threads)
+    : data_(std::move(data)),
+      config_(shared_data_config(data_, std::move(config))),
+      options_(check_options(std::move(options))),
+      pool_(threads) {}
+
+std::vector<double> SuccessiveHalving::round_fractions(std::size_t candidates) const {
+    std::vector<double> fractions = options_.fractions;
+    if (!fractions.empty()) {
+        if (fractions.back() < 1.0) {
+            fractions.push_back(1.0);
+        }
+        return fractions;
+    }
+
+    // 按eta淘汰到min_survivors所需的轮数，再受第一轮最短区间限制
+    const double log_eta = std::log(options_.eta);
+    std::size_t by_candidates = 1;
+    if (candidates > options_.min_survivors) {
+        double ratio = static_cast<double>(candidates) / static_cast<double>(options_.min_survivors);
+        by_candidates += static_cast<std::size_t>(std::ceil(std::log(ratio) / log_eta - 1e-9));
+    }
+    std::size_t by_fraction = 1 + static_cast<std::size_t>(std::floor(-std::log(options_.min_fraction) / log_eta + 1e-9));
+    std::size_t rounds = std::min(by_candidates, by_fraction);
+
+    for (std::size_t k = 0; k < rounds; ++k) {
+        fractions.push_back(std::pow(options_.eta, static_cast<double>(k) - static_cast<double>(rounds - 1)));
+    }
+    fractions.back() = 1.0;
+    return fractions;
+}
+
+HalvingResult SuccessiveHalving::run(const ParameterGrid& grid, const StrategyBuilder& builder) {
+    return run(grid.combinations(), builder);
+}
+
+HalvingResult SuccessiveHalving::run(const std::vector<ParameterSet>& parameters, const StrategyBuilder& builder) {
+    if (!builder) {
+        throw std::invalid_argument("Strategy builder cannot be empty");
+    }
+
+    // 回测区间内实际有数据的时间跨度，各轮截止时间按它划分
+    data::Timestamp first = std::numeric_limits<data::Timestamp>::max();
+    data::Timestamp last = std::numeric_limits<data::Timestamp>::min();
+    std::uint64_t total_bars = 0;
+    for (const auto& symbol : config_.symbols) {
+        auto series = data_->series(symbol).range(config_.start_time, config_.end_time);
+        if (!series.empty()) {
+            first = std::min(first, series.timestamps()[0]);
+            last = std::max(last, series.timestamps()[series.size() - 1]);
+            total_bars += series.size();
+        }
+    }
+    if (total_bars == 0) {
+        throw std::runtime_error("No data in backtest range");
+    }
+
+    HalvingResult result;
+    result.exhaustive_bars = total_bars * parameters.size();
+
+    std::vector<Candidate> alive(parameters.size());
+    for (std::size_t i = 0; i < parameters.size(); ++i) {
+        alive[i].result.parameters = parameters[i];
+    }
+    std::vector<SweepResult> eliminated;
+
+    const std::vector<double> fractions = round_fractions(parameters.size());
+    const double span = static_cast<double>(last - first);
+    for (std::size_t round = 0; round < fractions.size() && !alive.empty(); ++round) {
+        const bool final_round = round + 1 == fractions.size();
+        const data::Timestamp end_time =
+            final_round ? last : first + static_cast<data::Timestamp>(std::floor(span * fractions[round]));
+
+        // 各候选从上一轮停下的位置继续推进到本轮截止时间
+        pool_.parallel_for(alive.size(), [&](std::size_t i) {
+            Candidate& candidate = alive[i];
+            try {
+                if (!candidate.engine) {
+                    candidate.engine = std::make_unique<BacktestEngine>(
+                        data_, builder(candidate.result.parameters), config_);
+                    candidate.engine->start();
+                }
+                BacktestEngine& engine = *candidate.engine;
+                engine.run_until(end_time);
+                if (final_round) {
+                    engine.finish();
+                    candidate.result.report = engine.get_performance_report();
+                } else {
+                    candidate.result.report = engine.current_report();
+                }
+                candidate.result.final_equity = engine.get_equity();
+                candidate.result.order_count = engine.get_order_history().size();
+                candidate.score = result_metric(candidate.result, options_.metric);
+                // NaN视为最差
+                if (std::isnan(candidate.score)) {
+                    candidate.score = options_.maximize ? -std::numeric_limits<double>::infinity()
+                                                        : std::numeric_limits<double>::infinity();
+                }
+            } catch (const std::exception& e) {
+                candidate.result.error = e.what();
+            }
+        });
+
+        HalvingRound stats;
+        stats.end_time = end_time;
+        stats.fraction = fractions[round];
+        stats.candidates = alive.size();
+
+        // 失败的候选直接淘汰，其余按指标排序，相同时保持输入顺序
+        std::vector<Candidate> ranked;
+        ranked.reserve(alive.size());
+        for (auto& candidate : alive) {
+            if (candidate.engine) {
+                result.bars_processed += candidate.engine->bars_processed() - candidate.bars_counted;
+                candidate.bars_counted = candidate.engine->bars_processed();
+            }
+            if (candidate.result.ok()) {
+                ranked.push_back(std::move(candidate));
+            } else {
+                eliminated.push_back(std::move(candidate.result));
+            }
+        }
+        const bool maximize = options_.maximize;
+        std::stable_sort(ranked.begin(), ranked.end(), [maximize](const Candidate& a, const Candidate& b) {
+            return maximize ? a.score > b.score : a.score < b.score;
+        });
+
+        std::size_t keep = ranked.size();
+        if (!final_round) {
+            keep = static_cast<std::size_t>(std::ceil(static_cast<double>(ranked.size()) / options_.eta));
+            keep = std::min(ranked.size(), std::max(keep, options_.min_survivors));
+        }
+        for (std::size_t i = keep; i < ranked.size(); ++i) {
+            eliminated.push_back(std::move(ranked[i].result));
+        }
+        ranked.resize(keep);
+
+        stats.survivors = ranked.size();
+        result.rounds.push_back(stats);
+        alive = std::move(ranked);
+    }
+
+    std::vector<SweepResult> finalists;
+    finalists.reserve(alive.size());
+    for (auto& candidate : alive) {
+        finalists.push_back(std::move(candidate.result));
+    }
+    result.finalists = SweepResults(std::move(finalists));
+    result.eliminated = SweepResults(std::move(eliminated));
+    return result;
+}
+
+} // namespace backtest
+} // namespace quant
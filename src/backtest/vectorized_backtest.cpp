@@ -0,0 +1,361 @@
+#include "backtest/vectorized_backtest.hpp"
+#include "utils/bit_stream.hpp"
+#include "utils/multiversion.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+namespace quant {
+namespace backtest {
+
+namespace {
+
+// 一个品种在时间轴下标[begin, end)内持有quantity
+struct Holding {
+    std::size_t column;
+    std::size_t begin;
+    std::size_t end;
+    double quantity;
+};
+
+// 从时间轴下标index起现金为cash
+struct CashPoint {
+    std::size_t index;
+    double cash;
+};
+
+// 每个品种的结算状态
+struct ColumnState {
+    std::vector<std::size_t> events;  // 需要结算的K线下标
+    std::size_t next_event = 0;
+    double position = 0.0;
+    std::size_t holding_begin = 0;    // 当前持仓从时间轴哪个下标开始
+    bool aligned = false;             // K线时间戳与时间轴完全相同
+};
+
+QUANT_MULTIVERSION
+void fill_cash(double* equity, std::size_t count, double cash) {
+    for (std::size_t i = 0; i < count; ++i) {
+        equity[i] = cash;
+    }
+}
+
+QUANT_MULTIVERSION
+void add_position_value(double* equity, const double* prices, std::size_t count, double quantity) {
+    for (std::size_t i = 0; i < count; ++i) {
+        equity[i] += quantity * prices[i];
+    }
+}
+
+// 64个信号中非零信号的位图，NaN视为无信号
+QUANT_MULTIVERSION
+std::uint64_t signal_mask(const double* signals, std::size_t count) {
+    std::uint64_t mask = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        mask |= static_cast<std::uint64_t>(signals[i] > 0.0 || signals[i] < 0.0) << i;
+    }
+    return mask;
+}
+
+// 资金曲线之和，四路累加打断依赖链
+double sum_equity(const double* equity, std::size_t count) {
+    double sums[4] = {0.0, 0.0, 0.0, 0.0};
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        sums[0] += equity[i];
+        sums[1] += equity[i + 1];
+        sums[2] += equity[i + 2];
+        sums[3] += equity[i + 3];
+    }
+    for (; i < count; ++i) {
+        sums[0] += equity[i];
+    }
+    return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+}
+
+// 信号列中需要结算的位置：信号模式下为非零信号，目标仓位模式下为目标值发生变化处
+std::vector<std::size_t> find_events(utils::Span<const double> signals, SignalMode mode) {
+    std::vector<std::size_t> events;
+    if (mode == SignalMode::SIGNALS) {
+        // 每64个信号算出一个位图，再逐个取出置位的下标
+        for (std::size_t begin = 0; begin < signals.size(); begin += 64) {
+            std::uint64_t mask = signal_mask(signals.data() + begin, std::min<std::size_t>(64, signals.size() - begin));
+            for (; mask != 0; mask &= mask - 1) {
+                events.push_back(begin + utils::count_trailing_zeros(mask));
+            }
+        }
+    } else {
+        double target = 0.0;
+        for (std::size_t i = 0; i < signals.size(); ++i) {
+            if (signals[i] == signals[i] && signals[i] != target) {
+                target = signals[i];
+                events.push_back(i);
+            }
+        }
+    }
+    return events;
+}
+
+// 所有品种时间戳的并集
+void merge_timestamps(const std::vector<SignalColumn>& columns, std::vector<data::Timestamp>& timestamps) {
+    timestamps.clear();
+    if (columns.size() == 1) {
+        auto source = columns.front().bars.timestamps();
+        timestamps.assign(source.begin(), source.end());
+        return;
+    }
+    std::vector<std::size_t> cursors(columns.size(), 0);
+    for (;;) {
+        bool remaining = false;
+        data::Timestamp earliest = std::numeric_limits<data::Timestamp>::max();
+        for (std::size_t k = 0; k < columns.size(); ++k) {
+            if (cursors[k] < columns[k].bars.size()) {
+                remaining = true;
+                earliest = std::min(earliest, columns[k].bars.timestamp_at(cursors[k]));
+            }
+        }
+        if (!remaining) {
+            break;
+        }
+        timestamps.push_back(earliest);
+        for (std::size_t k = 0; k < columns.size(); ++k) {
+            if (cursors[k] < columns[k].bars.size() && columns[k].bars.timestamp_at(cursors[k]) == earliest) {
+                ++cursors[k];
+            }
+        }
+    }
+}
+
+// 时间轴与品种K线不一致时，逐个时间点取该品种不晚于它的最新收盘价
+void add_position_value_filled(
+    double* equity,
+    const std::vector<data::Timestamp>& timestamps,
+    const data::BarSeriesView& bars,
+    const Holding& holding) {
+    auto closes = bars.close();
+    std::size_t j = bars.upper_bound(timestamps[holding.begin]) - 1;
+    for (std::size_t g = holding.begin; g < holding.end; ++g) {
+        while (j + 1 < bars.size() && bars.timestamp_at(j + 1) <= timestamps[g]) {
+            ++j;
+        }
+        equity[g] += holding.quantity * closes[j];
+    }
+}
+
+} // namespace
+
+std::vector<std::pair<data::Timestamp, double>> VectorizedResult::equity_curve() const {
+    std::vector<std::pair<data::Timestamp, double>> curve;
+    curve.reserve(timestamps.size());
+    for (std::size_t i = 0; i < timestamps.size(); ++i) {
+        curve.emplace_back(timestamps[i], equity[i]);
+    }
+    return curve;
+}
+
+VectorizedBacktest::VectorizedBacktest(BacktestConfig config, SignalMode mode)
+    : config_(std::move(config)), mode_(mode) {}
+
+VectorizedResult VectorizedBacktest::run(data::DataFeed& data_feed, strategy::VectorizedStrategy& strategy) const {
+    std::vector<data::BarSeries> series;
+    std::vector<std::vector<double>> signals;
+    series.reserve(config_.symbols.size());
+    signals.reserve(config_.symbols.size());
+
+    std::vector<SignalColumn> columns;
+    for (const auto& symbol : config_.symbols) {
+        series.push_back(data_feed.get_bar_series(
+            symbol, config_.start_time - config_.warmup_duration, config_.end_time, config_.timeframe));
+        const data::BarSeriesView& bars = series.back().view();
+        signals.emplace_back(bars.size(), 0.0);
+        strategy.generate(bars, signals.back());
+
+        // 预热区间只用于计算指标
+        const std::size_t first = bars.lower_bound(config_.start_time);
+        columns.push_back({
+            bars.slice(first, bars.size()),
+            utils::Span<const double>(signals.back()).subspan(first, bars.size() - first)});
+    }
+    return run(columns);
+}
+
+VectorizedResult VectorizedBacktest::run(const data::BarSeriesView& bars, utils::Span<const double> signals) const {
+    return run(std::vector<SignalColumn>{{bars, signals}});
+}
+
+VectorizedResult VectorizedBacktest::run(const std::vector<SignalColumn>& columns) const {
+    VectorizedResult result;
+    run(columns, result);
+    return result;
+}
+
+void VectorizedBacktest::run(const std::vector<SignalColumn>& columns, VectorizedResult& result) const {
+    for (const auto& column : columns) {
+        if (column.signals.size() != column.bars.size()) {
+            throw std::invalid_argument("Signal column size does not match bar count");
+        }
+    }
+
+    merge_timestamps(columns, result.timestamps);
+    result.orders.clear();
+    result.commission = 0.0;
+    result.turnover = 0.0;
+    const auto& timestamps = result.timestamps;
+    const std::size_t count = timestamps.size();
+
+    std::vector<ColumnState> states(columns.size());
+    std::size_t events = 0;
+    for (std::size_t s = 0; s < columns.size(); ++s) {
+        states[s].events = find_events(columns[s].signals, mode_);
+        states[s].aligned = columns[s].bars.size() == count;
+        events += states[s].events.size();
+    }
+    result.orders.reserve(events);
+
+    // 按(时间戳, 品种顺序)依次结算信号，只访问有信号的K线
+    double cash = config_.initial_capital;
+    std::vector<CashPoint> cash_points{{0, cash}};
+    std::vector<Holding> holdings;
+    double notional = 0.0;
+
+    auto change_position = [&](std::size_t s, std::size_t index, double quantity) {
+        ColumnState& state = states[s];
+        if (state.position != 0.0 && state.holding_begin < index) {
+            holdings.push_back({s, state.holding_begin, index, state.position});
+        }
+        state.position = quantity;
+        state.holding_begin = index;
+        if (cash_points.back().index == index) {
+            cash_points.back().cash = cash;
+        } else {
+            cash_points.push_back({index, cash});
+        }
+    };
+
+    auto record_order = [&](std::size_t s, std::size_t i, execution::OrderSide side, double quantity, double price) {
+        execution::Order order;
+        order.symbol = columns[s].bars.symbol();
+        order.timestamp = columns[s].bars.timestamp_at(i);
+        order.type = execution::OrderType::MARKET;
+        order.side = side;
+        order.quantity = quantity;
+        order.price = price;
+        order.status = execution::OrderStatus::FILLED;
+        result.orders.push_back(std::move(order));
+    };
+
+    for (;;) {
+        // 下一个结算的品种：时间戳最早，相同时取靠前的品种
+        std::size_t s = columns.size();
+        data::Timestamp earliest = std::numeric_limits<data::Timestamp>::max();
+        for (std::size_t k = 0; k < columns.size(); ++k) {
+            const ColumnState& state = states[k];
+            if (state.next_event < state.events.size()) {
+                const data::Timestamp t = columns[k].bars.timestamp_at(state.events[state.next_event]);
+                if (s == columns.size() || t < earliest) {
+                    s = k;
+                    earliest = t;
+                }
+            }
+        }
+        if (s == columns.size()) {
+            break;
+        }
+
+        ColumnState& state = states[s];
+        const std::size_t i = state.events[state.next_event++];
+        const double price = columns[s].bars.close()[i];
+        const double signal = columns[s].signals[i];
+        const std::size_t index = state.aligned
+            ? i
+            : static_cast<std::size_t>(std::lower_bound(timestamps.begin(), timestamps.end(), earliest) - timestamps.begin());
+
+        if (mode_ == SignalMode::SIGNALS) {
+            // 与Portfolio::execute相同的运算顺序，订单与现金逐位一致
+            if (signal > 0.0) {
+                double amount_to_invest = cash * 0.9;
+                double quantity = amount_to_invest / price;
+                if (!config_.use_fractional_shares) {
+                    quantity = std::floor(quantity);
+                }
+                if (quantity <= 0) {
+                    continue;  // 资金不足
+                }
+                double commission = amount_to_invest * config_.commission_rate;
+                cash -= (quantity * price + commission);
+                result.commission += commission;
+                notional += quantity * price;
+                record_order(s, i, execution::OrderSide::BUY, quantity, price);
+                change_position(s, index, state.position + quantity);
+            } else {
+                if (state.position <= 0) {
+                    continue;  // 没有持仓
+                }
+                double quantity = state.position;
+                double commission = quantity * price * config_.commission_rate;
+                cash += (quantity * price - commission);
+                result.commission += commission;
+                notional += quantity * price;
+                record_order(s, i, execution::OrderSide::SELL, quantity, price);
+                change_position(s, index, 0.0);
+            }
+        } else {
+            // 按调仓前的总资产计算目标持仓，其他品种按各自不晚于当前时间的最新价格估值
+            double equity = cash;
+            for (std::size_t k = 0; k < columns.size(); ++k) {
+                if (states[k].position == 0.0) {
+                    continue;
+                }
+                const std::size_t last = columns[k].bars.upper_bound(earliest) - 1;
+                equity += states[k].position * columns[k].bars.close()[last];
+            }
+            double target = signal * equity / price;
+            if (!config_.use_fractional_shares) {
+                target = std::trunc(target);
+            }
+            const double quantity = target - state.position;
+            if (quantity == 0.0) {
+                continue;
+            }
+            const double traded = std::fabs(quantity);
+            double commission = traded * price * config_.commission_rate;
+            cash -= (quantity * price + commission);
+            result.commission += commission;
+            notional += traded * price;
+            record_order(s, i, quantity > 0.0 ? execution::OrderSide::BUY : execution::OrderSide::SELL, traded, price);
+            change_position(s, index, target);
+        }
+    }
+    for (std::size_t s = 0; s < columns.size(); ++s) {
+        if (states[s].position != 0.0) {
+            holdings.push_back({s, states[s].holding_begin, count, states[s].position});
+        }
+    }
+
+    // 资金曲线：先按段写入现金，再叠加各段持仓市值
+    result.equity.resize(count);
+    double* equity = result.equity.data();
+    for (std::size_t k = 0; k < cash_points.size(); ++k) {
+        const std::size_t end = k + 1 < cash_points.size() ? cash_points[k + 1].index : count;
+        fill_cash(equity + cash_points[k].index, end - cash_points[k].index, cash_points[k].cash);
+    }
+    for (const auto& holding : holdings) {
+        const data::BarSeriesView& bars = columns[holding.column].bars;
+        if (states[holding.column].aligned) {
+            add_position_value(
+                equity + holding.begin, bars.close().data() + holding.begin, holding.end - holding.begin, holding.quantity);
+        } else {
+            add_position_value_filled(equity, result.timestamps, bars, holding);
+        }
+    }
+
+    if (count > 0) {
+        result.turnover = notional / (sum_equity(equity, count) / static_cast<double>(count));
+    }
+    result.report = analysis::calculate_performance(result.timestamps, result.equity, result.orders, config_.initial_capital);
+}
+
+} // namespace backtest
+} // namespace quant
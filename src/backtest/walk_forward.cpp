@@ -0,0 +1,211 @@
+#include "backtest/walk_forward.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace quant {
+namespace backtest {
+
+namespace {
+
+WalkForwardOptions check_options(WalkForwardOptions options) {
+    if (options.in_sample <= 0 || options.out_of_sample <= 0) {
+        throw std::invalid_argument("Walk-forward windows must be positive");
+    }
+    if (options.warmup < 0) {
+        throw std::invalid_argument("Warmup must not be negative");
+    }
+    // 提前检查指标名称
+    result_metric(SweepResult(), options.metric);
+    return options;
+}
+
+// 加载数据所用的配置：各窗口按options.warmup预热，第一个窗口的预热区间在回测开始时间之前
+BacktestConfig loading_config(BacktestConfig config, const WalkForwardOptions& options) {
+    config.warmup_duration = std::max(config.warmup_duration, options.warmup);
+    return config;
+}
+
+// 样本内回测的结果
+struct InSampleRun {
+    analysis::PerformanceReport report;
+    double score = 0.0;
+    bool ok = false;
+};
+
+} // namespace
+
+WalkForward::WalkForward(
+    data::DataFeed& data_feed,
+    BacktestConfig config,
+    WalkForwardOptions options,
+    std::size_t threads)
+    : WalkForward(
+          load_backtest_data(data_feed, loading_config(config, options)),
+          config,
+          options,
+          threads) {}
+
+WalkForward::WalkForward(
+    std::shared_ptr<data::SeriesDataFeed> data,
+    BacktestConfig config,
+    WalkForwardOptions options,
+    std::size_t threads)
+    : data_(std::move(data)),
+      config_(shared_data_config(data_, std::move(config))),
+      options_(check_options(std::move(options))),
+      pool_(threads) {
+    columns_ = std::make_shared<indicators::IndicatorColumnCache>(data_);
+}
+
+std::vector<WalkForwardFold> WalkForward::make_folds() const {
+    // 回测区间内实际有数据的时间跨度
+    data::Timestamp first = std::numeric_limits<data::Timestamp>::max();
+    data::Timestamp last = std::numeric_limits<data::Timestamp>::min();
+    for (const auto& symbol : config_.symbols) {
+        auto series = data_->series(symbol).range(config_.start_time, config_.end_time);
+        if (!series.empty()) {
+            first = std::min(first, series.timestamps()[0]);
+            last = std::max(last, series.timestamps()[series.size() - 1]);
+        }
+    }
+
+    std::vector<WalkForwardFold> folds;
+    if (first > last) {
+        return folds;
+    }
+    for (std::size_t k = 0;; ++k) {
+        const data::Timestamp offset = static_cast<data::Timestamp>(k) * options_.out_of_sample;
+        WalkForwardFold fold;
+        fold.in_sample_start = options_.mode == WindowMode::ROLLING ? first + offset : first;
+        fold.in_sample_end = first + offset + options_.in_sample - 1;
+        fold.out_of_sample_start = fold.in_sample_end + 1;
+        if (fold.out_of_sample_start > last) {
+            break;
+        }
+        fold.out_of_sample_end = std::min(fold.out_of_sample_start + options_.out_of_sample - 1, last);
+        folds.push_back(std::move(fold));
+    }
+    return folds;
+}
+
+BacktestConfig WalkForward::window_config(data::Timestamp start_time, data::Timestamp end_time) const {
+    BacktestConfig config = config_;
+    config.start_time = start_time;
+    config.end_time = end_time;
+    config.warmup_duration = options_.warmup;
+    return config;
+}
+
+WalkForwardResult WalkForward::run(const ParameterGrid& grid, const StrategyBuilder& builder) {
+    return run(grid.combinations(), builder);
+}
+
+WalkForwardResult WalkForward::run(const std::vector<ParameterSet>& parameters, const StrategyBuilder& builder) {
+    if (!builder) {
+        throw std::invalid_argument("Strategy builder cannot be empty");
+    }
+
+    WalkForwardResult result;
+    result.folds = make_folds();
+    auto& folds = result.folds;
+    const std::size_t candidates = parameters.size();
+
+    // 全部折的样本内回测展开为一个任务列表，下标为 折 * 候选数 + 候选
+    std::vector<InSampleRun> in_sample(folds.size() * candidates);
+    pool_.parallel_for(in_sample.size(), [&](std::size_t job) {
+        const WalkForwardFold& fold = folds[job / candidates];
+        InSampleRun& run = in_sample[job];
+        try {
+            BacktestEngine engine(
+                data_, builder(parameters[job % candidates]),
+                window_config(fold.in_sample_start, fold.in_sample_end));
+            engine.run();
+
+            SweepResult row;
+            row.report = engine.get_performance_report();
+            row.final_equity = engine.get_equity();
+            run.score = result_metric(row, options_.metric);
+            run.report = std::move(row.report);
+            run.ok = !std::isnan(run.score);
+        } catch (const std::exception&) {
+            run.ok = false;
+        }
+    });
+    result.backtests += in_sample.size();
+
+    // 各折选出样本内最优参数，指标相同时取靠前的候选
+    std::vector<std::size_t> chosen(folds.size(), candidates);
+    for (std::size_t f = 0; f < folds.size(); ++f) {
+        for (std::size_t c = 0; c < candidates; ++c) {
+            const InSampleRun& run = in_sample[f * candidates + c];
+            if (!run.ok) {
+                continue;
+            }
+            std::size_t& best = chosen[f];
+            if (best == candidates ||
+                (options_.maximize ? run.score > in_sample[f * candidates + best].score
+                                   : run.score < in_sample[f * candidates + best].score)) {
+                best = c;
+            }
+        }
+        if (chosen[f] == candidates) {
+            folds[f].error = "No candidate completed the in-sample backtest";
+        } else {
+            folds[f].parameters = parameters[chosen[f]];
+            folds[f].in_sample = in_sample[f * candidates + chosen[f]].report;
+        }
+    }
+    in_sample.clear();
+
+    // 各折的样本外回测互不依赖，并行运行
+    pool_.parallel_for(folds.size(), [&](std::size_t f) {
+        WalkForwardFold& fold = folds[f];
+        if (!fold.ok()) {
+            return;
+        }
+        try {
+            BacktestEngine engine(
+                data_, builder(fold.parameters),
+                window_config(fold.out_of_sample_start, fold.out_of_sample_end));
+            engine.run();
+            fold.out_of_sample = engine.get_performance_report();
+            fold.equity_curve = engine.get_equity_curve();
+            fold.orders = engine.get_order_history();
+        } catch (const std::exception& e) {
+            fold.error = e.what();
+        }
+    });
+    result.backtests += static_cast<std::size_t>(
+        std::count_if(folds.begin(), folds.end(), [](const WalkForwardFold& fold) { return fold.ok(); }));
+
+    // 各折都从初始资金开始，按上一折期末资金等比例缩放后首尾相接。
+    // 交易按折配对，某折期末未平仓的开仓不与下一折的成交配成一笔交易
+    double capital = config_.initial_capital;
+    std::vector<data::Timestamp> timestamps;
+    std::vector<double> equity_values;
+    analysis::TradeStatistics trades;
+    for (const auto& fold : folds) {
+        if (!fold.ok() || fold.equity_curve.empty()) {
+            continue;
+        }
+        const double scale = capital / config_.initial_capital;
+        for (const auto& [timestamp, equity] : fold.equity_curve) {
+            result.equity_curve.emplace_back(timestamp, equity * scale);
+            timestamps.push_back(timestamp);
+            equity_values.push_back(equity * scale);
+        }
+        capital = result.equity_curve.back().second;
+        result.orders.insert(result.orders.end(), fold.orders.begin(), fold.orders.end());
+        for (const auto& order : fold.orders) {
+            trades.add(order);
+        }
+        trades.end_segment();
+    }
+    result.report = analysis::calculate_performance(timestamps, equity_values, trades, config_.initial_capital);
+    return result;
+}
+
+} // namespace backtest
+} // namespace quant
@@ -0,0 +1,174 @@
+#include "data/bar_cache.hpp"
+#include <algorithm>
+
+namespace quant {
+namespace data {
+
+namespace {
+
+// 每个区间的固定开销，保证空区间也计入预算
+constexpr std::size_t kSegmentOverhead = 128;
+
+std::size_t segment_bytes(const BarSeries& series) {
+    return series.memory_bytes() + kSegmentOverhead;
+}
+
+} // namespace
+
+BarCache::BarCache(std::size_t memory_budget_bytes) : budget_(memory_budget_bytes) {}
+
+bool BarCache::lookup(
+    SymbolId symbol,
+    const std::string& timeframe,
+    Timestamp start_time,
+    Timestamp end_time,
+    BarSeries& out) {
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto entry = entries_.find(Key{symbol, timeframe});
+    if (entry == entries_.end()) {
+        ++misses_;
+        return false;
+    }
+
+    // 找到起点不大于start_time的最后一个区间
+    auto& segments = entry->second;
+    auto it = segments.upper_bound(start_time);
+    if (it == segments.begin()) {
+        ++misses_;
+        return false;
+    }
+    --it;
+    if (it->second.end < end_time) {
+        ++misses_;
+        return false;
+    }
+
+    lru_.splice(lru_.begin(), lru_, it->second.lru);
+    ++hits_;
+    out = it->second.series.empty()
+        ? it->second.series
+        : it->second.series.range(start_time, end_time);
+    return true;
+}
+
+void BarCache::insert(
+    SymbolId symbol,
+    const std::string& timeframe,
+    Timestamp start_time,
+    Timestamp end_time,
+    const BarSeries& series) {
+
+    if (start_time > end_time) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (segment_bytes(series) > budget_) {
+        return;  // 单个结果超出预算，不缓存
+    }
+
+    Key key{symbol, timeframe};
+    auto& segments = entries_[key];
+
+    // 收集与新区间重叠或相邻的已有区间。调用方可能用Timestamp的最小/最大值表示不设边界，
+    // 先比较重叠再判断相邻，±1只在不会溢出时计算
+    auto first = segments.upper_bound(start_time);
+    if (first != segments.begin()) {
+        auto prev = std::prev(first);
+        if (prev->second.end >= start_time || prev->second.end + 1 == start_time) {
+            first = prev;
+        }
+    }
+    auto last = first;
+    while (last != segments.end() && (last->first <= end_time || last->first - 1 == end_time)) {
+        ++last;
+    }
+
+    Timestamp merged_start = start_time;
+    Timestamp merged_end = end_time;
+    BarSeries merged = series;
+    if (first != last) {
+        merged_start = std::min(start_time, first->first);
+        merged_end = std::max(end_time, std::prev(last)->second.end);
+
+        // 新结果覆盖[start_time, end_time]，其余部分取自已有区间。
+        // 只有存在更早或更晚的区间时才计算start_time - 1 / end_time + 1，不会溢出
+        BarSeriesBuilder builder(symbol);
+        for (auto it = first; it != last && it->first < start_time; ++it) {
+            if (!it->second.series.empty()) {
+                builder.append(it->second.series.view().range(it->first, start_time - 1));
+            }
+        }
+        builder.append(series.view());
+        for (auto it = first; it != last; ++it) {
+            if (it->second.end > end_time && !it->second.series.empty()) {
+                builder.append(it->second.series.view().range(end_time + 1, it->second.end));
+            }
+        }
+        merged = builder.build();
+
+        for (auto it = first; it != last;) {
+            auto next = std::next(it);
+            erase_segment(key, segments, it);
+            it = next;
+        }
+    }
+
+    lru_.push_front(LruEntry{key, merged_start});
+    memory_bytes_ += segment_bytes(merged);
+    segments.emplace(merged_start, Segment{merged_end, std::move(merged), lru_.begin()});
+
+    evict_to_budget();
+}
+
+void BarCache::erase_segment(const Key& /*key*/, SegmentMap& segments, SegmentMap::iterator it) {
+    memory_bytes_ -= segment_bytes(it->second.series);
+    lru_.erase(it->second.lru);
+    segments.erase(it);
+}
+
+void BarCache::evict_to_budget() {
+    while (memory_bytes_ > budget_ && !lru_.empty()) {
+        LruEntry victim = lru_.back();
+        auto entry = entries_.find(victim.key);
+        auto it = entry->second.find(victim.start);
+        erase_segment(victim.key, entry->second, it);
+        if (entry->second.empty()) {
+            entries_.erase(entry);
+        }
+        ++evictions_;
+    }
+}
+
+void BarCache::set_budget(std::size_t memory_budget_bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    budget_ = memory_budget_bytes;
+    evict_to_budget();
+}
+
+std::size_t BarCache::budget() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return budget_;
+}
+
+void BarCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    lru_.clear();
+    memory_bytes_ = 0;
+}
+
+BarCacheStats BarCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    BarCacheStats stats;
+    stats.hits = hits_;
+    stats.misses = misses_;
+    stats.evictions = evictions_;
+    stats.memory_bytes = memory_bytes_;
+    stats.segments = lru_.size();
+    return stats;
+}
+
+} // namespace data
+} // namespace quant
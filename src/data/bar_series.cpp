@@ -0,0 +1,166 @@
+#include "data/bar_series.hpp"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace quant {
+namespace data {
+
+namespace {
+
+// BarSeriesBuilder生成的自有列存储
+struct OwnedColumns {
+    std::vector<Timestamp> timestamp;
+    std::vector<double> open;
+    std::vector<double> high;
+    std::vector<double> low;
+    std::vector<double> close;
+    std::vector<double> volume;
+};
+
+template <typename T>
+std::vector<T> permute(const std::vector<T>& values, const std::vector<std::size_t>& order) {
+    std::vector<T> result(values.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        result[i] = values[order[i]];
+    }
+    return result;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// BarSeriesView
+// ---------------------------------------------------------------------------
+
+BarSeriesView BarSeriesView::slice(std::size_t first, std::size_t last) const {
+    if (first > last || last > size_) {
+        throw std::out_of_range("BarSeriesView::slice out of range");
+    }
+    if (first == last) {
+        return BarSeriesView(symbol_, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, 0);
+    }
+    return BarSeriesView(symbol_, timestamp_ + first, open_ + first, high_ + first,
+                         low_ + first, close_ + first, volume_ + first, last - first);
+}
+
+BarSeriesView BarSeriesView::range(Timestamp start_time, Timestamp end_time) const {
+    if (start_time > end_time) {
+        return slice(0, 0);
+    }
+    return slice(lower_bound(start_time), upper_bound(end_time));
+}
+
+std::size_t BarSeriesView::lower_bound(Timestamp t) const {
+    return static_cast<std::size_t>(std::lower_bound(timestamp_, timestamp_ + size_, t) - timestamp_);
+}
+
+std::size_t BarSeriesView::upper_bound(Timestamp t) const {
+    return static_cast<std::size_t>(std::upper_bound(timestamp_, timestamp_ + size_, t) - timestamp_);
+}
+
+// ---------------------------------------------------------------------------
+// BarSeries
+// ---------------------------------------------------------------------------
+
+BarSeries BarSeries::from_bars(const std::vector<BarData>& bars, SymbolId symbol) {
+    if (symbol == kInvalidSymbolId && !bars.empty()) {
+        symbol = bars.front().symbol;
+    }
+    BarSeriesBuilder builder(symbol);
+    builder.reserve(bars.size());
+    for (const auto& bar : bars) {
+        builder.push_back(bar);
+    }
+    return builder.build();
+}
+
+std::vector<BarData> BarSeries::to_bars() const {
+    std::vector<BarData> bars;
+    bars.reserve(view_.size());
+    for (std::size_t i = 0; i < view_.size(); ++i) {
+        bars.push_back(view_[i]);
+    }
+    return bars;
+}
+
+// ---------------------------------------------------------------------------
+// BarSeriesBuilder
+// ---------------------------------------------------------------------------
+
+void BarSeriesBuilder::reserve(std::size_t capacity) {
+    timestamp_.reserve(capacity);
+    open_.reserve(capacity);
+    high_.reserve(capacity);
+    low_.reserve(capacity);
+    close_.reserve(capacity);
+    volume_.reserve(capacity);
+}
+
+void BarSeriesBuilder::push_back(const BarData& bar) {
+    if (!timestamp_.empty() && bar.timestamp < timestamp_.back()) {
+        sorted_ = false;
+    }
+    timestamp_.push_back(bar.timestamp);
+    open_.push_back(bar.open);
+    high_.push_back(bar.high);
+    low_.push_back(bar.low);
+    close_.push_back(bar.close);
+    volume_.push_back(bar.volume);
+}
+
+void BarSeriesBuilder::append(const BarSeriesView& view) {
+    if (view.empty()) {
+        return;
+    }
+    if (!timestamp_.empty() && view.first_timestamp() < timestamp_.back()) {
+        sorted_ = false;
+    }
+    auto ts = view.timestamps();
+    timestamp_.insert(timestamp_.end(), ts.begin(), ts.end());
+    open_.insert(open_.end(), view.open().begin(), view.open().end());
+    high_.insert(high_.end(), view.high().begin(), view.high().end());
+    low_.insert(low_.end(), view.low().begin(), view.low().end());
+    close_.insert(close_.end(), view.close().begin(), view.close().end());
+    volume_.insert(volume_.end(), view.volume().begin(), view.volume().end());
+}
+
+BarSeries BarSeriesBuilder::build() {
+    auto columns = std::make_shared<OwnedColumns>();
+
+    if (!sorted_) {
+        std::vector<std::size_t> order(timestamp_.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) {
+            return timestamp_[a] < timestamp_[b];
+        });
+        columns->timestamp = permute(timestamp_, order);
+        columns->open = permute(open_, order);
+        columns->high = permute(high_, order);
+        columns->low = permute(low_, order);
+        columns->close = permute(close_, order);
+        columns->volume = permute(volume_, order);
+    } else {
+        columns->timestamp = std::move(timestamp_);
+        columns->open = std::move(open_);
+        columns->high = std::move(high_);
+        columns->low = std::move(low_);
+        columns->close = std::move(close_);
+        columns->volume = std::move(volume_);
+    }
+    timestamp_.clear();
+    open_.clear();
+    high_.clear();
+    low_.clear();
+    close_.clear();
+    volume_.clear();
+    sorted_ = true;
+
+    BarSeriesView view(symbol_, columns->timestamp.data(), columns->open.data(), columns->high.data(),
+                       columns->low.data(), columns->close.data(), columns->volume.data(),
+                       columns->timestamp.size());
+    return BarSeries(view, std::move(columns));
+}
+
+} // namespace data
+} // namespace quant
@@ -0,0 +1,294 @@
+#include "data/bar_store.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace quant {
+namespace data {
+
+namespace {
+
+void copy_fixed(char* dest, std::size_t capacity, const std::string& value, const char* what) {
+    if (value.size() >= capacity) {
+        throw std::invalid_argument(std::string(what) + " too long for bar store: " + value);
+    }
+    std::memset(dest, 0, capacity);
+    std::memcpy(dest, value.data(), value.size());
+}
+
+std::string read_fixed(const char* src, std::size_t capacity) {
+    return std::string(src, strnlen(src, capacity));
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// BarStoreWriter
+// ---------------------------------------------------------------------------
+
+BarStoreWriter::BarStoreWriter(const std::string& path, const std::string& timeframe)
+    : out_(path, std::ios::binary | std::ios::trunc),
+      timeframe_(timeframe) {
+    if (!out_) {
+        throw std::runtime_error("Cannot create bar store: " + path);
+    }
+
+    // 先写入占位文件头，finish()时回填
+    bar_store::Header header{};
+    out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    position_ = sizeof(header);
+}
+
+BarStoreWriter::~BarStoreWriter() {
+    try {
+        finish();
+    } catch (...) {
+        // 析构函数中不抛出异常
+    }
+}
+
+void BarStoreWriter::add_symbol(const std::string& symbol, const std::vector<BarData>& bars) {
+    if (finished_) {
+        throw std::logic_error("Bar store already finished");
+    }
+    if (seen_symbols_.count(symbol)) {
+        throw std::invalid_argument("Duplicate symbol in bar store: " + symbol);
+    }
+    for (std::size_t i = 1; i < bars.size(); ++i) {
+        if (bars[i].timestamp < bars[i - 1].timestamp) {
+            throw std::invalid_argument("Bars must be sorted by timestamp: " + symbol);
+        }
+    }
+
+    bar_store::SymbolEntry entry{};
+    copy_fixed(entry.symbol, bar_store::kSymbolLength, symbol, "Symbol");
+    entry.bar_count = bars.size();
+    if (!bars.empty()) {
+        entry.first_timestamp = bars.front().timestamp;
+        entry.last_timestamp = bars.back().timestamp;
+    }
+
+    // 行转列，逐列写出
+    std::vector<std::int64_t> timestamps(bars.size());
+    std::vector<double> column(bars.size());
+    for (std::size_t i = 0; i < bars.size(); ++i) {
+        timestamps[i] = bars[i].timestamp;
+    }
+    write_column(timestamps.data(), timestamps.size() * sizeof(std::int64_t),
+                 entry.column_offsets[bar_store::TIMESTAMP]);
+
+    const std::pair<bar_store::Column, double BarData::*> fields[] = {
+        {bar_store::OPEN, &BarData::open},
+        {bar_store::HIGH, &BarData::high},
+        {bar_store::LOW, &BarData::low},
+        {bar_store::CLOSE, &BarData::close},
+        {bar_store::VOLUME, &BarData::volume},
+    };
+    for (const auto& [index, member] : fields) {
+        for (std::size_t i = 0; i < bars.size(); ++i) {
+            column[i] = bars[i].*member;
+        }
+        write_column(column.data(), column.size() * sizeof(double), entry.column_offsets[index]);
+    }
+
+    // 稀疏时间索引
+    std::vector<std::int64_t> index;
+    for (std::size_t i = 0; i < bars.size(); i += bar_store::kIndexStride) {
+        index.push_back(timestamps[i]);
+    }
+    entry.index_count = index.size();
+    write_column(index.data(), index.size() * sizeof(std::int64_t), entry.index_offset);
+
+    seen_symbols_.emplace(symbol, entries_.size());
+    entries_.push_back(entry);
+    bar_count_ += bars.size();
+}
+
+void BarStoreWriter::finish() {
+    if (finished_) {
+        return;
+    }
+    finished_ = true;
+
+    pad_to_alignment();
+    std::uint64_t directory_offset = position_;
+    if (!entries_.empty()) {
+        out_.write(reinterpret_cast<const char*>(entries_.data()),
+                   entries_.size() * sizeof(bar_store::SymbolEntry));
+    }
+
+    bar_store::Header header{};
+    std::memcpy(header.magic, bar_store::kMagic, sizeof(header.magic));
+    header.version = bar_store::kVersion;
+    header.symbol_count = static_cast<std::uint32_t>(entries_.size());
+    header.bar_count = bar_count_;
+    header.directory_offset = directory_offset;
+    copy_fixed(header.timeframe, bar_store::kTimeframeLength, timeframe_, "Timeframe");
+
+    out_.seekp(0);
+    out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out_.close();
+    if (!out_) {
+        throw std::runtime_error("Failed to write bar store");
+    }
+}
+
+void BarStoreWriter::write_column(const void* data, std::size_t bytes, std::uint64_t& offset) {
+    pad_to_alignment();
+    offset = position_;
+    if (bytes > 0) {
+        out_.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+        position_ += bytes;
+    }
+}
+
+void BarStoreWriter::pad_to_alignment() {
+    static const char zeros[bar_store::kColumnAlignment] = {};
+    std::size_t remainder = position_ % bar_store::kColumnAlignment;
+    if (remainder != 0) {
+        std::size_t padding = bar_store::kColumnAlignment - remainder;
+        out_.write(zeros, static_cast<std::streamsize>(padding));
+        position_ += padding;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// MmapBarStore
+// ---------------------------------------------------------------------------
+
+MmapBarStore::MmapBarStore(const std::string& path)
+    : file_(std::make_shared<const utils::MappedFile>(path)) {
+    if (file_->size() < sizeof(bar_store::Header)) {
+        throw std::runtime_error("Bar store too small: " + path);
+    }
+
+    header_ = reinterpret_cast<const bar_store::Header*>(file_->data());
+    if (std::memcmp(header_->magic, bar_store::kMagic, sizeof(header_->magic)) != 0) {
+        throw std::runtime_error("Not a bar store file: " + path);
+    }
+    if (header_->version != bar_store::kVersion) {
+        throw std::runtime_error("Unsupported bar store version: " + path);
+    }
+
+    std::uint64_t directory_end = header_->directory_offset +
+        static_cast<std::uint64_t>(header_->symbol_count) * sizeof(bar_store::SymbolEntry);
+    if (directory_end > file_->size()) {
+        throw std::runtime_error("Corrupted bar store directory: " + path);
+    }
+
+    directory_ = column_at<bar_store::SymbolEntry>(header_->directory_offset);
+    timeframe_ = read_fixed(header_->timeframe, bar_store::kTimeframeLength);
+
+    symbol_index_.reserve(header_->symbol_count);
+    for (std::uint32_t i = 0; i < header_->symbol_count; ++i) {
+        const auto& entry = directory_[i];
+        std::uint64_t column_end = entry.column_offsets[bar_store::VOLUME] + entry.bar_count * sizeof(double);
+        if (column_end > file_->size() ||
+            entry.index_offset + entry.index_count * sizeof(std::int64_t) > file_->size()) {
+            throw std::runtime_error("Corrupted bar store entry: " + path);
+        }
+        symbol_index_.emplace(read_fixed(entry.symbol, bar_store::kSymbolLength), i);
+    }
+}
+
+const bar_store::SymbolEntry* MmapBarStore::find_entry(const std::string& symbol) const {
+    auto it = symbol_index_.find(symbol);
+    if (it == symbol_index_.end()) {
+        return nullptr;
+    }
+    return &directory_[it->second];
+}
+
+BarSeriesView MmapBarStore::query(const std::string& symbol, Timestamp start_time, Timestamp end_time) const {
+    const auto* entry = find_entry(symbol);
+    if (!entry || entry->bar_count == 0 || start_time > end_time ||
+        end_time < entry->first_timestamp || start_time > entry->last_timestamp) {
+        return BarSeriesView();
+    }
+
+    const auto* timestamps = column_at<Timestamp>(entry->column_offsets[bar_store::TIMESTAMP]);
+    const auto* index = column_at<std::int64_t>(entry->index_offset);
+    const auto* index_end = index + entry->index_count;
+
+    // 先在稀疏索引上定位所在分段，再在分段内二分，只触及少量页面
+    auto locate = [&](Timestamp t, bool upper) -> std::size_t {
+        const std::int64_t* block = upper
+            ? std::upper_bound(index, index_end, static_cast<std::int64_t>(t))
+            : std::lower_bound(index, index_end, static_cast<std::int64_t>(t));
+        std::size_t block_index = static_cast<std::size_t>(block - index);
+        std::size_t lo = block_index == 0 ? 0 : (block_index - 1) * bar_store::kIndexStride;
+        std::size_t hi = std::min<std::size_t>(entry->bar_count, block_index * bar_store::kIndexStride + 1);
+        const Timestamp* pos = upper
+            ? std::upper_bound(timestamps + lo, timestamps + hi, t)
+            : std::lower_bound(timestamps + lo, timestamps + hi, t);
+        return static_cast<std::size_t>(pos - timestamps);
+    };
+
+    std::size_t first = locate(start_time, false);
+    std::size_t last = locate(end_time, true);
+    if (first >= last) {
+        return BarSeriesView();
+    }
+
+    return BarSeriesView(
+        intern_symbol(symbol),
+        timestamps + first,
+        column_at<double>(entry->column_offsets[bar_store::OPEN]) + first,
+        column_at<double>(entry->column_offsets[bar_store::HIGH]) + first,
+        column_at<double>(entry->column_offsets[bar_store::LOW]) + first,
+        column_at<double>(entry->column_offsets[bar_store::CLOSE]) + first,
+        column_at<double>(entry->column_offsets[bar_store::VOLUME]) + first,
+        last - first);
+}
+
+bool MmapBarStore::has_symbol(const std::string& symbol) const {
+    return symbol_index_.count(symbol) > 0;
+}
+
+std::vector<std::string> MmapBarStore::symbols() const {
+    std::vector<std::string> names;
+    names.reserve(header_->symbol_count);
+    for (std::uint32_t i = 0; i < header_->symbol_count; ++i) {
+        names.push_back(read_fixed(directory_[i].symbol, bar_store::kSymbolLength));
+    }
+    return names;
+}
+
+std::vector<BarData> MmapBarStore::get_historical_bars(
+    const std::string& symbol,
+    const Timestamp& start_time,
+    const Timestamp& end_time,
+    const std::string& timeframe) {
+    return get_bar_series(symbol, start_time, end_time, timeframe).to_bars();
+}
+
+BarSeries MmapBarStore::get_bar_series(
+    const std::string& symbol,
+    const Timestamp& start_time,
+    const Timestamp& end_time,
+    const std::string& timeframe) {
+
+    if (!timeframe.empty() && timeframe != timeframe_) {
+        throw std::invalid_argument("Bar store holds " + timeframe_ + " bars, requested " + timeframe);
+    }
+
+    auto view = query(symbol, start_time, end_time);
+    if (view.empty()) {
+        return BarSeries::from_bars({}, intern_symbol(symbol));
+    }
+    // 序列持有映射文件的引用，数据直接来自页缓存
+    return BarSeries(view, file_);
+}
+
+void MmapBarStore::subscribe_market_data(
+    const std::string& symbol,
+    std::function<void(const MarketData&)> /*callback*/) {
+    throw std::runtime_error("MmapBarStore does not support real-time data: " + symbol);
+}
+
+void MmapBarStore::unsubscribe_market_data(const std::string& symbol) {
+    throw std::runtime_error("MmapBarStore does not support real-time data: " + symbol);
+}
+
+} // namespace data
+} // namespace quant
@@ -0,0 +1,181 @@
+#include "data/bar_stream.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace quant {
+namespace data {
+
+// ---------------------------------------------------------------------------
+// SeriesChunkSource
+// ---------------------------------------------------------------------------
+
+SeriesChunkSource::SeriesChunkSource(BarSeries series, std::size_t chunk_size)
+    : series_(std::move(series)), chunk_size_(chunk_size) {
+    if (chunk_size_ == 0) {
+        throw std::invalid_argument("Chunk size must be greater than 0");
+    }
+}
+
+BarSeries SeriesChunkSource::next_chunk() {
+    if (position_ >= series_.size()) {
+        return BarSeries();
+    }
+    std::size_t last = std::min(series_.size(), position_ + chunk_size_);
+    BarSeries chunk = series_.slice(position_, last);
+    position_ = last;
+    return chunk;
+}
+
+// ---------------------------------------------------------------------------
+// DataFeedChunkSource
+// ---------------------------------------------------------------------------
+
+DataFeedChunkSource::DataFeedChunkSource(
+    std::shared_ptr<DataFeed> data_feed,
+    std::string symbol,
+    Timestamp start_time,
+    Timestamp end_time,
+    std::string timeframe,
+    Timestamp window_seconds)
+    : data_feed_(std::move(data_feed)),
+      symbol_(std::move(symbol)),
+      cursor_(start_time),
+      end_time_(end_time),
+      timeframe_(std::move(timeframe)),
+      window_seconds_(window_seconds) {
+    if (!data_feed_) {
+        throw std::invalid_argument("Data feed cannot be null");
+    }
+    if (window_seconds_ < 0) {
+        throw std::invalid_argument("Window must not be negative");
+    }
+    exhausted_ = start_time > end_time;
+}
+
+BarSeries DataFeedChunkSource::next_chunk() {
+    // 跳过没有数据的窗口（如休市时段），直到取到数据或越过结束时间
+    while (!exhausted_) {
+        Timestamp window_end = end_time_;
+        if (window_seconds_ > 0 && cursor_ <= end_time_ - window_seconds_) {
+            window_end = cursor_ + window_seconds_ - 1;
+        }
+
+        BarSeries chunk = data_feed_->get_bar_series(symbol_, cursor_, window_end, timeframe_);
+
+        if (window_end >= end_time_) {
+            exhausted_ = true;
+        } else {
+            cursor_ = window_end + 1;
+        }
+        if (!chunk.empty()) {
+            return chunk;
+        }
+    }
+    return BarSeries();
+}
+
+// ---------------------------------------------------------------------------
+// MergedBarStream
+// ---------------------------------------------------------------------------
+
+MergedBarStream::MergedBarStream(std::vector<std::unique_ptr<BarChunkSource>> sources)
+    : sources_(std::move(sources)),
+      cursors_(sources_.size()) {
+    if (sources_.size() >= std::numeric_limits<std::uint32_t>::max()) {
+        throw std::invalid_argument("Too many sources");
+    }
+
+    heap_.reserve(sources_.size());
+    for (std::uint32_t i = 0; i < sources_.size(); ++i) {
+        if (!sources_[i]) {
+            throw std::invalid_argument("Bar chunk source cannot be null");
+        }
+        cursors_[i].chunk = sources_[i]->next_chunk();
+        if (!cursors_[i].chunk.empty()) {
+            heap_.push_back(i);
+            sift_up(heap_.size() - 1);
+        }
+    }
+}
+
+bool MergedBarStream::next(BarData& bar) {
+    if (heap_.empty()) {
+        return false;
+    }
+
+    std::uint32_t index = heap_.front();
+    auto& cursor = cursors_[index];
+    bar = cursor.chunk[cursor.position];
+
+    if (advance(index)) {
+        // 堆顶键值变大，下沉即可
+        sift_down(0);
+    } else {
+        heap_.front() = heap_.back();
+        heap_.pop_back();
+        if (!heap_.empty()) {
+            sift_down(0);
+        }
+    }
+    return true;
+}
+
+Timestamp MergedBarStream::peek_timestamp() const {
+    return key(heap_.front());
+}
+
+bool MergedBarStream::advance(std::uint32_t index) {
+    auto& cursor = cursors_[index];
+    if (++cursor.position < cursor.chunk.size()) {
+        return true;
+    }
+
+    // 当前块用完，释放后再拉取下一块
+    cursor.chunk = BarSeries();
+    cursor.position = 0;
+    cursor.chunk = sources_[index]->next_chunk();
+    return !cursor.chunk.empty();
+}
+
+bool MergedBarStream::less(std::uint32_t a, std::uint32_t b) const {
+    Timestamp ka = key(a);
+    Timestamp kb = key(b);
+    return ka < kb || (ka == kb && a < b);
+}
+
+void MergedBarStream::sift_down(std::size_t slot) {
+    const std::size_t size = heap_.size();
+    std::uint32_t item = heap_[slot];
+    while (true) {
+        std::size_t child = 2 * slot + 1;
+        if (child >= size) {
+            break;
+        }
+        if (child + 1 < size && less(heap_[child + 1], heap_[child])) {
+            ++child;
+        }
+        if (!less(heap_[child], item)) {
+            break;
+        }
+        heap_[slot] = heap_[child];
+        slot = child;
+    }
+    heap_[slot] = item;
+}
+
+void MergedBarStream::sift_up(std::size_t slot) {
+    std::uint32_t item = heap_[slot];
+    while (slot > 0) {
+        std::size_t parent = (slot - 1) / 2;
+        if (!less(item, heap_[parent])) {
+            break;
+        }
+        heap_[slot] = heap_[parent];
+        slot = parent;
+    }
+    heap_[slot] = item;
+}
+
+} // namespace data
+} // namespace quant
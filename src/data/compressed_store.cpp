@@ -0,0 +1,842 @@
+#include "data/compressed_store.hpp"
+#include "utils/bit_stream.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace quant {
+namespace data {
+
+namespace compressed_store {
+
+namespace {
+
+using utils::BitReader;
+using utils::BitWriter;
+
+constexpr unsigned kMaxDecimalScale = 9;
+constexpr double kPow10[kMaxDecimalScale + 1] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9};
+// 定点整数可以被double精确表示的上限
+constexpr double kMaxExactInteger = 9007199254740992.0;
+// 定点编码中差分位打包的分组大小
+constexpr std::size_t kFrameSize = 64;
+
+enum ColumnMode : unsigned {
+    XOR_MODE = 0,
+    SCALED_MODE = 1
+};
+
+inline std::uint64_t zigzag(std::int64_t value) {
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+inline std::int64_t unzigzag(std::uint64_t value) {
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+inline unsigned bit_width(std::uint64_t value) {
+    return value == 0 ? 0 : 64 - utils::count_leading_zeros(value);
+}
+
+inline std::uint64_t double_bits(double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline double bits_double(std::uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// 时间戳二阶差分编码：
+// '0' 二阶差分为0；'10'+7位；'110'+9位；'1110'+12位；'11110'+32位；'11111'+64位（zigzag）
+void encode_timestamps(const Timestamp* values, std::size_t count, BitWriter& writer) {
+    if (count == 0) {
+        return;
+    }
+    writer.write(static_cast<std::uint64_t>(values[0]), 64);
+    std::int64_t previous_delta = 0;
+    for (std::size_t i = 1; i < count; ++i) {
+        std::int64_t delta = values[i] - values[i - 1];
+        std::uint64_t encoded = zigzag(delta - previous_delta);
+        previous_delta = delta;
+        if (encoded == 0) {
+            writer.write(0, 1);
+        } else if (encoded < (1u << 7)) {
+            writer.write(0b10, 2);
+            writer.write(encoded, 7);
+        } else if (encoded < (1u << 9)) {
+            writer.write(0b110, 3);
+            writer.write(encoded, 9);
+        } else if (encoded < (1u << 12)) {
+            writer.write(0b1110, 4);
+            writer.write(encoded, 12);
+        } else if (encoded < (std::uint64_t(1) << 32)) {
+            writer.write(0b11110, 5);
+            writer.write(encoded, 32);
+        } else {
+            writer.write(0b11111, 5);
+            writer.write(encoded, 64);
+        }
+    }
+}
+
+void decode_timestamps(BitReader& reader, std::size_t count, Timestamp* out) {
+    if (count == 0) {
+        return;
+    }
+    static constexpr unsigned kBucketBits[] = {0, 7, 9, 12};
+    Timestamp value = static_cast<Timestamp>(reader.read(64));
+    out[0] = value;
+    std::int64_t delta = 0;
+    for (std::size_t i = 1; i < count; ++i) {
+        unsigned bucket = reader.read_unary(4);
+        if (bucket < 4) {
+            if (bucket > 0) {
+                delta += unzigzag(reader.read(kBucketBits[bucket]));
+            }
+        } else {
+            delta += unzigzag(reader.read(reader.read_bit() ? 64 : 32));
+        }
+        value += delta;
+        out[i] = value;
+    }
+}
+
+// 找到能让整列精确转为定点整数的最小小数位数，找不到返回-1。
+// 整数没有负零，含-0.0的列解码后会变成+0.0，只能使用异或编码
+int find_decimal_scale(const double* values, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        if (values[i] == 0.0 && std::signbit(values[i])) {
+            return -1;
+        }
+    }
+    for (unsigned scale = 0; scale <= kMaxDecimalScale; ++scale) {
+        const double factor = kPow10[scale];
+        bool exact = true;
+        for (std::size_t i = 0; i < count && exact; ++i) {
+            double scaled = values[i] * factor;
+            if (!(std::fabs(scaled) < kMaxExactInteger)) {
+                exact = false;
+                break;
+            }
+            exact = std::nearbyint(scaled) / factor == values[i];
+        }
+        if (exact) {
+            return static_cast<int>(scale);
+        }
+    }
+    return -1;
+}
+
+void encode_scaled(const double* values, std::size_t count, unsigned scale, BitWriter& writer) {
+    const double factor = kPow10[scale];
+    writer.write(scale, 4);
+
+    std::int64_t previous = static_cast<std::int64_t>(std::nearbyint(values[0] * factor));
+    writer.write(zigzag(previous), 64);
+
+    std::uint64_t frame[kFrameSize];
+    for (std::size_t start = 1; start < count; start += kFrameSize) {
+        std::size_t length = std::min(kFrameSize, count - start);
+        std::uint64_t combined = 0;
+        for (std::size_t i = 0; i < length; ++i) {
+            std::int64_t current = static_cast<std::int64_t>(std::nearbyint(values[start + i] * factor));
+            frame[i] = zigzag(current - previous);
+            combined |= frame[i];
+            previous = current;
+        }
+        unsigned width = bit_width(combined);
+        writer.write(width, 7);
+        for (std::size_t i = 0; i < length; ++i) {
+            writer.write(frame[i], width);
+        }
+    }
+}
+
+void decode_scaled(BitReader& reader, std::size_t count, double* out) {
+    unsigned scale = static_cast<unsigned>(reader.read(4));
+    if (scale > kMaxDecimalScale) {
+        throw std::runtime_error("Corrupted compressed block: invalid decimal scale");
+    }
+    const double factor = kPow10[scale];
+
+    std::int64_t value = unzigzag(reader.read(64));
+    out[0] = static_cast<double>(value) / factor;
+    for (std::size_t start = 1; start < count; start += kFrameSize) {
+        std::size_t end = std::min(count, start + kFrameSize);
+        unsigned width = static_cast<unsigned>(reader.read(7));
+        if (width > 64) {
+            throw std::runtime_error("Corrupted compressed block: invalid frame width");
+        }
+        for (std::size_t i = start; i < end; ++i) {
+            value += unzigzag(reader.read(width));
+            out[i] = static_cast<double>(value) / factor;
+        }
+    }
+}
+
+// Gorilla XOR编码：'0' 与前值相同；'10' 沿用上一个有效位窗口；
+// '11'+5位前导零+6位有效位长度+有效位
+void encode_xor(const double* values, std::size_t count, BitWriter& writer) {
+    std::uint64_t previous = double_bits(values[0]);
+    writer.write(previous, 64);
+
+    unsigned previous_leading = 0;
+    unsigned previous_trailing = 0;
+    bool has_window = false;
+    for (std::size_t i = 1; i < count; ++i) {
+        std::uint64_t current = double_bits(values[i]);
+        std::uint64_t x = current ^ previous;
+        previous = current;
+        if (x == 0) {
+            writer.write(0, 1);
+            continue;
+        }
+
+        unsigned leading = std::min(31u, utils::count_leading_zeros(x));
+        unsigned trailing = utils::count_trailing_zeros(x);
+        if (has_window && leading >= previous_leading && trailing >= previous_trailing) {
+            writer.write(0b10, 2);
+            writer.write(x >> previous_trailing, 64 - previous_leading - previous_trailing);
+        } else {
+            unsigned meaningful = 64 - leading - trailing;
+            writer.write(0b11, 2);
+            writer.write(leading, 5);
+            writer.write(meaningful - 1, 6);
+            writer.write(x >> trailing, meaningful);
+            previous_leading = leading;
+            previous_trailing = trailing;
+            has_window = true;
+        }
+    }
+}
+
+void decode_xor(BitReader& reader, std::size_t count, double* out) {
+    std::uint64_t value = reader.read(64);
+    out[0] = bits_double(value);
+
+    unsigned leading = 0;
+    unsigned trailing = 0;
+    for (std::size_t i = 1; i < count; ++i) {
+        if (reader.read_bit()) {
+            if (reader.read_bit()) {
+                leading = static_cast<unsigned>(reader.read(5));
+                unsigned meaningful = static_cast<unsigned>(reader.read(6)) + 1;
+                if (leading + meaningful > 64) {
+                    throw std::runtime_error("Corrupted compressed block: invalid XOR window");
+                }
+                trailing = 64 - leading - meaningful;
+            }
+            value ^= reader.read(64 - leading - trailing) << trailing;
+        }
+        out[i] = bits_double(value);
+    }
+}
+
+void encode_column(const double* values, std::size_t count, BitWriter& writer) {
+    if (count == 0) {
+        return;
+    }
+    int scale = find_decimal_scale(values, count);
+    if (scale >= 0) {
+        writer.write(SCALED_MODE, 1);
+        encode_scaled(values, count, static_cast<unsigned>(scale), writer);
+    } else {
+        writer.write(XOR_MODE, 1);
+        encode_xor(values, count, writer);
+    }
+}
+
+void decode_column(BitReader& reader, std::size_t count, double* out) {
+    if (count == 0) {
+        return;
+    }
+    if (reader.read_bit()) {
+        decode_scaled(reader, count, out);
+    } else {
+        decode_xor(reader, count, out);
+    }
+}
+
+// 块头占位 -> 写载荷 -> 回填块头并补齐
+template <typename WritePayload>
+void write_block(std::vector<std::uint8_t>& out, SeriesKind kind, std::size_t count,
+                 Timestamp min_timestamp, Timestamp max_timestamp, WritePayload&& write_payload) {
+    std::size_t header_offset = out.size();
+    out.resize(header_offset + sizeof(BlockHeader));
+
+    BitWriter writer(out);
+    write_payload(writer);
+    writer.flush();
+
+    std::size_t payload_bytes = out.size() - header_offset - sizeof(BlockHeader);
+    std::size_t padded = (payload_bytes + 7) / 8 * 8 + kBlockPadding;
+    out.resize(header_offset + sizeof(BlockHeader) + padded, 0);
+
+    BlockHeader header{};
+    header.record_count = static_cast<std::uint32_t>(count);
+    header.payload_bytes = static_cast<std::uint32_t>(payload_bytes);
+    header.min_timestamp = min_timestamp;
+    header.max_timestamp = max_timestamp;
+    header.kind = kind;
+    std::memcpy(out.data() + header_offset, &header, sizeof(header));
+}
+
+} // namespace
+
+void encode_bar_block(const BarSeriesView& bars, std::vector<std::uint8_t>& out) {
+    if (bars.empty()) {
+        throw std::invalid_argument("Cannot encode an empty bar block");
+    }
+    const std::size_t count = bars.size();
+    write_block(out, SeriesKind::BARS, count, bars.first_timestamp(), bars.last_timestamp(),
+        [&](BitWriter& writer) {
+            encode_timestamps(bars.timestamps().data(), count, writer);
+            encode_column(bars.open().data(), count, writer);
+            encode_column(bars.high().data(), count, writer);
+            encode_column(bars.low().data(), count, writer);
+            encode_column(bars.close().data(), count, writer);
+            encode_column(bars.volume().data(), count, writer);
+        });
+}
+
+void encode_trade_block(const Trade* trades, std::size_t count, std::vector<std::uint8_t>& out) {
+    if (count == 0) {
+        throw std::invalid_argument("Cannot encode an empty trade block");
+    }
+    std::vector<Timestamp> timestamps(count);
+    std::vector<double> prices(count);
+    std::vector<double> volumes(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        timestamps[i] = trades[i].timestamp;
+        prices[i] = trades[i].price;
+        volumes[i] = trades[i].volume;
+    }
+    write_block(out, SeriesKind::TRADES, count, trades[0].timestamp, trades[count - 1].timestamp,
+        [&](BitWriter& writer) {
+            encode_timestamps(timestamps.data(), count, writer);
+            encode_column(prices.data(), count, writer);
+            encode_column(volumes.data(), count, writer);
+            for (std::size_t i = 0; i < count; ++i) {
+                writer.write_bit(trades[i].is_buyer_maker);
+            }
+        });
+}
+
+void decode_bar_block(const BlockHeader& header, const std::uint8_t* payload,
+                      Timestamp* timestamp, double* open, double* high,
+                      double* low, double* close, double* volume) {
+    if (header.kind != SeriesKind::BARS) {
+        throw std::runtime_error("Compressed block does not hold bars");
+    }
+    const std::size_t count = header.record_count;
+    BitReader reader(payload, header.payload_bytes + kBlockPadding);
+    decode_timestamps(reader, count, timestamp);
+    decode_column(reader, count, open);
+    decode_column(reader, count, high);
+    decode_column(reader, count, low);
+    decode_column(reader, count, close);
+    decode_column(reader, count, volume);
+}
+
+void decode_trade_block(const BlockHeader& header, const std::uint8_t* payload,
+                        SymbolId symbol, std::vector<Trade>& out) {
+    if (header.kind != SeriesKind::TRADES) {
+        throw std::runtime_error("Compressed block does not hold trades");
+    }
+    const std::size_t count = header.record_count;
+    std::vector<Timestamp> timestamps(count);
+    std::vector<double> prices(count);
+    std::vector<double> volumes(count);
+    BitReader reader(payload, header.payload_bytes + kBlockPadding);
+    decode_timestamps(reader, count, timestamps.data());
+    decode_column(reader, count, prices.data());
+    decode_column(reader, count, volumes.data());
+
+    out.reserve(out.size() + count);
+    for (std::size_t i = 0; i < count; ++i) {
+        out.push_back(Trade{timestamps[i], symbol, prices[i], volumes[i], reader.read_bit()});
+    }
+}
+
+} // namespace compressed_store
+
+namespace {
+
+using compressed_store::BlockHeader;
+using compressed_store::SeriesKind;
+using compressed_store::SymbolEntry;
+
+void copy_fixed(char* dest, std::size_t capacity, const std::string& value, const char* what) {
+    if (value.size() >= capacity) {
+        throw std::invalid_argument(std::string(what) + " too long for compressed store: " + value);
+    }
+    std::memset(dest, 0, capacity);
+    std::memcpy(dest, value.data(), value.size());
+}
+
+std::string read_fixed(const char* src, std::size_t capacity) {
+    return std::string(src, strnlen(src, capacity));
+}
+
+// 解码结果的自有列存储；数组不做零初始化，解码直接写入
+struct DecodedColumns {
+    std::unique_ptr<Timestamp[]> timestamp;
+    std::unique_ptr<double[]> open;
+    std::unique_ptr<double[]> high;
+    std::unique_ptr<double[]> low;
+    std::unique_ptr<double[]> close;
+    std::unique_ptr<double[]> volume;
+    std::size_t capacity = 0;
+
+    void reserve(std::size_t size) {
+        if (size <= capacity) {
+            return;
+        }
+        timestamp.reset(new Timestamp[size]);
+        open.reset(new double[size]);
+        high.reset(new double[size]);
+        low.reset(new double[size]);
+        close.reset(new double[size]);
+        volume.reset(new double[size]);
+        capacity = size;
+    }
+
+    void decode(const BlockHeader& header, const std::uint8_t* payload, std::size_t offset) {
+        compressed_store::decode_bar_block(header, payload,
+            timestamp.get() + offset, open.get() + offset, high.get() + offset,
+            low.get() + offset, close.get() + offset, volume.get() + offset);
+    }
+
+    // [start_time, end_time]内[0, size)部分的视图
+    BarSeriesView view(SymbolId symbol, std::size_t size, Timestamp start_time, Timestamp end_time) const {
+        BarSeriesView all(symbol, timestamp.get(), open.get(), high.get(),
+                          low.get(), close.get(), volume.get(), size);
+        return all.range(start_time, end_time);
+    }
+};
+
+const BlockHeader& block_at(const utils::MappedFile& file, const SymbolEntry& entry, std::size_t index) {
+    std::uint64_t offset;
+    std::memcpy(&offset, file.data() + entry.block_table_offset + index * sizeof(std::uint64_t), sizeof(offset));
+    if (offset + sizeof(BlockHeader) > file.size()) {
+        throw std::runtime_error("Corrupted compressed store: block offset out of range");
+    }
+    const auto& header = *reinterpret_cast<const BlockHeader*>(file.data() + offset);
+    if (offset + sizeof(BlockHeader) + header.payload_bytes + compressed_store::kBlockPadding > file.size() ||
+        header.kind != entry.kind) {
+        throw std::runtime_error("Corrupted compressed store: bad block header");
+    }
+    return header;
+}
+
+const std::uint8_t* payload_of(const BlockHeader& header) {
+    return reinterpret_cast<const std::uint8_t*>(&header + 1);
+}
+
+// 与[start_time, end_time]相交的块下标区间[first, last)
+std::pair<std::size_t, std::size_t> block_range(const utils::MappedFile& file, const SymbolEntry& entry,
+                                                Timestamp start_time, Timestamp end_time) {
+    if (start_time > end_time || entry.block_count == 0 ||
+        end_time < entry.first_timestamp || start_time > entry.last_timestamp) {
+        return {0, 0};
+    }
+    // 块按时间升序排列，二分只读取少量块头
+    std::size_t lo = 0;
+    std::size_t hi = entry.block_count;
+    while (lo < hi) {
+        std::size_t mid = lo + (hi - lo) / 2;
+        if (block_at(file, entry, mid).max_timestamp < start_time) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    std::size_t first = lo;
+    hi = entry.block_count;
+    while (lo < hi) {
+        std::size_t mid = lo + (hi - lo) / 2;
+        if (block_at(file, entry, mid).min_timestamp <= end_time) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return {first, lo};
+}
+
+} // namespace
+
+// 逐块解码的K线来源
+class CompressedBarChunkSource : public BarChunkSource {
+public:
+    CompressedBarChunkSource(std::shared_ptr<const utils::MappedFile> file, const SymbolEntry* entry,
+                             SymbolId symbol, Timestamp start_time, Timestamp end_time)
+        : file_(std::move(file)), entry_(entry), symbol_(symbol),
+          start_time_(start_time), end_time_(end_time) {
+        if (entry_) {
+            std::tie(next_block_, end_block_) = block_range(*file_, *entry_, start_time_, end_time_);
+        }
+    }
+
+    BarSeries next_chunk() override {
+        while (next_block_ < end_block_) {
+            const auto& header = block_at(*file_, *entry_, next_block_++);
+            auto columns = std::make_shared<DecodedColumns>();
+            columns->reserve(header.record_count);
+            columns->decode(header, payload_of(header), 0);
+            auto view = columns->view(symbol_, header.record_count, start_time_, end_time_);
+            if (!view.empty()) {
+                return BarSeries(view, std::move(columns));
+            }
+        }
+        return BarSeries();
+    }
+
+private:
+    std::shared_ptr<const utils::MappedFile> file_;
+    const SymbolEntry* entry_;
+    SymbolId symbol_;
+    Timestamp start_time_;
+    Timestamp end_time_;
+    std::size_t next_block_ = 0;
+    std::size_t end_block_ = 0;
+};
+
+// ---------------------------------------------------------------------------
+// CompressedStoreWriter
+// ---------------------------------------------------------------------------
+
+CompressedStoreWriter::CompressedStoreWriter(const std::string& path, const std::string& timeframe,
+                                             std::size_t block_size)
+    : out_(path, std::ios::binary | std::ios::trunc),
+      timeframe_(timeframe),
+      block_size_(block_size) {
+    if (block_size_ == 0 || block_size_ > UINT32_MAX) {
+        throw std::invalid_argument("Invalid compressed block size");
+    }
+    if (!out_) {
+        throw std::runtime_error("Cannot create compressed store: " + path);
+    }
+
+    // 先写入占位文件头，finish()时回填
+    compressed_store::Header header{};
+    out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    position_ = sizeof(header);
+}
+
+CompressedStoreWriter::~CompressedStoreWriter() {
+    try {
+        finish();
+    } catch (...) {
+        // 析构函数中不抛出异常
+    }
+}
+
+SymbolEntry CompressedStoreWriter::make_entry(const std::string& symbol, SeriesKind kind) {
+    if (finished_) {
+        throw std::logic_error("Compressed store already finished");
+    }
+    if (seen_.count({symbol, kind})) {
+        throw std::invalid_argument("Duplicate series in compressed store: " + symbol);
+    }
+    SymbolEntry entry{};
+    copy_fixed(entry.symbol, compressed_store::kSymbolLength, symbol, "Symbol");
+    entry.kind = kind;
+    return entry;
+}
+
+void CompressedStoreWriter::write_block(const std::vector<std::uint8_t>& block, std::vector<std::uint64_t>& offsets) {
+    offsets.push_back(position_);
+    out_.write(reinterpret_cast<const char*>(block.data()), static_cast<std::streamsize>(block.size()));
+    position_ += block.size();
+}
+
+void CompressedStoreWriter::commit_entry(SymbolEntry entry, const std::vector<std::uint64_t>& offsets) {
+    // 所有块都补齐到8字节，块偏移表天然对齐
+    entry.block_table_offset = position_;
+    entry.block_count = static_cast<std::uint32_t>(offsets.size());
+    if (!offsets.empty()) {
+        out_.write(reinterpret_cast<const char*>(offsets.data()),
+                   static_cast<std::streamsize>(offsets.size() * sizeof(std::uint64_t)));
+        position_ += offsets.size() * sizeof(std::uint64_t);
+    }
+    seen_.emplace(std::make_pair(read_fixed(entry.symbol, compressed_store::kSymbolLength), entry.kind),
+                  entries_.size());
+    entries_.push_back(entry);
+    record_count_ += entry.record_count;
+}
+
+void CompressedStoreWriter::add_bars(const std::string& symbol, const BarSeriesView& bars) {
+    SymbolEntry entry = make_entry(symbol, SeriesKind::BARS);
+    auto timestamps = bars.timestamps();
+    for (std::size_t i = 1; i < timestamps.size(); ++i) {
+        if (timestamps[i] < timestamps[i - 1]) {
+            throw std::invalid_argument("Bars must be sorted by timestamp: " + symbol);
+        }
+    }
+
+    entry.record_count = bars.size();
+    if (!bars.empty()) {
+        entry.first_timestamp = bars.first_timestamp();
+        entry.last_timestamp = bars.last_timestamp();
+    }
+
+    std::vector<std::uint64_t> offsets;
+    std::vector<std::uint8_t> block;
+    for (std::size_t first = 0; first < bars.size(); first += block_size_) {
+        block.clear();
+        compressed_store::encode_bar_block(bars.slice(first, std::min(bars.size(), first + block_size_)), block);
+        write_block(block, offsets);
+    }
+    commit_entry(entry, offsets);
+}
+
+void CompressedStoreWriter::add_bars(const std::string& symbol, const std::vector<BarData>& bars) {
+    for (std::size_t i = 1; i < bars.size(); ++i) {
+        if (bars[i].timestamp < bars[i - 1].timestamp) {
+            throw std::invalid_argument("Bars must be sorted by timestamp: " + symbol);
+        }
+    }
+    add_bars(symbol, BarSeries::from_bars(bars, intern_symbol(symbol)).view());
+}
+
+void CompressedStoreWriter::add_trades(const std::string& symbol, const std::vector<Trade>& trades) {
+    SymbolEntry entry = make_entry(symbol, SeriesKind::TRADES);
+    for (std::size_t i = 1; i < trades.size(); ++i) {
+        if (trades[i].timestamp < trades[i - 1].timestamp) {
+            throw std::invalid_argument("Trades must be sorted by timestamp: " + symbol);
+        }
+    }
+
+    entry.record_count = trades.size();
+    if (!trades.empty()) {
+        entry.first_timestamp = trades.front().timestamp;
+        entry.last_timestamp = trades.back().timestamp;
+    }
+
+    std::vector<std::uint64_t> offsets;
+    std::vector<std::uint8_t> block;
+    for (std::size_t first = 0; first < trades.size(); first += block_size_) {
+        block.clear();
+        compressed_store::encode_trade_block(trades.data() + first,
+                                             std::min(block_size_, trades.size() - first), block);
+        write_block(block, offsets);
+    }
+    commit_entry(entry, offsets);
+}
+
+void CompressedStoreWriter::finish() {
+    if (finished_) {
+        return;
+    }
+    finished_ = true;
+
+    std::uint64_t directory_offset = position_;
+    if (!entries_.empty()) {
+        out_.write(reinterpret_cast<const char*>(entries_.data()),
+                   static_cast<std::streamsize>(entries_.size() * sizeof(SymbolEntry)));
+    }
+
+    compressed_store::Header header{};
+    std::memcpy(header.magic, compressed_store::kMagic, sizeof(header.magic));
+    header.version = compressed_store::kVersion;
+    header.entry_count = static_cast<std::uint32_t>(entries_.size());
+    header.record_count = record_count_;
+    header.directory_offset = directory_offset;
+    copy_fixed(header.timeframe, compressed_store::kTimeframeLength, timeframe_, "Timeframe");
+
+    out_.seekp(0);
+    out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out_.close();
+    if (!out_) {
+        throw std::runtime_error("Failed to write compressed store");
+    }
+}
+
+// ---------------------------------------------------------------------------
+// CompressedStore
+// ---------------------------------------------------------------------------
+
+CompressedStore::CompressedStore(const std::string& path)
+    : file_(std::make_shared<const utils::MappedFile>(path)) {
+    if (file_->size() < sizeof(compressed_store::Header)) {
+        throw std::runtime_error("Compressed store too small: " + path);
+    }
+
+    header_ = reinterpret_cast<const compressed_store::Header*>(file_->data());
+    if (std::memcmp(header_->magic, compressed_store::kMagic, sizeof(header_->magic)) != 0) {
+        throw std::runtime_error("Not a compressed store file: " + path);
+    }
+    if (header_->version != compressed_store::kVersion) {
+        throw std::runtime_error("Unsupported compressed store version: " + path);
+    }
+
+    std::uint64_t directory_end = header_->directory_offset +
+        static_cast<std::uint64_t>(header_->entry_count) * sizeof(SymbolEntry);
+    if (directory_end > file_->size()) {
+        throw std::runtime_error("Corrupted compressed store directory: " + path);
+    }
+
+    directory_ = reinterpret_cast<const SymbolEntry*>(file_->data() + header_->directory_offset);
+    timeframe_ = read_fixed(header_->timeframe, compressed_store::kTimeframeLength);
+
+    for (std::uint32_t i = 0; i < header_->entry_count; ++i) {
+        const auto& entry = directory_[i];
+        if (entry.block_table_offset + entry.block_count * sizeof(std::uint64_t) > file_->size()) {
+            throw std::runtime_error("Corrupted compressed store entry: " + path);
+        }
+        entry_index_.emplace(std::make_pair(read_fixed(entry.symbol, compressed_store::kSymbolLength), entry.kind), i);
+    }
+}
+
+const SymbolEntry* CompressedStore::find_entry(const std::string& symbol, SeriesKind kind) const {
+    auto it = entry_index_.find({symbol, kind});
+    if (it == entry_index_.end()) {
+        return nullptr;
+    }
+    return &directory_[it->second];
+}
+
+bool CompressedStore::has_bars(const std::string& symbol) const {
+    return find_entry(symbol, SeriesKind::BARS) != nullptr;
+}
+
+bool CompressedStore::has_trades(const std::string& symbol) const {
+    return find_entry(symbol, SeriesKind::TRADES) != nullptr;
+}
+
+std::vector<std::string> CompressedStore::symbols() const {
+    std::vector<std::string> names;
+    for (const auto& item : entry_index_) {
+        if (names.empty() || names.back() != item.first.first) {
+            names.push_back(item.first.first);
+        }
+    }
+    return names;
+}
+
+void CompressedStore::for_each_bar_block(const std::string& symbol, Timestamp start_time, Timestamp end_time,
+                                         const std::function<void(const BarSeriesView&)>& callback) const {
+    const auto* entry = find_entry(symbol, SeriesKind::BARS);
+    if (!entry) {
+        return;
+    }
+    SymbolId id = intern_symbol(symbol);
+    auto blocks = block_range(*file_, *entry, start_time, end_time);
+
+    // 各块复用同一组列缓冲区
+    DecodedColumns columns;
+    for (std::size_t b = blocks.first; b < blocks.second; ++b) {
+        const auto& header = block_at(*file_, *entry, b);
+        columns.reserve(header.record_count);
+        columns.decode(header, payload_of(header), 0);
+        auto view = columns.view(id, header.record_count, start_time, end_time);
+        if (!view.empty()) {
+            callback(view);
+        }
+    }
+}
+
+void CompressedStore::for_each_trade_block(const std::string& symbol, Timestamp start_time, Timestamp end_time,
+                                           const std::function<void(const std::vector<Trade>&)>& callback) const {
+    const auto* entry = find_entry(symbol, SeriesKind::TRADES);
+    if (!entry) {
+        return;
+    }
+    SymbolId id = intern_symbol(symbol);
+    auto blocks = block_range(*file_, *entry, start_time, end_time);
+
+    std::vector<Trade> trades;
+    for (std::size_t b = blocks.first; b < blocks.second; ++b) {
+        const auto& header = block_at(*file_, *entry, b);
+        trades.clear();
+        compressed_store::decode_trade_block(header, payload_of(header), id, trades);
+        // 只有首尾两块可能越出查询区间
+        if (header.min_timestamp < start_time || header.max_timestamp > end_time) {
+            trades.erase(std::remove_if(trades.begin(), trades.end(), [&](const Trade& trade) {
+                return trade.timestamp < start_time || trade.timestamp > end_time;
+            }), trades.end());
+        }
+        if (!trades.empty()) {
+            callback(trades);
+        }
+    }
+}
+
+std::vector<Trade> CompressedStore::get_trades(const std::string& symbol, Timestamp start_time, Timestamp end_time) const {
+    std::vector<Trade> result;
+    for_each_trade_block(symbol, start_time, end_time, [&result](const std::vector<Trade>& trades) {
+        result.insert(result.end(), trades.begin(), trades.end());
+    });
+    return result;
+}
+
+std::unique_ptr<BarChunkSource> CompressedStore::open_stream(const std::string& symbol,
+                                                             Timestamp start_time, Timestamp end_time) const {
+    return std::make_unique<CompressedBarChunkSource>(
+        file_, find_entry(symbol, SeriesKind::BARS), intern_symbol(symbol), start_time, end_time);
+}
+
+std::vector<BarData> CompressedStore::get_historical_bars(
+    const std::string& symbol,
+    const Timestamp& start_time,
+    const Timestamp& end_time,
+    const std::string& timeframe) {
+    return get_bar_series(symbol, start_time, end_time, timeframe).to_bars();
+}
+
+BarSeries CompressedStore::get_bar_series(
+    const std::string& symbol,
+    const Timestamp& start_time,
+    const Timestamp& end_time,
+    const std::string& timeframe) {
+
+    if (!timeframe.empty() && timeframe != timeframe_) {
+        throw std::invalid_argument("Compressed store holds " + timeframe_ + " bars, requested " + timeframe);
+    }
+
+    SymbolId id = intern_symbol(symbol);
+    const auto* entry = find_entry(symbol, SeriesKind::BARS);
+    if (!entry) {
+        return BarSeries::from_bars({}, id);
+    }
+    auto blocks = block_range(*file_, *entry, start_time, end_time);
+
+    // 先汇总记录数一次分配，再把各块直接解码到最终的列中
+    std::size_t total = 0;
+    for (std::size_t b = blocks.first; b < blocks.second; ++b) {
+        total += block_at(*file_, *entry, b).record_count;
+    }
+    if (total == 0) {
+        return BarSeries::from_bars({}, id);
+    }
+
+    auto columns = std::make_shared<DecodedColumns>();
+    columns->reserve(total);
+    std::size_t offset = 0;
+    for (std::size_t b = blocks.first; b < blocks.second; ++b) {
+        const auto& header = block_at(*file_, *entry, b);
+        columns->decode(header, payload_of(header), offset);
+        offset += header.record_count;
+    }
+    auto view = columns->view(id, total, start_time, end_time);
+    return BarSeries(view, std::move(columns));
+}
+
+void CompressedStore::subscribe_market_data(
+    const std::string& symbol,
+    std::function<void(const MarketData&)> /*callback*/) {
+    throw std::runtime_error("CompressedStore does not support real-time data: " + symbol);
+}
+
+void CompressedStore::unsubscribe_market_data(const std::string& symbol) {
+    throw std::runtime_error("CompressedStore does not support real-time data: " + symbol);
+}
+
+} // namespace data
+} // namespace quant
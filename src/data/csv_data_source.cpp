@@ -0,0 +1,652 @@
+#include "data/csv_data_source.hpp"
+#include "utils/bit_stream.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+namespace quant {
+namespace data {
+
+namespace csv {
+
+namespace {
+
+constexpr double kPowersOfTen[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+inline bool is_digit(char c) {
+    return static_cast<unsigned char>(c - '0') < 10;
+}
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define QUANT_CSV_SWAR 1
+
+inline std::uint64_t load8(const char* p) {
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// 判断8个字节是否全为数字
+inline bool is_eight_digits(std::uint64_t v) {
+    return (((v & 0xF0F0F0F0F0F0F0F0ULL) |
+             (((v + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+            0x3333333333333333ULL);
+}
+
+// 一次把8个ASCII数字转换为整数（小端序）
+inline std::uint32_t parse_eight_digits(std::uint64_t v) {
+    constexpr std::uint64_t mask = 0x000000FF000000FFULL;
+    constexpr std::uint64_t mul1 = 0x000F424000000064ULL;  // 100 + (1000000ULL << 32)
+    constexpr std::uint64_t mul2 = 0x0000271000000001ULL;  // 1 + (10000ULL << 32)
+    v -= 0x3030303030303030ULL;
+    v = (v * 10) + (v >> 8);
+    v = (((v & mask) * mul1) + (((v >> 16) & mask) * mul2)) >> 32;
+    return static_cast<std::uint32_t>(v);
+}
+#endif
+
+constexpr std::uint64_t kPowersOfTenInt[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL
+};
+
+// 累加连续数字，返回读取的位数；位数超过19时只计数不累加
+// Padded为true时调用方保证last之后仍有8字节可读，可用SWAR一次处理1~8位数字
+template <bool Padded>
+inline int accumulate_digits(const char*& p, const char* last, std::uint64_t& value, int digits) {
+    int count = 0;
+#ifdef QUANT_CSV_SWAR
+    if (Padded) {
+        while (p < last) {
+            std::uint64_t chunk = load8(p);
+            std::uint64_t x = chunk ^ 0x3030303030303030ULL;
+            // 非数字字节的最高位置1
+            std::uint64_t non_digit = (((x & 0x7F7F7F7F7F7F7F7FULL) + 0x7676767676767676ULL) | x) &
+                                      0x8080808080808080ULL;
+            int n = non_digit ? static_cast<int>(utils::count_trailing_zeros(non_digit) >> 3) : 8;
+            n = static_cast<int>(std::min<std::ptrdiff_t>(n, last - p));
+            if (n == 0) {
+                break;
+            }
+            if (digits + count + n <= 19) {
+                // 左移对齐后在高位补'0'，转换为8位数字
+                std::uint64_t aligned = n == 8
+                    ? chunk
+                    : (chunk << (8 * (8 - n))) | (0x3030303030303030ULL >> (8 * n));
+                value = value * kPowersOfTenInt[n] + parse_eight_digits(aligned);
+            }
+            p += n;
+            count += n;
+            if (n < 8) {
+                break;
+            }
+        }
+        return count;
+    }
+    while (last - p >= 8 && digits + count + 8 <= 19) {
+        std::uint64_t chunk = load8(p);
+        if (!is_eight_digits(chunk)) {
+            break;
+        }
+        value = value * 100000000ULL + parse_eight_digits(chunk);
+        p += 8;
+        count += 8;
+    }
+#endif
+    while (p < last && is_digit(*p)) {
+        if (digits + count < 19) {
+            value = value * 10 + static_cast<std::uint64_t>(*p - '0');
+        }
+        ++p;
+        ++count;
+    }
+    return count;
+}
+
+bool strtod_fallback(const char* first, const char* last, double& value) {
+    char local[64];
+    std::unique_ptr<char[]> heap;
+    std::size_t length = static_cast<std::size_t>(last - first);
+    char* text = local;
+    if (length >= sizeof(local)) {
+        heap.reset(new char[length + 1]);
+        text = heap.get();
+    }
+    std::memcpy(text, first, length);
+    text[length] = '\0';
+
+    char* end = nullptr;
+    value = std::strtod(text, &end);
+    return end == text + length && length > 0;
+}
+
+inline void trim(const char*& first, const char*& last) {
+    while (first < last && (*first == ' ' || *first == '"')) {
+        ++first;
+    }
+    while (last > first && (last[-1] == ' ' || last[-1] == '"' || last[-1] == '\r')) {
+        --last;
+    }
+}
+
+inline bool parse_fixed_int(const char* p, int width, int& value) {
+    value = 0;
+    for (int i = 0; i < width; ++i) {
+        if (!is_digit(p[i])) {
+            return false;
+        }
+        value = value * 10 + (p[i] - '0');
+    }
+    return true;
+}
+
+// 公历日期到Unix纪元天数（Howard Hinnant算法）
+inline std::int64_t days_from_civil(std::int64_t y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const std::int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<std::int64_t>(doe) - 719468;
+}
+
+bool parse_iso8601(const char* p, const char* last, Timestamp& value) {
+    int year, month, day;
+    if (last - p < 10 || p[4] != '-' || p[7] != '-' ||
+        !parse_fixed_int(p, 4, year) || !parse_fixed_int(p + 5, 2, month) ||
+        !parse_fixed_int(p + 8, 2, day) || month < 1 || month > 12 || day < 1 || day > 31) {
+        return false;
+    }
+    p += 10;
+
+    int hour = 0, minute = 0, second = 0;
+    if (p < last && (*p == ' ' || *p == 'T')) {
+        ++p;
+        if (last - p < 5 || p[2] != ':' || !parse_fixed_int(p, 2, hour) || !parse_fixed_int(p + 3, 2, minute)) {
+            return false;
+        }
+        p += 5;
+        if (p < last && *p == ':') {
+            if (last - p < 3 || !parse_fixed_int(p + 1, 2, second)) {
+                return false;
+            }
+            p += 3;
+        }
+        // 忽略小数秒
+        if (p < last && *p == '.') {
+            ++p;
+            while (p < last && is_digit(*p)) {
+                ++p;
+            }
+        }
+        if (p < last && *p == 'Z') {
+            ++p;
+        }
+    }
+    if (p != last) {
+        return false;
+    }
+
+    value = static_cast<Timestamp>(
+        days_from_civil(year, static_cast<unsigned>(month), static_cast<unsigned>(day)) * 86400 +
+        hour * 3600 + minute * 60 + second);
+    return true;
+}
+
+
+template <bool Padded>
+bool parse_double_impl(const char* first, const char* last, double& value) {
+    trim(first, last);
+    const char* p = first;
+    bool negative = false;
+    if (p < last && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        ++p;
+    }
+
+    std::uint64_t mantissa = 0;
+    int digits = accumulate_digits<Padded>(p, last, mantissa, 0);
+    int fraction_digits = 0;
+    if (p < last && *p == '.') {
+        ++p;
+        fraction_digits = accumulate_digits<Padded>(p, last, mantissa, digits);
+        digits += fraction_digits;
+    }
+
+    if (digits == 0) {
+        return strtod_fallback(first, last, value);  // 例如 "nan"、"inf"
+    }
+    if (p != last || digits > 15 || fraction_digits > 22) {
+        // 指数形式或超出快速路径精度范围，交给strtod保证正确舍入
+        return strtod_fallback(first, last, value);
+    }
+
+    // mantissa < 2^53 且 10^k 可精确表示，一次除法即为正确舍入结果
+    double result = static_cast<double>(mantissa) / kPowersOfTen[fraction_digits];
+    value = negative ? -result : result;
+    return true;
+}
+
+template <bool Padded>
+bool parse_timestamp_impl(const char* first, const char* last, TimestampUnit unit, Timestamp& value) {
+    trim(first, last);
+    if (first == last) {
+        return false;
+    }
+    if (unit == TimestampUnit::ISO8601) {
+        return parse_iso8601(first, last, value);
+    }
+
+    const char* p = first;
+    bool negative = false;
+    if (*p == '-') {
+        negative = true;
+        ++p;
+    }
+    std::uint64_t integer = 0;
+    int digits = accumulate_digits<Padded>(p, last, integer, 0);
+    if (digits == 0 || digits > 19) {
+        return false;
+    }
+    // 允许带小数部分的时间戳，小数部分截断
+    if (p < last && *p == '.') {
+        ++p;
+        while (p < last && is_digit(*p)) {
+            ++p;
+        }
+    }
+    if (p != last) {
+        return false;
+    }
+
+    auto signed_value = static_cast<std::int64_t>(integer);
+    if (unit == TimestampUnit::MILLISECONDS) {
+        signed_value /= 1000;
+    }
+    value = static_cast<Timestamp>(negative ? -signed_value : signed_value);
+    return true;
+}
+
+} // namespace
+
+bool parse_double(const char* first, const char* last, double& value) {
+    return parse_double_impl<false>(first, last, value);
+}
+
+bool parse_timestamp(const char* first, const char* last, TimestampUnit unit, Timestamp& value) {
+    return parse_timestamp_impl<false>(first, last, unit, value);
+}
+
+} // namespace csv
+
+namespace {
+
+constexpr int kMaxFields = 32;
+
+struct ColumnMap {
+    int timestamp;
+    int symbol;
+    int open;
+    int high;
+    int low;
+    int close;
+    int volume;
+
+    int max_column() const {
+        return std::max({timestamp, symbol, open, high, low, close, volume});
+    }
+};
+
+struct Field {
+    const char* first;
+    const char* last;
+};
+
+// [p, end)中第一个分隔符的位置，没有时返回end。
+// 字段通常很短，逐个调用memchr的开销比扫描本身还大；调用方保证end之后仍有8字节可读
+inline const char* find_delimiter(const char* p, const char* end, char delimiter) {
+#ifdef QUANT_CSV_SWAR
+    const std::uint64_t pattern = 0x0101010101010101ULL * static_cast<unsigned char>(delimiter);
+    while (p < end) {
+        std::uint64_t x = csv::load8(p) ^ pattern;
+        // 等于分隔符的字节的最高位置1
+        std::uint64_t found = (x - 0x0101010101010101ULL) & ~x & 0x8080808080808080ULL;
+        if (found) {
+            return std::min(end, p + (utils::count_trailing_zeros(found) >> 3));
+        }
+        p += 8;
+    }
+    return end;
+#else
+    while (p < end && *p != delimiter) {
+        ++p;
+    }
+    return p;
+#endif
+}
+
+// 按分隔符切分一行，只切到所需的最大列
+int split_fields(const char* line, const char* end, char delimiter, int max_column, Field* fields) {
+    int count = 0;
+    const char* p = line;
+    while (count <= max_column) {
+        const char* next = find_delimiter(p, end, delimiter);
+        fields[count++] = {p, next};
+        if (next == end) {
+            break;
+        }
+        p = next + 1;
+    }
+    return count;
+}
+
+std::string lower_trimmed(const Field& field) {
+    const char* first = field.first;
+    const char* last = field.last;
+    while (first < last && (*first == ' ' || *first == '"' || *first == '\xEF' || *first == '\xBB' || *first == '\xBF')) {
+        ++first;
+    }
+    while (last > first && (last[-1] == ' ' || last[-1] == '"' || last[-1] == '\r')) {
+        --last;
+    }
+    std::string name(first, last);
+    std::transform(name.begin(), name.end(), name.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return name;
+}
+
+// 根据表头识别列位置；无法识别时沿用格式配置
+ColumnMap resolve_header(const char* line, const char* end, const CsvFormat& format, const ColumnMap& fallback) {
+    Field fields[kMaxFields];
+    int count = split_fields(line, end, format.delimiter, kMaxFields - 1, fields);
+
+    ColumnMap map{-1, -1, -1, -1, -1, -1, -1};
+    bool recognized = false;
+    for (int i = 0; i < count; ++i) {
+        std::string name = lower_trimmed(fields[i]);
+        int* target = nullptr;
+        if (name == "timestamp" || name == "time" || name == "datetime" || name == "date" || name == "ts") {
+            target = &map.timestamp;
+        } else if (name == "symbol" || name == "ticker" || name == "code" || name == "instrument") {
+            target = &map.symbol;
+        } else if (name == "open" || name == "o") {
+            target = &map.open;
+        } else if (name == "high" || name == "h") {
+            target = &map.high;
+        } else if (name == "low" || name == "l") {
+            target = &map.low;
+        } else if (name == "close" || name == "c") {
+            target = &map.close;
+        } else if (name == "volume" || name == "vol" || name == "v") {
+            target = &map.volume;
+        }
+        if (target && *target < 0) {
+            *target = i;
+            recognized = true;
+        }
+    }
+
+    if (!recognized) {
+        return fallback;
+    }
+    if (map.timestamp < 0 || map.close < 0) {
+        throw std::runtime_error("CSV header must contain timestamp and close columns");
+    }
+    return map;
+}
+
+struct FileCloser {
+    void operator()(std::FILE* file) const {
+        if (file) {
+            std::fclose(file);
+        }
+    }
+};
+
+} // namespace
+
+CsvDataSource::CsvDataSource(
+    std::string path,
+    CsvFormat format,
+    std::string timeframe,
+    std::size_t chunk_size)
+    : path_(std::move(path)),
+      format_(std::move(format)),
+      timeframe_(std::move(timeframe)),
+      chunk_size_(std::max<std::size_t>(chunk_size, 4096)) {
+    if (format_.timestamp_column < 0 || format_.close_column < 0) {
+        throw std::invalid_argument("CSV format must define timestamp and close columns");
+    }
+    if (format_.symbol_column < 0 && format_.default_symbol.empty() && !format_.has_header) {
+        throw std::invalid_argument("CSV format without symbol column requires default_symbol");
+    }
+}
+
+CsvScanStats CsvDataSource::for_each_bar(
+    const std::string& symbol,
+    Timestamp start_time,
+    Timestamp end_time,
+    const BarCallback& callback) const {
+
+    CsvScanStats stats;
+    std::unique_ptr<std::FILE, FileCloser> file(std::fopen(path_.c_str(), "rb"));
+    if (!file) {
+        throw std::runtime_error("Cannot open CSV file: " + path_);
+    }
+
+    ColumnMap columns{
+        format_.timestamp_column, format_.symbol_column, format_.open_column,
+        format_.high_column, format_.low_column, format_.close_column, format_.volume_column
+    };
+    bool header_pending = format_.has_header;
+    int max_column = columns.max_column();
+    if (max_column >= kMaxFields) {
+        throw std::invalid_argument("CSV format uses too many columns");
+    }
+
+    // 复用同一个BarData对象，避免逐行分配
+    BarData bar{};
+    bool symbol_fixed = false;
+    // 本地缓存：键为品种表中的字符串视图，查找时不构造字符串
+    std::unordered_map<std::string_view, SymbolId> symbol_cache;
+    bool stop = false;
+    // 无symbol列时整个文件属于default_symbol，请求其他品种可直接结束。
+    // 有表头时列位置以表头为准，读到表头后才能判断
+    auto configure_symbol = [&]() {
+        if (columns.symbol < 0) {
+            if (format_.default_symbol.empty()) {
+                throw std::runtime_error("CSV file without symbol column requires default_symbol: " + path_);
+            }
+            bar.symbol = intern_symbol(format_.default_symbol);
+            symbol_fixed = true;
+            stop = !symbol.empty() && symbol != format_.default_symbol;
+        } else if (!symbol.empty()) {
+            bar.symbol = intern_symbol(symbol);
+            symbol_fixed = true;
+        }
+    };
+    if (!header_pending) {
+        configure_symbol();
+        if (stop) {
+            return stats;
+        }
+    }
+
+    Field fields[kMaxFields];
+
+    auto process_line = [&](const char* line, const char* end) {
+        if (end > line && end[-1] == '\r') {
+            --end;
+        }
+        if (end == line) {
+            return;
+        }
+        if (header_pending) {
+            header_pending = false;
+            columns = resolve_header(line, end, format_, columns);
+            max_column = columns.max_column();
+            configure_symbol();
+            return;
+        }
+        ++stats.lines;
+
+        int count = split_fields(line, end, format_.delimiter, max_column, fields);
+        if (count <= max_column) {
+            ++stats.malformed_lines;
+            return;
+        }
+
+        // 先比较品种与时间，未命中的行不解析价格
+        if (columns.symbol >= 0 && !symbol.empty()) {
+            const Field& f = fields[columns.symbol];
+            const char* first = f.first;
+            const char* last = f.last;
+            while (first < last && (*first == ' ' || *first == '"')) ++first;
+            while (last > first && (last[-1] == ' ' || last[-1] == '"')) --last;
+            if (static_cast<std::size_t>(last - first) != symbol.size() ||
+                std::memcmp(first, symbol.data(), symbol.size()) != 0) {
+                return;
+            }
+        }
+
+        Timestamp timestamp;
+        const Field& tf = fields[columns.timestamp];
+        if (!csv::parse_timestamp_impl<true>(tf.first, tf.last, format_.timestamp_unit, timestamp)) {
+            ++stats.malformed_lines;
+            return;
+        }
+        if (timestamp < start_time) {
+            return;
+        }
+        if (timestamp > end_time) {
+            stop = format_.sorted_by_time;
+            return;
+        }
+
+        auto parse_column = [&](int column, double& out, double fallback) {
+            if (column < 0) {
+                out = fallback;
+                return true;
+            }
+            return csv::parse_double_impl<true>(fields[column].first, fields[column].last, out);
+        };
+
+        bar.timestamp = timestamp;
+        if (!parse_column(columns.close, bar.close, 0.0) ||
+            !parse_column(columns.open, bar.open, bar.close) ||
+            !parse_column(columns.high, bar.high, bar.close) ||
+            !parse_column(columns.low, bar.low, bar.close) ||
+            !parse_column(columns.volume, bar.volume, 0.0)) {
+            ++stats.malformed_lines;
+            return;
+        }
+        if (!symbol_fixed) {
+            const Field& f = fields[columns.symbol];
+            const char* first = f.first;
+            const char* last = f.last;
+            while (first < last && (*first == ' ' || *first == '"')) ++first;
+            while (last > first && (last[-1] == ' ' || last[-1] == '"')) --last;
+            std::string_view name(first, static_cast<std::size_t>(last - first));
+            auto it = symbol_cache.find(name);
+            if (it == symbol_cache.end()) {
+                SymbolId id = intern_symbol(name);
+                it = symbol_cache.emplace(std::string_view(symbol_name(id)), id).first;
+            }
+            bar.symbol = it->second;
+        }
+
+        ++stats.bars_matched;
+        callback(bar);
+    };
+
+    // 分块读取：每块处理完整行，残余的半行移到缓冲区头部与下一块拼接
+    // 末尾预留换行符与SWAR越界读取所需的填充字节
+    constexpr std::size_t kSlack = 1 + 8;
+    std::vector<char> buffer(chunk_size_ + kSlack);
+    std::size_t filled = 0;
+    bool eof = false;
+    while (!eof && !stop) {
+        if (filled + kSlack >= buffer.size()) {
+            // 单行长于缓冲区
+            buffer.resize(buffer.size() * 2);
+        }
+        std::size_t n = std::fread(buffer.data() + filled, 1, buffer.size() - kSlack - filled, file.get());
+        stats.bytes_read += n;
+        filled += n;
+        if (n == 0) {
+            eof = true;
+            if (filled == 0) {
+                break;
+            }
+            if (buffer[filled - 1] != '\n') {
+                buffer[filled++] = '\n';
+            }
+        }
+
+        const char* begin = buffer.data();
+        const char* end = begin + filled;
+        const char* line = begin;
+        while (line < end && !stop) {
+            const char* newline = static_cast<const char*>(
+                std::memchr(line, '\n', static_cast<std::size_t>(end - line)));
+            if (!newline) {
+                break;
+            }
+            process_line(line, newline);
+            line = newline + 1;
+        }
+
+        std::size_t consumed = static_cast<std::size_t>(line - begin);
+        std::memmove(buffer.data(), line, filled - consumed);
+        filled -= consumed;
+    }
+
+    return stats;
+}
+
+std::vector<BarData> CsvDataSource::get_historical_bars(
+    const std::string& symbol,
+    const Timestamp& start_time,
+    const Timestamp& end_time,
+    const std::string& timeframe) {
+    return get_bar_series(symbol, start_time, end_time, timeframe).to_bars();
+}
+
+BarSeries CsvDataSource::get_bar_series(
+    const std::string& symbol,
+    const Timestamp& start_time,
+    const Timestamp& end_time,
+    const std::string& timeframe) {
+
+    if (!timeframe_.empty() && !timeframe.empty() && timeframe != timeframe_) {
+        throw std::invalid_argument("CSV source holds " + timeframe_ + " bars, requested " + timeframe);
+    }
+
+    // 未按时间排序的文件由builder在构建时排序
+    BarSeriesBuilder builder(intern_symbol(symbol));
+    for_each_bar(symbol, start_time, end_time, [&builder](const BarData& bar) {
+        builder.push_back(bar);
+    });
+    return builder.build();
+}
+
+void CsvDataSource::subscribe_market_data(
+    const std::string& symbol,
+    std::function<void(const MarketData&)> /*callback*/) {
+    throw std::runtime_error("CsvDataSource does not support real-time data: " + symbol);
+}
+
+void CsvDataSource::unsubscribe_market_data(const std::string& symbol) {
+    throw std::runtime_error("CsvDataSource does not support real-time data: " + symbol);
+}
+
+} // namespace data
+} // namespace quant
@@ -1,10 +1,23 @@
 #include "data/data_feed.hpp"
 #include <algorithm>
+#include <memory>
 #include <stdexcept>
 
 namespace quant {
 namespace data {
 
+BarSeries DataSource::get_bar_series(
+    const std::string& symbol,
+    const Timestamp& start_time,
+    const Timestamp& end_time,
+    const std::string& timeframe) {
+    return BarSeries::from_bars(
+        get_historical_bars(symbol, start_time, end_time, timeframe),
+        intern_symbol(symbol));
+}
+
+DataFeed::~DataFeed() = default;
+
 void DataFeed::add_data_source(std::shared_ptr<DataSource> source) {
     if (source) {
         data_sources_.push_back(source);
@@ -17,18 +30,62 @@ std::vector<BarData> DataFeed::get_historical_bars(
     const Timestamp& end_time,
     const std::string& timeframe) {
     
-    // 如果有特定的数据源映射，使用它
-    auto it = symbol_to_source_.find(symbol);
-    if (it != symbol_to_source_.end() && it->second) {
-        return it->second->get_historical_bars(symbol, start_time, end_time, timeframe);
+    if (data_sources_.empty()) {
+        return {};
     }
+    return get_bar_series(symbol, start_time, end_time, timeframe).to_bars();
+}
+
+BarSeries DataFeed::get_bar_series(
+    const std::string& symbol,
+    const Timestamp& start_time,
+    const Timestamp& end_time,
+    const std::string& timeframe) {
     
-    // 否则尝试所有数据源
+    // 先查缓存，完全覆盖时不再访问数据源
+    auto cache = std::atomic_load(&cache_);
+    SymbolId symbol_id = intern_symbol(symbol);
+    BarSeries series;
+    if (cache && cache->lookup(symbol_id, timeframe, start_time, end_time, series)) {
+        return series;
+    }
+    
+    auto loaded = load_bar_series(symbol, start_time, end_time, timeframe);
+    if (!loaded) {
+        // 没有数据源给出结果，不写入缓存，以免暂时的错误遮住之后能取到的数据
+        return BarSeries::from_bars({}, symbol_id);
+    }
+    if (cache) {
+        cache->insert(symbol_id, timeframe, start_time, end_time, *loaded);
+    }
+    return std::move(*loaded);
+}
+
+std::optional<BarSeries> DataFeed::load_bar_series(
+    const std::string& symbol,
+    const Timestamp& start_time,
+    const Timestamp& end_time,
+    const std::string& timeframe) {
+    
+    // 没有注册数据源时退回到（可能被子类重写的）get_historical_bars
+    if (data_sources_.empty()) {
+        return BarSeries::from_bars(
+            get_historical_bars(symbol, start_time, end_time, timeframe),
+            intern_symbol(symbol));
+    }
+    
+    // 如果已知拥有该品种的数据源，直接使用它
+    if (auto source = find_source(symbol)) {
+        return source->get_bar_series(symbol, start_time, end_time, timeframe);
+    }
+    
+    // 否则尝试所有数据源，并记住第一个返回数据的数据源
     for (auto& source : data_sources_) {
         try {
-            auto bars = source->get_historical_bars(symbol, start_time, end_time, timeframe);
-            if (!bars.empty()) {
-                return bars;
+            auto series = source->get_bar_series(symbol, start_time, end_time, timeframe);
+            if (!series.empty()) {
+                remember_source(symbol, source);
+                return series;
             }
         } catch (const std::exception&) {
             // 忽略错误，尝试下一个数据源
@@ -36,7 +93,7 @@ std::vector<BarData> DataFeed::get_historical_bars(
     }
     
     // 没有找到数据
-    return {};
+    return std::nullopt;
 }
 
 void DataFeed::subscribe_market_data(
@@ -44,9 +101,8 @@ void DataFeed::subscribe_market_data(
     std::function<void(const MarketData&)> callback) {
     
     // 如果有特定的数据源映射，使用它
-    auto it = symbol_to_source_.find(symbol);
-    if (it != symbol_to_source_.end() && it->second) {
-        it->second->subscribe_market_data(symbol, callback);
+    if (auto source = find_source(symbol)) {
+        source->subscribe_market_data(symbol, callback);
         return;
     }
     
@@ -54,6 +110,7 @@ void DataFeed::subscribe_market_data(
     for (auto& source : data_sources_) {
         try {
             source->subscribe_market_data(symbol, callback);
+            remember_source(symbol, source);
             return;
         } catch (const std::exception&) {
             // 忽略错误，尝试下一个数据源
@@ -63,9 +120,8 @@ void DataFeed::subscribe_market_data(
 
 void DataFeed::unsubscribe_market_data(const std::string& symbol) {
     // 如果有特定的数据源映射，使用它
-    auto it = symbol_to_source_.find(symbol);
-    if (it != symbol_to_source_.end() && it->second) {
-        it->second->unsubscribe_market_data(symbol);
+    if (auto source = find_source(symbol)) {
+        source->unsubscribe_market_data(symbol);
         return;
     }
     
@@ -79,5 +135,263 @@ void DataFeed::unsubscribe_market_data(const std::string& symbol) {
     }
 }
 
+void DataFeed::set_cache_budget(std::size_t bytes) {
+    auto cache = std::atomic_load(&cache_);
+    if (bytes == 0) {
+        std::atomic_store(&cache_, std::shared_ptr<BarCache>());
+    } else if (cache) {
+        cache->set_budget(bytes);
+    } else {
+        std::atomic_store(&cache_, std::make_shared<BarCache>(bytes));
+    }
+}
+
+void DataFeed::clear_cache() {
+    if (auto cache = std::atomic_load(&cache_)) {
+        cache->clear();
+    }
+}
+
+BarCacheStats DataFeed::cache_stats() const {
+    auto cache = std::atomic_load(&cache_);
+    return cache ? cache->stats() : BarCacheStats();
+}
+
+std::shared_ptr<DataSource> DataFeed::find_source(const std::string& symbol) const {
+    std::lock_guard<std::mutex> lock(source_mutex_);
+    auto it = symbol_to_source_.find(symbol);
+    return it != symbol_to_source_.end() ? it->second : nullptr;
+}
+
+void DataFeed::remember_source(const std::string& symbol, const std::shared_ptr<DataSource>& source) {
+    std::lock_guard<std::mutex> lock(source_mutex_);
+    symbol_to_source_.emplace(symbol, source);
+}
+
+// ---------------------------------------------------------------------------
+// 异步批量获取
+// ---------------------------------------------------------------------------
+
+// 单个请求的获取状态，由各次尝试共享
+struct DataFeed::FetchState {
+    std::mutex mutex;
+    FetchRequest request;
+    SymbolId symbol;
+    FetchOptions options;
+    std::vector<std::shared_ptr<DataSource>> candidates;  // 按优先级排列的候选数据源
+    std::size_t next = 0;         // 下一个待尝试的候选
+    std::size_t outstanding = 0;  // 进行中的尝试数
+    bool done = false;
+    std::function<void(BarSeries)> completion;
+};
+
+std::vector<std::future<BarSeries>> DataFeed::fetch_bar_series_async(
+    const std::vector<FetchRequest>& requests,
+    const FetchOptions& options) {
+    
+    std::vector<std::future<BarSeries>> futures;
+    futures.reserve(requests.size());
+    for (const auto& request : requests) {
+        auto promise = std::make_shared<std::promise<BarSeries>>();
+        futures.push_back(promise->get_future());
+        start_fetch(request, options, [promise](BarSeries series) {
+            promise->set_value(std::move(series));
+        });
+    }
+    return futures;
+}
+
+std::future<void> DataFeed::fetch_bar_series_async(
+    const std::vector<FetchRequest>& requests,
+    std::function<void(std::size_t, BarSeries)> on_complete,
+    const FetchOptions& options) {
+    
+    struct Batch {
+        std::mutex mutex;
+        std::size_t remaining;
+        std::exception_ptr error;
+        std::promise<void> promise;
+        std::function<void(std::size_t, BarSeries)> on_complete;
+    };
+    auto batch = std::make_shared<Batch>();
+    batch->remaining = requests.size();
+    batch->on_complete = std::move(on_complete);
+    auto future = batch->promise.get_future();
+    if (requests.empty()) {
+        batch->promise.set_value();
+        return future;
+    }
+    
+    for (std::size_t i = 0; i < requests.size(); ++i) {
+        start_fetch(requests[i], options, [batch, i](BarSeries series) {
+            std::exception_ptr error;
+            try {
+                if (batch->on_complete) {
+                    batch->on_complete(i, std::move(series));
+                }
+            } catch (...) {
+                error = std::current_exception();
+            }
+            
+            std::lock_guard<std::mutex> lock(batch->mutex);
+            if (error && !batch->error) {
+                batch->error = error;
+            }
+            if (--batch->remaining == 0) {
+                if (batch->error) {
+                    batch->promise.set_exception(batch->error);
+                } else {
+                    batch->promise.set_value();
+                }
+            }
+        });
+    }
+    return future;
+}
+
+void DataFeed::set_fetch_threads(std::size_t threads) {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    fetch_threads_ = threads;
+}
+
+utils::ThreadPool& DataFeed::fetch_pool() {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    if (!fetch_pool_) {
+        fetch_pool_ = std::make_unique<utils::ThreadPool>(fetch_threads_);
+    }
+    return *fetch_pool_;
+}
+
+void DataFeed::start_fetch(
+    const FetchRequest& request,
+    const FetchOptions& options,
+    std::function<void(BarSeries)> completion) {
+    
+    SymbolId symbol_id = intern_symbol(request.symbol);
+    
+    // 缓存命中时直接在调用线程完成
+    auto cache = std::atomic_load(&cache_);
+    BarSeries cached;
+    if (cache && cache->lookup(symbol_id, request.timeframe, request.start_time, request.end_time, cached)) {
+        completion(std::move(cached));
+        return;
+    }
+    
+    // 没有注册数据源时在线程池上走（可能被子类重写的）同步接口
+    if (data_sources_.empty()) {
+        fetch_pool().post([this, request, completion = std::move(completion)]() {
+            BarSeries series;
+            try {
+                series = get_bar_series(request.symbol, request.start_time, request.end_time, request.timeframe);
+            } catch (const std::exception&) {
+                series = BarSeries::from_bars({}, intern_symbol(request.symbol));
+            }
+            completion(std::move(series));
+        });
+        return;
+    }
+    
+    auto state = std::make_shared<FetchState>();
+    state->request = request;
+    state->symbol = symbol_id;
+    state->options = options;
+    state->completion = std::move(completion);
+    
+    // 已知拥有该品种的数据源优先，其余按注册顺序作为后备
+    auto owner = find_source(request.symbol);
+    if (owner) {
+        state->candidates.push_back(owner);
+    }
+    for (const auto& source : data_sources_) {
+        if (source != owner) {
+            state->candidates.push_back(source);
+        }
+    }
+    
+    launch_attempt(state, 0);
+}
+
+void DataFeed::launch_attempt(const std::shared_ptr<FetchState>& state, std::size_t attempt) {
+    std::shared_ptr<DataSource> source;
+    bool schedule_hedge = false;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->done || state->next != attempt || state->next >= state->candidates.size()) {
+            return;
+        }
+        source = state->candidates[state->next++];
+        ++state->outstanding;
+        schedule_hedge = state->options.hedge_delay.count() > 0 &&
+                         state->next < state->candidates.size();
+    }
+    
+    auto& pool = fetch_pool();
+    pool.post([this, state, source]() {
+        BarSeries series;
+        try {
+            const auto& r = state->request;
+            series = source->get_bar_series(r.symbol, r.start_time, r.end_time, r.timeframe);
+        } catch (const std::exception&) {
+            // 视为无数据，交给后备数据源
+        }
+        finish_attempt(state, source, std::move(series));
+    });
+    
+    // 到期仍未完成则对冲到下一个数据源。本次尝试提前失败时下一个候选已被立即发起，
+    // 此时该定时器不再生效，对冲间隔从新发起的尝试重新计算
+    if (schedule_hedge) {
+        pool.post_after(state->options.hedge_delay, [this, state, attempt]() {
+            launch_attempt(state, attempt + 1);
+        });
+    }
+}
+
+void DataFeed::finish_attempt(
+    const std::shared_ptr<FetchState>& state,
+    const std::shared_ptr<DataSource>& source,
+    BarSeries series) {
+    
+    bool succeeded = !series.empty();
+    bool exhausted = false;
+    bool try_next = false;
+    std::size_t next_attempt = 0;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        --state->outstanding;
+        if (state->done) {
+            return;  // 已有其他尝试胜出
+        }
+        if (succeeded) {
+            state->done = true;
+        } else if (state->next < state->candidates.size()) {
+            try_next = true;
+            next_attempt = state->next;
+        } else if (state->outstanding == 0) {
+            state->done = true;
+            exhausted = true;
+        }
+    }
+    
+    if (try_next) {
+        launch_attempt(state, next_attempt);
+        return;
+    }
+    if (!succeeded && !exhausted) {
+        return;  // 仍有对冲中的尝试未结束
+    }
+    
+    const auto& r = state->request;
+    if (succeeded) {
+        remember_source(r.symbol, source);
+        if (auto cache = std::atomic_load(&cache_)) {
+            cache->insert(state->symbol, r.timeframe, r.start_time, r.end_time, series);
+        }
+    } else {
+        // 所有数据源都失败，与同步接口相同，不缓存空结果
+        series = BarSeries::from_bars({}, state->symbol);
+    }
+    state->completion(std::move(series));
+}
+
 } // namespace data
-} // namespace quant 
\ No newline at end of file
+} // namespace quant
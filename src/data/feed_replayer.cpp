@@ -0,0 +1,323 @@
+#include "data/feed_replayer.hpp"
+#include "utils/cpu_affinity.hpp"
+#include <cstring>
+#include <stdexcept>
+
+namespace quant {
+namespace data {
+
+namespace {
+
+constexpr std::uint32_t kNoLocalId = UINT32_MAX;
+
+void wait_until(std::uint64_t target_ns, std::chrono::microseconds spin_window) {
+    const std::uint64_t spin_ns = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(spin_window).count());
+    std::uint64_t now = steady_clock_ns();
+    if (target_ns > now + spin_ns) {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(target_ns - now - spin_ns));
+    }
+    while (steady_clock_ns() < target_ns) {
+        utils::cpu_relax();
+    }
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// FeedRecorder
+// ---------------------------------------------------------------------------
+
+FeedRecorder::FeedRecorder(const std::string& path)
+    : out_(path, std::ios::binary | std::ios::trunc) {
+    if (!out_) {
+        throw std::runtime_error("Cannot create feed log: " + path);
+    }
+    // 先写入占位文件头，close()时回填
+    feed_log::Header header{};
+    out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+FeedRecorder::~FeedRecorder() {
+    try {
+        close();
+    } catch (...) {
+        // 析构函数中不抛出异常
+    }
+}
+
+std::uint32_t FeedRecorder::local_symbol(SymbolId symbol) {
+    if (symbol >= local_ids_.size()) {
+        local_ids_.resize(static_cast<std::size_t>(symbol) + 1, kNoLocalId);
+    }
+    if (local_ids_[symbol] == kNoLocalId) {
+        std::string name = symbol_name(symbol);
+        if (name.size() >= feed_log::kSymbolLength) {
+            throw std::invalid_argument("Symbol too long for feed log: " + name);
+        }
+        local_ids_[symbol] = static_cast<std::uint32_t>(names_.size());
+        names_.push_back(std::move(name));
+    }
+    return local_ids_[symbol];
+}
+
+void FeedRecorder::record(const MarketEvent& event, std::uint64_t capture_ns) {
+    if (closed_) {
+        throw std::logic_error("Feed log already closed");
+    }
+    if (capture_ns == 0) {
+        capture_ns = steady_clock_ns();
+    }
+    if (capture_ns < last_capture_ns_) {
+        throw std::invalid_argument("Feed events must be recorded in capture order");
+    }
+    last_capture_ns_ = capture_ns;
+
+    MarketEvent stored = event;
+    stored.symbol = local_symbol(event.symbol);
+    stored.publish_ns = capture_ns;
+    out_.write(reinterpret_cast<const char*>(&stored), sizeof(stored));
+    ++event_count_;
+}
+
+void FeedRecorder::record(const BarData& bar, std::uint64_t capture_ns) {
+    record(MarketEvent::from_bar(bar), capture_ns);
+}
+
+void FeedRecorder::record(const Trade& trade, std::uint64_t capture_ns) {
+    record(MarketEvent::from_trade(trade), capture_ns);
+}
+
+void FeedRecorder::record(SymbolId symbol, Timestamp timestamp, const BookDelta& delta, std::uint64_t capture_ns) {
+    record(MarketEvent::from_book_delta(symbol, timestamp, delta), capture_ns);
+}
+
+void FeedRecorder::close() {
+    if (closed_) {
+        return;
+    }
+    closed_ = true;
+
+    feed_log::Header header{};
+    std::memcpy(header.magic, feed_log::kMagic, sizeof(header.magic));
+    header.version = feed_log::kVersion;
+    header.symbol_count = static_cast<std::uint32_t>(names_.size());
+    header.event_count = event_count_;
+    header.symbol_table_offset = sizeof(header) + event_count_ * sizeof(MarketEvent);
+
+    for (const auto& name : names_) {
+        char entry[feed_log::kSymbolLength] = {};
+        std::memcpy(entry, name.data(), name.size());
+        out_.write(entry, sizeof(entry));
+    }
+    out_.seekp(0);
+    out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out_.close();
+    if (!out_) {
+        throw std::runtime_error("Failed to write feed log");
+    }
+}
+
+// ---------------------------------------------------------------------------
+// FeedReplayer
+// ---------------------------------------------------------------------------
+
+FeedReplayer::FeedReplayer(const std::string& path)
+    : file_(std::make_shared<const utils::MappedFile>(path)) {
+    if (file_->size() < sizeof(feed_log::Header)) {
+        throw std::runtime_error("Feed log too small: " + path);
+    }
+
+    const auto* header = reinterpret_cast<const feed_log::Header*>(file_->data());
+    if (std::memcmp(header->magic, feed_log::kMagic, sizeof(header->magic)) != 0) {
+        throw std::runtime_error("Not a feed log file: " + path);
+    }
+    if (header->version != feed_log::kVersion) {
+        throw std::runtime_error("Unsupported feed log version: " + path);
+    }
+    if (header->symbol_table_offset != sizeof(feed_log::Header) + header->event_count * sizeof(MarketEvent) ||
+        header->symbol_table_offset + header->symbol_count * feed_log::kSymbolLength > file_->size()) {
+        throw std::runtime_error("Corrupted feed log: " + path);
+    }
+
+    events_ = reinterpret_cast<const MarketEvent*>(file_->data() + sizeof(feed_log::Header));
+    event_count_ = header->event_count;
+
+    const char* names = file_->data() + header->symbol_table_offset;
+    symbol_map_.reserve(header->symbol_count);
+    for (std::uint32_t i = 0; i < header->symbol_count; ++i) {
+        const char* name = names + i * feed_log::kSymbolLength;
+        symbol_map_.push_back(intern_symbol(std::string(name, strnlen(name, feed_log::kSymbolLength))));
+    }
+    for (std::size_t i = 0; i < event_count_; ++i) {
+        if (events_[i].symbol >= symbol_map_.size()) {
+            throw std::runtime_error("Corrupted feed log symbol: " + path);
+        }
+    }
+    file_->advise_sequential(0, file_->size());
+}
+
+FeedReplayer::~FeedReplayer() {
+    stop();
+}
+
+std::vector<std::string> FeedReplayer::symbols() const {
+    std::vector<std::string> names;
+    names.reserve(symbol_map_.size());
+    for (SymbolId id : symbol_map_) {
+        names.push_back(symbol_name(id));
+    }
+    return names;
+}
+
+std::uint64_t FeedReplayer::duration_ns() const {
+    return event_count_ ? events_[event_count_ - 1].publish_ns - events_[0].publish_ns : 0;
+}
+
+void FeedReplayer::set_dispatcher(MarketDataDispatcher* dispatcher) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    dispatcher_ = dispatcher;
+}
+
+void FeedReplayer::add_subscriber(const std::string& symbol, Subscriber subscriber) {
+    SymbolId id = intern_symbol(symbol);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (id >= subscribers_.size()) {
+        subscribers_.resize(static_cast<std::size_t>(id) + 1);
+    }
+    subscribers_[id].push_back(std::move(subscriber));
+}
+
+void FeedReplayer::subscribe_events(const std::string& symbol, std::function<void(const MarketEvent&)> callback) {
+    add_subscriber(symbol, Subscriber{nullptr, std::move(callback)});
+}
+
+void FeedReplayer::subscribe_market_data(
+    const std::string& symbol,
+    std::function<void(const MarketData&)> callback) {
+    add_subscriber(symbol, Subscriber{std::move(callback), nullptr});
+}
+
+void FeedReplayer::unsubscribe_market_data(const std::string& symbol) {
+    SymbolId id = intern_symbol(symbol);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (id < subscribers_.size()) {
+        subscribers_[id].clear();
+    }
+}
+
+std::vector<BarData> FeedReplayer::get_historical_bars(
+    const std::string& symbol,
+    const Timestamp& start_time,
+    const Timestamp& end_time,
+    const std::string& /*timeframe*/) {
+    std::vector<BarData> bars;
+    SymbolId id = intern_symbol(symbol);
+    for (std::size_t i = 0; i < event_count_; ++i) {
+        const MarketEvent& event = events_[i];
+        if (event.type == MarketEventType::BAR && symbol_map_[event.symbol] == id &&
+            event.timestamp >= start_time && event.timestamp <= end_time) {
+            BarData bar = event.to_bar();
+            bar.symbol = id;
+            bars.push_back(bar);
+        }
+    }
+    return bars;
+}
+
+ReplayStats FeedReplayer::replay(const ReplayOptions& options) {
+    ReplayStats stats;
+    if (event_count_ == 0) {
+        return stats;
+    }
+
+    // 回放期间使用订阅关系的快照，热路径上不加锁
+    std::vector<std::vector<Subscriber>> subscribers;
+    MarketDataDispatcher* dispatcher;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        subscribers = subscribers_;
+        dispatcher = dispatcher_;
+    }
+
+    const bool paced = options.speed > 0.0;
+    const std::uint64_t first_capture = events_[0].publish_ns;
+    // 每轮的时间轴长度：录制时长加一个平均事件间隔，避免相邻两轮首尾重叠
+    const std::uint64_t span = duration_ns();
+    const std::uint64_t loop_span = span + (event_count_ > 1 ? span / (event_count_ - 1) : 0);
+    const std::uint64_t start_ns = steady_clock_ns();
+
+    for (std::size_t loop = 0; loop < options.loops; ++loop) {
+        for (std::size_t i = 0; i < event_count_; ++i) {
+            if (stop_requested_.load(std::memory_order_relaxed)) {
+                loop = options.loops;
+                break;
+            }
+
+            MarketEvent event = events_[i];
+            event.symbol = symbol_map_[event.symbol];
+
+            if (paced) {
+                double offset = static_cast<double>(event.publish_ns - first_capture + loop * loop_span);
+                auto target = start_ns + static_cast<std::uint64_t>(offset / options.speed);
+                wait_until(target, options.spin_window);
+                std::uint64_t now = steady_clock_ns();
+                stats.schedule_lag.record(now > target ? now - target : 0);
+            }
+
+            const std::uint64_t publish_ns = steady_clock_ns();
+            event.publish_ns = publish_ns;
+            if (dispatcher) {
+                dispatcher->publish(event);
+            }
+            if (event.symbol < subscribers.size()) {
+                for (const auto& subscriber : subscribers[event.symbol]) {
+                    if (subscriber.on_event) {
+                        stats.dispatch_delay.record(steady_clock_ns() - publish_ns);
+                        subscriber.on_event(event);
+                    } else if (event.type == MarketEventType::BAR) {
+                        stats.dispatch_delay.record(steady_clock_ns() - publish_ns);
+                        subscriber.on_bar(event.to_bar());
+                    }
+                }
+            }
+            ++stats.events_published;
+        }
+    }
+
+    stats.elapsed_seconds = static_cast<double>(steady_clock_ns() - start_ns) / 1e9;
+    if (stats.elapsed_seconds > 0.0) {
+        stats.events_per_second = stats.events_published / stats.elapsed_seconds;
+    }
+    return stats;
+}
+
+void FeedReplayer::start(const ReplayOptions& options) {
+    if (thread_.joinable()) {
+        throw std::logic_error("Feed replay already started");
+    }
+    stop_requested_.store(false, std::memory_order_relaxed);
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread([this, options] {
+        background_stats_ = replay(options);
+        running_.store(false, std::memory_order_release);
+    });
+}
+
+ReplayStats FeedReplayer::wait() {
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    return background_stats_;
+}
+
+void FeedReplayer::stop() {
+    stop_requested_.store(true, std::memory_order_relaxed);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    stop_requested_.store(false, std::memory_order_relaxed);
+}
+
+} // namespace data
+} // namespace quant
@@ -0,0 +1,248 @@
+#include "data/market_data_dispatcher.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace quant {
+namespace data {
+
+MarketEvent MarketEvent::from_bar(const BarData& bar) {
+    MarketEvent event{};
+    event.type = MarketEventType::BAR;
+    event.symbol = bar.symbol;
+    event.timestamp = bar.timestamp;
+    event.open = bar.open;
+    event.high = bar.high;
+    event.low = bar.low;
+    event.close = bar.close;
+    event.volume = bar.volume;
+    return event;
+}
+
+MarketEvent MarketEvent::from_trade(const Trade& trade) {
+    MarketEvent event{};
+    event.type = MarketEventType::TRADE;
+    event.flags = trade.is_buyer_maker ? kBuyerMaker : 0;
+    event.symbol = trade.symbol;
+    event.timestamp = trade.timestamp;
+    event.open = trade.price;
+    event.high = trade.price;
+    event.low = trade.price;
+    event.close = trade.price;
+    event.volume = trade.volume;
+    return event;
+}
+
+MarketEvent MarketEvent::from_book_delta(SymbolId symbol, Timestamp timestamp, const BookDelta& delta) {
+    MarketEvent event{};
+    event.type = MarketEventType::BOOK_DELTA;
+    event.flags = static_cast<std::uint8_t>(static_cast<unsigned>(delta.side) |
+                                            (static_cast<unsigned>(delta.action) << 1));
+    event.symbol = symbol;
+    event.timestamp = timestamp;
+    event.close = delta.price;
+    event.volume = delta.volume;
+    return event;
+}
+
+BarData MarketEvent::to_bar() const {
+    return BarData{timestamp, symbol, open, high, low, close, volume};
+}
+
+Trade MarketEvent::to_trade() const {
+    return Trade{timestamp, symbol, close, volume, (flags & kBuyerMaker) != 0};
+}
+
+EventChannel::EventChannel(ChannelOptions options) : mode_(options.mode) {
+    if (options.capacity == 0) {
+        throw std::invalid_argument("Channel capacity must be positive");
+    }
+
+    switch (mode_) {
+        case ChannelMode::SPSC:
+            spsc_ = std::make_unique<utils::SpscQueue<MarketEvent>>(options.capacity);
+            break;
+        case ChannelMode::MPSC:
+            mpsc_ = std::make_unique<utils::MpscQueue<MarketEvent>>(options.capacity);
+            break;
+        case ChannelMode::CONFLATING:
+            // 每个品种在待处理列表中最多出现一次，列表容量不小于槽位数即不会溢出
+            slot_count_ = options.capacity;
+            slots_.reset(new Slot[slot_count_]);
+            pending_symbols_ = std::make_unique<utils::MpscQueue<SymbolId>>(slot_count_);
+            break;
+    }
+}
+
+bool EventChannel::push(const MarketEvent& event) {
+    bool accepted = false;
+    switch (mode_) {
+        case ChannelMode::SPSC:
+            accepted = spsc_->try_push(event);
+            break;
+        case ChannelMode::MPSC:
+            accepted = mpsc_->try_push(event);
+            break;
+        case ChannelMode::CONFLATING:
+            accepted = store_latest(event);
+            break;
+    }
+    if (!accepted) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return accepted;
+}
+
+bool EventChannel::store_latest(const MarketEvent& event) {
+    if (event.symbol >= slot_count_) {
+        return false;
+    }
+    Slot& slot = slots_[event.symbol];
+
+    // 奇数序号表示正在写入；多个发布线程写同一品种时在此互斥
+    std::uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    while (true) {
+        if ((sequence & 1) == 0 &&
+            slot.sequence.compare_exchange_weak(sequence, sequence + 1, std::memory_order_relaxed)) {
+            break;
+        }
+        utils::cpu_relax();
+        sequence = slot.sequence.load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+
+    std::uint64_t words[kEventWords];
+    std::memcpy(words, &event, sizeof(words));
+    for (std::size_t i = 0; i < kEventWords; ++i) {
+        slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+
+    if (slot.pending.exchange(1, std::memory_order_acq_rel) == 0) {
+        pending_symbols_->try_push(event.symbol);
+    } else {
+        conflated_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+bool EventChannel::load_latest(Slot& slot, MarketEvent& event) {
+    // 先清除待处理标记再读取：之后的写入会重新把品种放入待处理列表
+    slot.pending.exchange(0, std::memory_order_acq_rel);
+
+    std::uint64_t words[kEventWords];
+    std::uint32_t sequence;
+    while (true) {
+        sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence & 1) {
+            utils::cpu_relax();
+            continue;
+        }
+        for (std::size_t i = 0; i < kEventWords; ++i) {
+            words[i] = slot.words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) == sequence) {
+            break;
+        }
+    }
+
+    // 上一次读取时已拿到这一版本，不重复送达
+    if (sequence == slot.delivered) {
+        return false;
+    }
+    slot.delivered = sequence;
+    std::memcpy(&event, words, sizeof(words));
+    return true;
+}
+
+BookDelta MarketEvent::to_book_delta() const {
+    return BookDelta{static_cast<BookSide>(flags & 1), static_cast<DeltaAction>(flags >> 1), close, volume};
+}
+
+MarketDataDispatcher::~MarketDataDispatcher() = default;
+
+EventChannel& MarketDataDispatcher::create_channel(ChannelOptions options) {
+    auto channel = std::make_unique<EventChannel>(options);
+    std::lock_guard<std::mutex> lock(mutex_);
+    channels_.push_back(std::move(channel));
+    return *channels_.back();
+}
+
+template <typename Mutator>
+void MarketDataDispatcher::update_routes(Mutator&& mutate) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Routes* current = routes_.load(std::memory_order_relaxed);
+    auto next = current ? std::make_unique<Routes>(*current) : std::make_unique<Routes>();
+    mutate(*next);
+    routes_.store(next.get(), std::memory_order_release);
+    route_versions_.push_back(std::move(next));
+}
+
+void MarketDataDispatcher::subscribe(EventChannel& channel, SymbolId symbol) {
+    if (symbol == kInvalidSymbolId) {
+        throw std::invalid_argument("Cannot subscribe to an invalid symbol");
+    }
+    update_routes([&](Routes& routes) {
+        if (routes.by_symbol.size() <= symbol) {
+            routes.by_symbol.resize(static_cast<std::size_t>(symbol) + 1);
+        }
+        auto& targets = routes.by_symbol[symbol];
+        if (std::find(targets.begin(), targets.end(), &channel) == targets.end()) {
+            targets.push_back(&channel);
+        }
+    });
+}
+
+void MarketDataDispatcher::subscribe(EventChannel& channel, const std::string& symbol) {
+    subscribe(channel, intern_symbol(symbol));
+}
+
+void MarketDataDispatcher::subscribe_all(EventChannel& channel) {
+    update_routes([&](Routes& routes) {
+        if (std::find(routes.wildcard.begin(), routes.wildcard.end(), &channel) == routes.wildcard.end()) {
+            routes.wildcard.push_back(&channel);
+        }
+    });
+}
+
+void MarketDataDispatcher::unsubscribe(EventChannel& channel, SymbolId symbol) {
+    update_routes([&](Routes& routes) {
+        if (symbol < routes.by_symbol.size()) {
+            auto& targets = routes.by_symbol[symbol];
+            targets.erase(std::remove(targets.begin(), targets.end(), &channel), targets.end());
+        }
+    });
+}
+
+std::size_t MarketDataDispatcher::publish(const MarketEvent& source) {
+    const Routes* routes = routes_.load(std::memory_order_acquire);
+    if (!routes) {
+        return 0;
+    }
+
+    MarketEvent event = source;
+    event.publish_ns = steady_clock_ns();
+    std::size_t delivered = 0;
+    if (event.symbol < routes->by_symbol.size()) {
+        for (EventChannel* channel : routes->by_symbol[event.symbol]) {
+            delivered += channel->push(event) ? 1 : 0;
+        }
+    }
+    for (EventChannel* channel : routes->wildcard) {
+        delivered += channel->push(event) ? 1 : 0;
+    }
+    return delivered;
+}
+
+void MarketDataDispatcher::attach(DataSource& source, const std::string& symbol) {
+    source.subscribe_market_data(symbol, [this](const MarketData& bar) {
+        publish(MarketEvent::from_bar(bar));
+    });
+}
+
+void MarketDataDispatcher::detach(DataSource& source, const std::string& symbol) {
+    source.unsubscribe_market_data(symbol);
+}
+
+} // namespace data
+} // namespace quant
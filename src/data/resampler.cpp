@@ -0,0 +1,223 @@
+#include "data/resampler.hpp"
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+namespace quant {
+namespace data {
+
+namespace {
+
+// 1970-01-01是周四，周一00:00 UTC为纪元后第4天
+constexpr Timestamp kMondayOrigin = 4 * 86400;
+
+// 向下取整的整数除法
+inline Timestamp floor_div(Timestamp a, Timestamp b) {
+    Timestamp q = a / b;
+    return (a % b != 0 && ((a < 0) != (b < 0))) ? q - 1 : q;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Timeframe
+// ---------------------------------------------------------------------------
+
+Timeframe Timeframe::parse(const std::string& text) {
+    std::size_t pos = 0;
+    while (pos < text.size() && std::isdigit(static_cast<unsigned char>(text[pos]))) {
+        ++pos;
+    }
+    std::string unit = text.substr(pos);
+    if (pos == 0 || unit.empty()) {
+        throw std::invalid_argument("Invalid timeframe: " + text);
+    }
+    Timestamp count = std::stoll(text.substr(0, pos));
+    if (count <= 0) {
+        throw std::invalid_argument("Invalid timeframe: " + text);
+    }
+
+    Timeframe timeframe;
+    if (unit == "s" || unit == "S") {
+        timeframe.seconds = count;
+    } else if (unit == "m" || unit == "min" || unit == "T") {
+        timeframe.seconds = count * 60;
+    } else if (unit == "h" || unit == "H") {
+        timeframe.seconds = count * 3600;
+    } else if (unit == "d" || unit == "D") {
+        timeframe.seconds = count * 86400;
+    } else if (unit == "w" || unit == "W") {
+        timeframe.seconds = count * 7 * 86400;
+        timeframe.origin = kMondayOrigin;
+    } else {
+        throw std::invalid_argument("Unsupported timeframe: " + text);
+    }
+    return timeframe;
+}
+
+// ---------------------------------------------------------------------------
+// BarResampler
+// ---------------------------------------------------------------------------
+
+BarResampler::BarResampler(Timeframe timeframe, Timestamp session_offset)
+    : timeframe_(timeframe),
+      anchor_(timeframe.origin + session_offset) {
+    if (timeframe_.seconds <= 0) {
+        throw std::invalid_argument("Timeframe must be positive");
+    }
+}
+
+Timestamp BarResampler::bucket_start(Timestamp t) const {
+    return anchor_ + floor_div(t - anchor_, timeframe_.seconds) * timeframe_.seconds;
+}
+
+bool BarResampler::roll(Timestamp bucket, SymbolId symbol, BarData& completed) {
+    if (has_partial_ && bucket == current_.timestamp) {
+        return false;
+    }
+    if (has_partial_ && bucket < current_.timestamp) {
+        throw std::invalid_argument("Resampler input must be sorted by time");
+    }
+
+    bool emitted = false;
+    if (has_partial_) {
+        completed = current_;
+        emitted = true;
+    }
+    current_.timestamp = bucket;
+    current_.symbol = symbol;
+    has_partial_ = false;
+    return emitted;
+}
+
+bool BarResampler::update(const BarData& bar, BarData& completed) {
+    bool emitted = roll(bucket_start(bar.timestamp), bar.symbol, completed);
+    if (!has_partial_) {
+        current_.open = bar.open;
+        current_.high = bar.high;
+        current_.low = bar.low;
+        current_.close = bar.close;
+        current_.volume = bar.volume;
+        has_partial_ = true;
+    } else {
+        current_.high = std::max(current_.high, bar.high);
+        current_.low = std::min(current_.low, bar.low);
+        current_.close = bar.close;
+        current_.volume += bar.volume;
+    }
+    return emitted;
+}
+
+bool BarResampler::update(const Trade& trade, BarData& completed) {
+    bool emitted = roll(bucket_start(trade.timestamp), trade.symbol, completed);
+    if (!has_partial_) {
+        current_.open = trade.price;
+        current_.high = trade.price;
+        current_.low = trade.price;
+        current_.close = trade.price;
+        current_.volume = trade.volume;
+        has_partial_ = true;
+    } else {
+        current_.high = std::max(current_.high, trade.price);
+        current_.low = std::min(current_.low, trade.price);
+        current_.close = trade.price;
+        current_.volume += trade.volume;
+    }
+    return emitted;
+}
+
+bool BarResampler::flush(BarData& completed) {
+    if (!has_partial_) {
+        return false;
+    }
+    completed = current_;
+    has_partial_ = false;
+    return true;
+}
+
+BarSeries resample(const BarSeriesView& bars, const Timeframe& timeframe, Timestamp session_offset) {
+    BarResampler resampler(timeframe, session_offset);
+    BarSeriesBuilder builder(bars.symbol());
+
+    BarData completed;
+    for (std::size_t i = 0; i < bars.size(); ++i) {
+        if (resampler.update(bars[i], completed)) {
+            builder.push_back(completed);
+        }
+    }
+    if (resampler.flush(completed)) {
+        builder.push_back(completed);
+    }
+    return builder.build();
+}
+
+// ---------------------------------------------------------------------------
+// ResamplingDataSource
+// ---------------------------------------------------------------------------
+
+ResamplingDataSource::ResamplingDataSource(
+    std::shared_ptr<DataSource> source,
+    std::string base_timeframe,
+    Timestamp session_offset)
+    : source_(std::move(source)),
+      base_timeframe_(std::move(base_timeframe)),
+      base_(Timeframe::parse(base_timeframe_)),
+      session_offset_(session_offset) {
+    if (!source_) {
+        throw std::invalid_argument("Data source cannot be null");
+    }
+}
+
+std::vector<BarData> ResamplingDataSource::get_historical_bars(
+    const std::string& symbol,
+    const Timestamp& start_time,
+    const Timestamp& end_time,
+    const std::string& timeframe) {
+    return get_bar_series(symbol, start_time, end_time, timeframe).to_bars();
+}
+
+BarSeries ResamplingDataSource::get_bar_series(
+    const std::string& symbol,
+    const Timestamp& start_time,
+    const Timestamp& end_time,
+    const std::string& timeframe) {
+
+    if (timeframe.empty() || timeframe == base_timeframe_) {
+        return source_->get_bar_series(symbol, start_time, end_time, base_timeframe_);
+    }
+
+    Timeframe target = Timeframe::parse(timeframe);
+    if (target.seconds < base_.seconds || target.seconds % base_.seconds != 0) {
+        throw std::invalid_argument(
+            "Cannot build " + timeframe + " bars from " + base_timeframe_ + " data");
+    }
+
+    // 只返回起点落在[start_time, end_time]内的完整周期：
+    // 细粒度数据从start_time之后的第一个周期边界取到end_time所在周期的末尾
+    BarResampler resampler(target, session_offset_);
+    Timestamp first_bucket = resampler.bucket_start(start_time);
+    if (first_bucket < start_time) {
+        first_bucket += target.seconds;
+    }
+    Timestamp last_bucket = resampler.bucket_start(end_time);
+    if (first_bucket > last_bucket) {
+        return BarSeries::from_bars({}, intern_symbol(symbol));
+    }
+
+    BarSeries fine = source_->get_bar_series(
+        symbol, first_bucket, last_bucket + target.seconds - 1, base_timeframe_);
+    return resample(fine.view(), target, session_offset_);
+}
+
+void ResamplingDataSource::subscribe_market_data(
+    const std::string& symbol,
+    std::function<void(const MarketData&)> callback) {
+    source_->subscribe_market_data(symbol, std::move(callback));
+}
+
+void ResamplingDataSource::unsubscribe_market_data(const std::string& symbol) {
+    source_->unsubscribe_market_data(symbol);
+}
+
+} // namespace data
+} // namespace quant
@@ -0,0 +1,68 @@
+#include "data/series_data_feed.hpp"
+#include <stdexcept>
+
+namespace quant {
+namespace data {
+
+std::shared_ptr<SeriesDataFeed> SeriesDataFeed::load(
+    DataFeed& data_feed,
+    const std::vector<std::string>& symbols,
+    const Timestamp& start_time,
+    const Timestamp& end_time,
+    const std::string& timeframe) {
+    auto feed = std::make_shared<SeriesDataFeed>();
+    for (const auto& symbol : symbols) {
+        feed->set_series(symbol, data_feed.get_bar_series(symbol, start_time, end_time, timeframe));
+    }
+    return feed;
+}
+
+void SeriesDataFeed::set_series(const std::string& symbol, BarSeries series) {
+    series_[symbol] = std::move(series);
+}
+
+BarSeries SeriesDataFeed::series(const std::string& symbol) const {
+    auto it = series_.find(symbol);
+    return it != series_.end() ? it->second : BarSeries();
+}
+
+std::vector<BarData> SeriesDataFeed::get_historical_bars(
+    const std::string& symbol,
+    const Timestamp& start_time,
+    const Timestamp& end_time,
+    const std::string& timeframe) {
+    return get_bar_series(symbol, start_time, end_time, timeframe).to_bars();
+}
+
+BarSeries SeriesDataFeed::get_bar_series(
+    const std::string& symbol,
+    const Timestamp& start_time,
+    const Timestamp& end_time,
+    const std::string& /*timeframe*/) {
+    auto it = series_.find(symbol);
+    if (it == series_.end()) {
+        return BarSeries();
+    }
+    return it->second.range(start_time, end_time);
+}
+
+void SeriesDataFeed::subscribe_market_data(
+    const std::string& symbol,
+    std::function<void(const MarketData&)> /*callback*/) {
+    throw std::runtime_error("SeriesDataFeed does not support real-time data: " + symbol);
+}
+
+void SeriesDataFeed::unsubscribe_market_data(const std::string& symbol) {
+    throw std::runtime_error("SeriesDataFeed does not support real-time data: " + symbol);
+}
+
+std::size_t SeriesDataFeed::memory_bytes() const {
+    std::size_t bytes = 0;
+    for (const auto& [symbol, series] : series_) {
+        bytes += series.memory_bytes();
+    }
+    return bytes;
+}
+
+} // namespace data
+} // namespace quant
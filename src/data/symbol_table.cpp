@@ -0,0 +1,58 @@
+#include "data/symbol_table.hpp"
+#include <mutex>
+#include <stdexcept>
+
+namespace quant {
+namespace data {
+
+SymbolTable& SymbolTable::instance() {
+    static SymbolTable table;
+    return table;
+}
+
+SymbolId SymbolTable::intern(std::string_view symbol) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(symbol);
+        if (it != ids_.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = ids_.find(symbol);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+    if (names_.size() >= kInvalidSymbolId) {
+        throw std::overflow_error("Symbol table is full");
+    }
+
+    auto id = static_cast<SymbolId>(names_.size());
+    names_.emplace_back(symbol);
+    // 键指向deque中的字符串，不会因扩容失效
+    ids_.emplace(std::string_view(names_.back()), id);
+    return id;
+}
+
+SymbolId SymbolTable::find(std::string_view symbol) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = ids_.find(symbol);
+    return it != ids_.end() ? it->second : kInvalidSymbolId;
+}
+
+const std::string& SymbolTable::name(SymbolId id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (id >= names_.size()) {
+        throw std::out_of_range("Unknown symbol id: " + std::to_string(id));
+    }
+    return names_[id];
+}
+
+std::size_t SymbolTable::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return names_.size();
+}
+
+} // namespace data
+} // namespace quant
@@ -0,0 +1,521 @@
+#include "indicators/batch_kernels.hpp"
+#include "indicators/moving_average.hpp"
+#include "utils/compensated_sum.hpp"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define QUANT_BATCH_X86 1
+#include <immintrin.h>
+#endif
+
+namespace quant {
+namespace indicators {
+namespace batch {
+
+namespace {
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+constexpr std::size_t kMaxLanes = 8;
+
+SimdLevel detect() {
+#ifdef QUANT_BATCH_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return SimdLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::AVX2;
+    }
+#endif
+    return SimdLevel::SCALAR;
+}
+
+std::atomic<int>& level_override() {
+    static std::atomic<int> level{static_cast<int>(detected_simd_level())};
+    return level;
+}
+
+std::size_t lane_width(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AVX512: return 8;
+        case SimdLevel::AVX2: return 4;
+        default: return 1;
+    }
+}
+
+void check_period(std::size_t period) {
+    if (period == 0) {
+        throw std::invalid_argument("Period must be greater than 0");
+    }
+}
+
+void check_output(utils::Span<const double> input, std::size_t rows, utils::Span<double> output) {
+    if (output.size() != input.size() * rows) {
+        throw std::invalid_argument("Output size does not match input size");
+    }
+}
+
+double rsi_value(double avg_gain, double avg_loss) {
+    if (avg_loss == 0.0) {
+        return 100.0;
+    }
+    double rs = avg_gain / avg_loss;
+    return 100.0 - (100.0 / (1.0 + rs));
+}
+
+// 补偿前缀和（双倍精度：hi + lo），窗口和 = (hi[j] - hi[i]) + (lo[j] - lo[i])
+struct PrefixSum {
+    std::vector<double> hi;
+    std::vector<double> lo;
+
+    explicit PrefixSum(utils::Span<const double> input) : hi(input.size() + 1), lo(input.size() + 1) {
+        double sum = 0.0;
+        double compensation = 0.0;
+        hi[0] = 0.0;
+        lo[0] = 0.0;
+        for (std::size_t i = 0; i < input.size(); ++i) {
+            // TwoSum：精确求出每次相加的舍入误差
+            double value = input[i];
+            double next = sum + value;
+            double virtual_value = next - sum;
+            compensation += (sum - (next - virtual_value)) + (value - virtual_value);
+            sum = next;
+            hi[i + 1] = sum;
+            lo[i + 1] = compensation;
+        }
+    }
+};
+
+// ---------------------------------------------------------------------------
+// 标量实现
+// ---------------------------------------------------------------------------
+
+// out[t] = 窗口[t - period + 1, t]的均值，t ∈ [period - 1, count)
+void window_means_scalar(const double* hi, const double* lo, std::size_t period, std::size_t count, double* out) {
+    const double divisor = static_cast<double>(period);
+    for (std::size_t t = period - 1; t < count; ++t) {
+        out[t] = ((hi[t + 1] - hi[t + 1 - period]) + (lo[t + 1] - lo[t + 1 - period])) / divisor;
+    }
+}
+
+void ema_lanes_scalar(const double* input, std::size_t begin, std::size_t end, const double* alpha,
+                      double* state, double* const* rows, std::size_t lanes) {
+    for (std::size_t k = 0; k < lanes; ++k) {
+        const double a = alpha[k];
+        const double b = 1 - a;
+        double value = state[k];
+        double* row = rows[k];
+        for (std::size_t t = begin; t < end; ++t) {
+            value = a * input[t] + b * value;
+            row[t] = value;
+        }
+        state[k] = value;
+    }
+}
+
+void rsi_lanes_scalar(const double* gains, const double* losses, std::size_t begin, std::size_t end,
+                      const double* periods, double* avg_gain, double* avg_loss,
+                      double* const* rows, std::size_t lanes) {
+    for (std::size_t k = 0; k < lanes; ++k) {
+        const double p = periods[k];
+        const double p1 = p - 1;
+        double g = avg_gain[k];
+        double l = avg_loss[k];
+        double* row = rows[k];
+        for (std::size_t t = begin; t < end; ++t) {
+            g = (g * p1 + gains[t]) / p;
+            l = (l * p1 + losses[t]) / p;
+            row[t] = rsi_value(g, l);
+        }
+        avg_gain[k] = g;
+        avg_loss[k] = l;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// AVX2 / AVX-512 实现
+//
+// SMA在时间方向上向量化；EMA和RSI是递推，单条序列无法在时间方向上并行，
+// 因此把多个周期放进同一向量的不同通道，每读入一个值同时推进所有周期。
+// 只用乘加而不用FMA，保证与标量递推逐位一致（AVX-512隐含FMA，需关闭编译器的乘加融合）。
+// ---------------------------------------------------------------------------
+
+#ifdef QUANT_BATCH_X86
+
+// 向量化内核按时间分块，块内各通道的输出先写入tile（[步][通道]），
+// 再逐通道连续写回各自的输出行，避免每步对多行做跨步写
+constexpr std::size_t kTileSteps = 64;
+
+void scatter_tile(const double* tile, std::size_t width, std::size_t begin, std::size_t end,
+                  double* const* rows, std::size_t lanes) {
+    for (std::size_t k = 0; k < lanes; ++k) {
+        double* row = rows[k];
+        for (std::size_t t = begin; t < end; ++t) {
+            row[t] = tile[(t - begin) * width + k];
+        }
+    }
+}
+
+__attribute__((target("avx2")))
+void window_means_avx2(const double* hi, const double* lo, std::size_t period, std::size_t count, double* out) {
+    const __m256d divisor = _mm256_set1_pd(static_cast<double>(period));
+    std::size_t t = period - 1;
+    for (; t + 4 <= count; t += 4) {
+        __m256d hi_diff = _mm256_sub_pd(_mm256_loadu_pd(hi + t + 1), _mm256_loadu_pd(hi + t + 1 - period));
+        __m256d lo_diff = _mm256_sub_pd(_mm256_loadu_pd(lo + t + 1), _mm256_loadu_pd(lo + t + 1 - period));
+        _mm256_storeu_pd(out + t, _mm256_div_pd(_mm256_add_pd(hi_diff, lo_diff), divisor));
+    }
+    for (; t < count; ++t) {
+        out[t] = ((hi[t + 1] - hi[t + 1 - period]) + (lo[t + 1] - lo[t + 1 - period])) / static_cast<double>(period);
+    }
+}
+
+__attribute__((target("avx2")))
+void ema_lanes_avx2(const double* input, std::size_t begin, std::size_t end, const double* alpha,
+                    double* state, double* const* rows, std::size_t lanes) {
+    const __m256d a = _mm256_loadu_pd(alpha);
+    const __m256d b = _mm256_sub_pd(_mm256_set1_pd(1.0), a);
+    __m256d value = _mm256_loadu_pd(state);
+    alignas(32) double tile[kTileSteps * 4];
+    for (std::size_t tile_begin = begin; tile_begin < end; tile_begin += kTileSteps) {
+        const std::size_t tile_end = std::min(tile_begin + kTileSteps, end);
+        for (std::size_t t = tile_begin; t < tile_end; ++t) {
+            value = _mm256_add_pd(_mm256_mul_pd(a, _mm256_set1_pd(input[t])), _mm256_mul_pd(b, value));
+            _mm256_store_pd(tile + (t - tile_begin) * 4, value);
+        }
+        scatter_tile(tile, 4, tile_begin, tile_end, rows, lanes);
+    }
+    _mm256_storeu_pd(state, value);
+}
+
+__attribute__((target("avx2")))
+void rsi_lanes_avx2(const double* gains, const double* losses, std::size_t begin, std::size_t end,
+                    const double* periods, double* avg_gain, double* avg_loss,
+                    double* const* rows, std::size_t lanes) {
+    const __m256d p = _mm256_loadu_pd(periods);
+    const __m256d p1 = _mm256_sub_pd(p, _mm256_set1_pd(1.0));
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d hundred = _mm256_set1_pd(100.0);
+    __m256d g = _mm256_loadu_pd(avg_gain);
+    __m256d l = _mm256_loadu_pd(avg_loss);
+    alignas(32) double tile[kTileSteps * 4];
+    for (std::size_t tile_begin = begin; tile_begin < end; tile_begin += kTileSteps) {
+        const std::size_t tile_end = std::min(tile_begin + kTileSteps, end);
+        for (std::size_t t = tile_begin; t < tile_end; ++t) {
+            g = _mm256_div_pd(_mm256_add_pd(_mm256_mul_pd(g, p1), _mm256_set1_pd(gains[t])), p);
+            l = _mm256_div_pd(_mm256_add_pd(_mm256_mul_pd(l, p1), _mm256_set1_pd(losses[t])), p);
+            __m256d rs = _mm256_div_pd(g, l);
+            __m256d value = _mm256_sub_pd(hundred, _mm256_div_pd(hundred, _mm256_add_pd(one, rs)));
+            value = _mm256_blendv_pd(value, hundred, _mm256_cmp_pd(l, zero, _CMP_EQ_OQ));
+            _mm256_store_pd(tile + (t - tile_begin) * 4, value);
+        }
+        scatter_tile(tile, 4, tile_begin, tile_end, rows, lanes);
+    }
+    _mm256_storeu_pd(avg_gain, g);
+    _mm256_storeu_pd(avg_loss, l);
+}
+
+__attribute__((target("avx512f"), optimize("fp-contract=off")))
+void window_means_avx512(const double* hi, const double* lo, std::size_t period, std::size_t count, double* out) {
+    const __m512d divisor = _mm512_set1_pd(static_cast<double>(period));
+    std::size_t t = period - 1;
+    for (; t + 8 <= count; t += 8) {
+        __m512d hi_diff = _mm512_sub_pd(_mm512_loadu_pd(hi + t + 1), _mm512_loadu_pd(hi + t + 1 - period));
+        __m512d lo_diff = _mm512_sub_pd(_mm512_loadu_pd(lo + t + 1), _mm512_loadu_pd(lo + t + 1 - period));
+        _mm512_storeu_pd(out + t, _mm512_div_pd(_mm512_add_pd(hi_diff, lo_diff), divisor));
+    }
+    for (; t < count; ++t) {
+        out[t] = ((hi[t + 1] - hi[t + 1 - period]) + (lo[t + 1] - lo[t + 1 - period])) / static_cast<double>(period);
+    }
+}
+
+__attribute__((target("avx512f"), optimize("fp-contract=off")))
+void ema_lanes_avx512(const double* input, std::size_t begin, std::size_t end, const double* alpha,
+                      double* state, double* const* rows, std::size_t lanes) {
+    const __m512d a = _mm512_loadu_pd(alpha);
+    const __m512d b = _mm512_sub_pd(_mm512_set1_pd(1.0), a);
+    __m512d value = _mm512_loadu_pd(state);
+    alignas(64) double tile[kTileSteps * 8];
+    for (std::size_t tile_begin = begin; tile_begin < end; tile_begin += kTileSteps) {
+        const std::size_t tile_end = std::min(tile_begin + kTileSteps, end);
+        for (std::size_t t = tile_begin; t < tile_end; ++t) {
+            value = _mm512_add_pd(_mm512_mul_pd(a, _mm512_set1_pd(input[t])), _mm512_mul_pd(b, value));
+            _mm512_store_pd(tile + (t - tile_begin) * 8, value);
+        }
+        scatter_tile(tile, 8, tile_begin, tile_end, rows, lanes);
+    }
+    _mm512_storeu_pd(state, value);
+}
+
+__attribute__((target("avx512f"), optimize("fp-contract=off")))
+void rsi_lanes_avx512(const double* gains, const double* losses, std::size_t begin, std::size_t end,
+                      const double* periods, double* avg_gain, double* avg_loss,
+                      double* const* rows, std::size_t lanes) {
+    const __m512d p = _mm512_loadu_pd(periods);
+    const __m512d p1 = _mm512_sub_pd(p, _mm512_set1_pd(1.0));
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512d one = _mm512_set1_pd(1.0);
+    const __m512d hundred = _mm512_set1_pd(100.0);
+    __m512d g = _mm512_loadu_pd(avg_gain);
+    __m512d l = _mm512_loadu_pd(avg_loss);
+    alignas(64) double tile[kTileSteps * 8];
+    for (std::size_t tile_begin = begin; tile_begin < end; tile_begin += kTileSteps) {
+        const std::size_t tile_end = std::min(tile_begin + kTileSteps, end);
+        for (std::size_t t = tile_begin; t < tile_end; ++t) {
+            g = _mm512_div_pd(_mm512_add_pd(_mm512_mul_pd(g, p1), _mm512_set1_pd(gains[t])), p);
+            l = _mm512_div_pd(_mm512_add_pd(_mm512_mul_pd(l, p1), _mm512_set1_pd(losses[t])), p);
+            __m512d rs = _mm512_div_pd(g, l);
+            __m512d value = _mm512_sub_pd(hundred, _mm512_div_pd(hundred, _mm512_add_pd(one, rs)));
+            value = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(l, zero, _CMP_EQ_OQ), value, hundred);
+            _mm512_store_pd(tile + (t - tile_begin) * 8, value);
+        }
+        scatter_tile(tile, 8, tile_begin, tile_end, rows, lanes);
+    }
+    _mm512_storeu_pd(avg_gain, g);
+    _mm512_storeu_pd(avg_loss, l);
+}
+
+#endif // QUANT_BATCH_X86
+
+using WindowMeansFn = void (*)(const double*, const double*, std::size_t, std::size_t, double*);
+using EmaLanesFn = void (*)(const double*, std::size_t, std::size_t, const double*, double*,
+                            double* const*, std::size_t);
+using RsiLanesFn = void (*)(const double*, const double*, std::size_t, std::size_t, const double*,
+                            double*, double*, double* const*, std::size_t);
+
+struct Kernels {
+    std::size_t width;
+    WindowMeansFn window_means;
+    EmaLanesFn ema_lanes;
+    RsiLanesFn rsi_lanes;
+};
+
+Kernels select_kernels() {
+    SimdLevel level = active_simd_level();
+#ifdef QUANT_BATCH_X86
+    if (level == SimdLevel::AVX512) {
+        return {8, window_means_avx512, ema_lanes_avx512, rsi_lanes_avx512};
+    }
+    if (level == SimdLevel::AVX2) {
+        return {4, window_means_avx2, ema_lanes_avx2, rsi_lanes_avx2};
+    }
+#endif
+    return {lane_width(level), window_means_scalar, ema_lanes_scalar, rsi_lanes_scalar};
+}
+
+// 按周期排序后每width个周期一组，组内周期接近，各通道预热结束的时刻也接近。
+// 周期大于max_period（数据不足、整行都是NaN）的不参与分组
+std::vector<std::vector<std::size_t>> lane_groups(utils::Span<const std::size_t> periods,
+                                                  std::size_t width, std::size_t max_period) {
+    std::vector<std::size_t> order(periods.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::stable_sort(order.begin(), order.end(),
+                     [&periods](std::size_t a, std::size_t b) { return periods[a] < periods[b]; });
+
+    std::vector<std::vector<std::size_t>> groups;
+    for (std::size_t index : order) {
+        if (periods[index] > max_period) {
+            break;
+        }
+        if (groups.empty() || groups.back().size() == width) {
+            groups.emplace_back();
+        }
+        groups.back().push_back(index);
+    }
+    return groups;
+}
+
+} // namespace
+
+SimdLevel detected_simd_level() {
+    static const SimdLevel level = detect();
+    return level;
+}
+
+SimdLevel active_simd_level() {
+    return static_cast<SimdLevel>(level_override().load(std::memory_order_relaxed));
+}
+
+void set_simd_level(SimdLevel level) {
+    level = std::min(level, detected_simd_level());
+    level_override().store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+const char* simd_level_name(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AVX512: return "avx512";
+        case SimdLevel::AVX2: return "avx2";
+        default: return "scalar";
+    }
+}
+
+void sma_multi(utils::Span<const double> input, utils::Span<const std::size_t> periods,
+               utils::Span<double> output) {
+    check_output(input, periods.size(), output);
+    for (std::size_t period : periods) {
+        check_period(period);
+    }
+
+    const std::size_t n = input.size();
+    const Kernels kernels = select_kernels();
+    const PrefixSum prefix(input);
+    for (std::size_t k = 0; k < periods.size(); ++k) {
+        double* row = output.data() + k * n;
+        const std::size_t warmup = std::min(periods[k] - 1, n);
+        std::fill(row, row + warmup, kNaN);
+        if (periods[k] <= n) {
+            kernels.window_means(prefix.hi.data(), prefix.lo.data(), periods[k], n, row);
+        }
+    }
+}
+
+void ema_multi(utils::Span<const double> input, utils::Span<const std::size_t> periods,
+               utils::Span<double> output, EmaSeed seed) {
+    check_output(input, periods.size(), output);
+    for (std::size_t period : periods) {
+        check_period(period);
+    }
+
+    const std::size_t n = input.size();
+    // 各周期第一个有效输出的位置
+    auto start_of = [seed](std::size_t period) { return seed == EmaSeed::SMA ? period - 1 : 0; };
+    for (std::size_t k = 0; k < periods.size(); ++k) {
+        double* row = output.data() + k * n;
+        std::fill(row, row + std::min(start_of(periods[k]), n), kNaN);
+    }
+    if (n == 0) {
+        return;
+    }
+
+    const Kernels kernels = select_kernels();
+    const std::size_t max_period = seed == EmaSeed::SMA ? n : std::numeric_limits<std::size_t>::max();
+    for (const auto& group : lane_groups(periods, kernels.width, max_period)) {
+        double alpha[kMaxLanes];
+        double state[kMaxLanes];
+        double* rows[kMaxLanes];
+        std::size_t begin = 0;
+        for (std::size_t k = 0; k < group.size(); ++k) {
+            const std::size_t period = periods[group[k]];
+            const std::size_t start = start_of(period);
+            alpha[k] = 2.0 / (period + 1);
+            rows[k] = output.data() + group[k] * n;
+            state[k] = seed == EmaSeed::SMA ? SimpleMovingAverage::window_mean(input.first(period), period)
+                                            : input[0];
+            rows[k][start] = state[k];
+            begin = std::max(begin, start + 1);
+        }
+        // 组内各通道先用标量递推到同一起点，再一起向量化推进
+        begin = std::min(begin, n);
+        for (std::size_t k = 0; k < group.size(); ++k) {
+            const std::size_t start = start_of(periods[group[k]]);
+            ema_lanes_scalar(input.data(), start + 1, begin, alpha + k, state + k, rows + k, 1);
+        }
+        // 不满一组时用最后一个通道补齐，补齐的通道不输出
+        for (std::size_t k = group.size(); k < kernels.width; ++k) {
+            alpha[k] = alpha[group.size() - 1];
+            state[k] = state[group.size() - 1];
+        }
+        kernels.ema_lanes(input.data(), begin, n, alpha, state, rows, group.size());
+    }
+}
+
+void rsi_multi(utils::Span<const double> input, utils::Span<const std::size_t> periods,
+               utils::Span<double> output) {
+    check_output(input, periods.size(), output);
+    for (std::size_t period : periods) {
+        check_period(period);
+    }
+
+    const std::size_t n = input.size();
+    for (std::size_t k = 0; k < periods.size(); ++k) {
+        double* row = output.data() + k * n;
+        std::fill(row, row + std::min(periods[k], n), kNaN);
+    }
+    if (n < 2) {
+        return;
+    }
+
+    // 涨跌幅只算一次，所有周期共用；gains[t]/losses[t]对应input[t] - input[t - 1]
+    std::vector<double> gains(n, 0.0);
+    std::vector<double> losses(n, 0.0);
+    for (std::size_t t = 1; t < n; ++t) {
+        double change = input[t] - input[t - 1];
+        gains[t] = change > 0 ? change : 0.0;
+        losses[t] = change > 0 ? 0.0 : -change;
+    }
+
+    const Kernels kernels = select_kernels();
+    for (const auto& group : lane_groups(periods, kernels.width, n - 1)) {
+        double lane_periods[kMaxLanes];
+        double avg_gain[kMaxLanes];
+        double avg_loss[kMaxLanes];
+        double* rows[kMaxLanes];
+        std::size_t begin = 0;
+        for (std::size_t k = 0; k < group.size(); ++k) {
+            const std::size_t period = periods[group[k]];
+            double total_gain = 0.0;
+            double total_loss = 0.0;
+            for (std::size_t t = 1; t <= period; ++t) {
+                total_gain += gains[t];
+                total_loss += losses[t];
+            }
+            lane_periods[k] = static_cast<double>(period);
+            avg_gain[k] = total_gain / lane_periods[k];
+            avg_loss[k] = total_loss / lane_periods[k];
+            rows[k] = output.data() + group[k] * n;
+            rows[k][period] = rsi_value(avg_gain[k], avg_loss[k]);
+            begin = std::max(begin, period + 1);
+        }
+        begin = std::min(begin, n);
+        for (std::size_t k = 0; k < group.size(); ++k) {
+            rsi_lanes_scalar(gains.data(), losses.data(), periods[group[k]] + 1, begin,
+                             lane_periods + k, avg_gain + k, avg_loss + k, rows + k, 1);
+        }
+        for (std::size_t k = group.size(); k < kernels.width; ++k) {
+            lane_periods[k] = lane_periods[group.size() - 1];
+            avg_gain[k] = avg_gain[group.size() - 1];
+            avg_loss[k] = avg_loss[group.size() - 1];
+        }
+        kernels.rsi_lanes(gains.data(), losses.data(), begin, n, lane_periods, avg_gain, avg_loss,
+                          rows, group.size());
+    }
+}
+
+void sma(utils::Span<const double> input, std::size_t period, utils::Span<double> output) {
+    sma_multi(input, utils::Span<const std::size_t>(&period, 1), output);
+}
+
+void ema(utils::Span<const double> input, std::size_t period, utils::Span<double> output, EmaSeed seed) {
+    ema_multi(input, utils::Span<const std::size_t>(&period, 1), output, seed);
+}
+
+void rsi(utils::Span<const double> input, std::size_t period, utils::Span<double> output) {
+    rsi_multi(input, utils::Span<const std::size_t>(&period, 1), output);
+}
+
+std::vector<double> sma(utils::Span<const double> input, std::size_t period) {
+    std::vector<double> output(input.size());
+    sma(input, period, output);
+    return output;
+}
+
+std::vector<double> ema(utils::Span<const double> input, std::size_t period, EmaSeed seed) {
+    std::vector<double> output(input.size());
+    ema(input, period, output, seed);
+    return output;
+}
+
+std::vector<double> rsi(utils::Span<const double> input, std::size_t period) {
+    std::vector<double> output(input.size());
+    rsi(input, period, output);
+    return output;
+}
+
+} // namespace batch
+} // namespace indicators
+} // namespace quant
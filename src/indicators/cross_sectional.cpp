@@ -0,0 +1,277 @@
+#include "indicators/cross_sectional.hpp"
+#include "utils/multiversion.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace quant {
+namespace indicators {
+
+namespace {
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+size_t check_period(size_t period) {
+    if (period == 0) {
+        throw std::invalid_argument("Period must be greater than 0");
+    }
+    return period;
+}
+
+void check_input(utils::Span<const double> values, size_t symbols) {
+    if (values.size() != symbols) {
+        throw std::invalid_argument("Cross-sectional input size does not match symbol count");
+    }
+}
+
+// 以下内核中各分支的值都无条件算出再选择，便于编译器转换为向量混合指令
+
+QUANT_MULTIVERSION
+void sma_step(const double* __restrict input, double* __restrict slot, double* __restrict sum,
+              double* __restrict compensation, double* __restrict last, double* __restrict count,
+              double* __restrict output, size_t symbols, double period) {
+    for (size_t i = 0; i < symbols; ++i) {
+        const double raw = input[i];
+        const double n = count[i];
+        const bool missing = raw != raw;
+        const bool has_data = !missing || n > 0.0;
+        // 从未有过数据的品种写入0，加减0不改变补偿和
+        const double value = has_data ? (missing ? last[i] : raw) : 0.0;
+
+        // 与utils::CompensatedSum相同：先减去移出窗口的值，再加上新值
+        double s = sum[i];
+        double c = compensation[i];
+        const double evicted = -slot[i];
+        double total = s + evicted;
+        c += std::fabs(s) >= std::fabs(evicted) ? (s - total) + evicted : (evicted - total) + s;
+        s = total;
+        total = s + value;
+        c += std::fabs(s) >= std::fabs(value) ? (s - total) + value : (value - total) + s;
+        s = total;
+
+        const double next = n + (has_data ? 1.0 : 0.0);
+        sum[i] = s;
+        compensation[i] = c;
+        slot[i] = value;
+        last[i] = has_data ? value : last[i];
+        count[i] = next;
+        output[i] = next >= period ? (s + c) / period : kNaN;
+    }
+}
+
+QUANT_MULTIVERSION
+void ema_step(const double* __restrict input, double* __restrict last, double* __restrict count,
+              double* __restrict output, size_t symbols, double alpha, double one_minus_alpha) {
+    for (size_t i = 0; i < symbols; ++i) {
+        const double raw = input[i];
+        const double n = count[i];
+        const bool missing = raw != raw;
+        const double value = missing ? last[i] : raw;  // 从未有过数据时last为NaN
+        const bool has_data = !missing || n > 0.0;
+        const double smoothed = alpha * value + one_minus_alpha * output[i];
+
+        output[i] = n > 0.0 ? smoothed : value;
+        last[i] = value;
+        count[i] = n + (has_data ? 1.0 : 0.0);
+    }
+}
+
+QUANT_MULTIVERSION
+void rsi_step(const double* __restrict input, double* __restrict last, double* __restrict avg_gain,
+              double* __restrict avg_loss, double* __restrict count, double* __restrict output,
+              size_t symbols, double period) {
+    const double period_minus_one = period - 1;
+    for (size_t i = 0; i < symbols; ++i) {
+        const double raw = input[i];
+        const bool missing = raw != raw;
+        const double value = missing ? last[i] : raw;
+        const double n = count[i];
+        const bool has_data = !missing || n > 0.0;
+
+        const double change = value - last[i];
+        const double gain = change > 0 ? change : 0.0;
+        const double loss = change > 0 ? 0.0 : -change;
+
+        // 预热期累计涨跌幅，累计满period个时取均值；之后按Wilder平滑递推
+        const bool completes = n == period;
+        const double warm_gain = completes ? (avg_gain[i] + gain) / period : avg_gain[i] + gain;
+        const double warm_loss = completes ? (avg_loss[i] + loss) / period : avg_loss[i] + loss;
+        const double smooth_gain = (avg_gain[i] * period_minus_one + gain) / period;
+        const double smooth_loss = (avg_loss[i] * period_minus_one + loss) / period;
+
+        const double g = n == 0.0 ? avg_gain[i] : (n <= period ? warm_gain : smooth_gain);
+        const double l = n == 0.0 ? avg_loss[i] : (n <= period ? warm_loss : smooth_loss);
+        const double next = n + (has_data ? 1.0 : 0.0);
+        const double rsi = l == 0.0 ? 100.0 : 100.0 - (100.0 / (1.0 + g / l));
+
+        avg_gain[i] = g;
+        avg_loss[i] = l;
+        last[i] = value;
+        count[i] = next;
+        output[i] = next > period ? rsi : kNaN;
+    }
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// CrossSectionalSMA
+// ---------------------------------------------------------------------------
+
+CrossSectionalSMA::CrossSectionalSMA(size_t symbols, size_t period)
+    : period_(check_period(period)),
+      window_(symbols * period),
+      sum_(symbols),
+      compensation_(symbols),
+      last_(symbols),
+      count_(symbols),
+      output_(symbols) {
+    reset();
+}
+
+void CrossSectionalSMA::update(utils::Span<const double> values) {
+    check_input(values, symbols());
+    sma_step(values.data(), window_.data() + next_ * symbols(), sum_.data(), compensation_.data(),
+             last_.data(), count_.data(), output_.data(), symbols(), static_cast<double>(period_));
+    if (++next_ == period_) {
+        next_ = 0;
+    }
+}
+
+void CrossSectionalSMA::reset() {
+    next_ = 0;
+    std::fill(window_.begin(), window_.end(), 0.0);
+    std::fill(sum_.begin(), sum_.end(), 0.0);
+    std::fill(compensation_.begin(), compensation_.end(), 0.0);
+    std::fill(last_.begin(), last_.end(), kNaN);
+    std::fill(count_.begin(), count_.end(), 0.0);
+    std::fill(output_.begin(), output_.end(), kNaN);
+}
+
+// ---------------------------------------------------------------------------
+// CrossSectionalEMA
+// ---------------------------------------------------------------------------
+
+CrossSectionalEMA::CrossSectionalEMA(size_t symbols, size_t period)
+    : period_(check_period(period)),
+      alpha_(2.0 / (period + 1)),
+      one_minus_alpha_(1 - alpha_),
+      last_(symbols),
+      count_(symbols),
+      output_(symbols) {
+    reset();
+}
+
+void CrossSectionalEMA::update(utils::Span<const double> values) {
+    check_input(values, symbols());
+    ema_step(values.data(), last_.data(), count_.data(), output_.data(), symbols(), alpha_, one_minus_alpha_);
+}
+
+void CrossSectionalEMA::reset() {
+    std::fill(last_.begin(), last_.end(), kNaN);
+    std::fill(count_.begin(), count_.end(), 0.0);
+    std::fill(output_.begin(), output_.end(), kNaN);
+}
+
+// ---------------------------------------------------------------------------
+// CrossSectionalRSI
+// ---------------------------------------------------------------------------
+
+CrossSectionalRSI::CrossSectionalRSI(size_t symbols, size_t period)
+    : period_(check_period(period)),
+      last_(symbols),
+      avg_gain_(symbols),
+      avg_loss_(symbols),
+      count_(symbols),
+      output_(symbols) {
+    reset();
+}
+
+void CrossSectionalRSI::update(utils::Span<const double> values) {
+    check_input(values, symbols());
+    rsi_step(values.data(), last_.data(), avg_gain_.data(), avg_loss_.data(), count_.data(), output_.data(),
+             symbols(), static_cast<double>(period_));
+}
+
+void CrossSectionalRSI::reset() {
+    std::fill(last_.begin(), last_.end(), kNaN);
+    std::fill(avg_gain_.begin(), avg_gain_.end(), 0.0);
+    std::fill(avg_loss_.begin(), avg_loss_.end(), 0.0);
+    std::fill(count_.begin(), count_.end(), 0.0);
+    std::fill(output_.begin(), output_.end(), kNaN);
+}
+
+// ---------------------------------------------------------------------------
+// 横截面变换
+// ---------------------------------------------------------------------------
+
+void cross_sectional_rank(utils::Span<const double> values, utils::Span<double> output,
+                          std::vector<size_t>& scratch) {
+    if (output.size() != values.size()) {
+        throw std::invalid_argument("Output size does not match input size");
+    }
+
+    scratch.clear();
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (std::isnan(values[i])) {
+            output[i] = kNaN;
+        } else {
+            scratch.push_back(i);
+        }
+    }
+    std::sort(scratch.begin(), scratch.end(),
+              [&values](size_t a, size_t b) { return values[a] < values[b]; });
+
+    const size_t valid = scratch.size();
+    const double scale = valid > 1 ? 1.0 / static_cast<double>(valid - 1) : 0.0;
+    for (size_t begin = 0; begin < valid;) {
+        // 并列的值取平均名次
+        size_t end = begin + 1;
+        while (end < valid && values[scratch[end]] == values[scratch[begin]]) {
+            ++end;
+        }
+        const double rank = valid > 1 ? 0.5 * static_cast<double>(begin + end - 1) * scale : 0.5;
+        for (size_t k = begin; k < end; ++k) {
+            output[scratch[k]] = rank;
+        }
+        begin = end;
+    }
+}
+
+void cross_sectional_rank(utils::Span<const double> values, utils::Span<double> output) {
+    std::vector<size_t> scratch;
+    scratch.reserve(values.size());
+    cross_sectional_rank(values, output, scratch);
+}
+
+void cross_sectional_zscore(utils::Span<const double> values, utils::Span<double> output) {
+    if (output.size() != values.size()) {
+        throw std::invalid_argument("Output size does not match input size");
+    }
+
+    double sum = 0.0;
+    size_t valid = 0;
+    for (double value : values) {
+        if (!std::isnan(value)) {
+            sum += value;
+            ++valid;
+        }
+    }
+    const double mean = valid > 0 ? sum / static_cast<double>(valid) : 0.0;
+    double squares = 0.0;
+    for (double value : values) {
+        if (!std::isnan(value)) {
+            squares += (value - mean) * (value - mean);
+        }
+    }
+    const double stddev = valid > 0 ? std::sqrt(squares / static_cast<double>(valid)) : 0.0;
+    const double inverse = stddev > 0.0 ? 1.0 / stddev : 0.0;
+    for (size_t i = 0; i < values.size(); ++i) {
+        output[i] = (values[i] - mean) * inverse;
+    }
+}
+
+} // namespace indicators
+} // namespace quant
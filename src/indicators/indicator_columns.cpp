@@ -0,0 +1,146 @@
+#include "indicators/indicator_columns.hpp"
+#include "indicators/batch_kernels.hpp"
+#include "indicators/moving_average.hpp"
+#include "indicators/rolling_statistics.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace quant {
+namespace indicators {
+
+namespace {
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+utils::Span<const double> field_column(const data::BarSeries& series, PriceField field) {
+    switch (field) {
+        case PriceField::OPEN: return series.open();
+        case PriceField::HIGH: return series.high();
+        case PriceField::LOW: return series.low();
+        case PriceField::VOLUME: return series.volume();
+        default: return series.close();
+    }
+}
+
+} // namespace
+
+std::size_t IndicatorColumn::find(data::Timestamp timestamp) const {
+    auto timestamps = series.timestamps();
+    auto it = std::lower_bound(timestamps.begin(), timestamps.end(), timestamp);
+    if (it == timestamps.end() || *it != timestamp) {
+        return size();
+    }
+    return static_cast<std::size_t>(it - timestamps.begin());
+}
+
+IndicatorColumnCache::IndicatorColumnCache(std::shared_ptr<data::SeriesDataFeed> data)
+    : data_(std::move(data)) {
+    if (!data_) {
+        throw std::invalid_argument("Data feed cannot be null");
+    }
+}
+
+std::shared_ptr<const IndicatorColumn> IndicatorColumnCache::get(
+    data::SymbolId symbol,
+    IndicatorType type,
+    std::size_t period,
+    PriceField field) {
+    if (period == 0) {
+        throw std::invalid_argument("Period must be greater than 0");
+    }
+
+    Key key{symbol, field, type, period};
+    std::promise<ColumnPtr> promise;
+    std::shared_future<ColumnPtr> future;
+    bool owner = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = columns_.find(key);
+        if (it != columns_.end()) {
+            future = it->second;
+        } else {
+            future = promise.get_future().share();
+            columns_.emplace(key, future);
+            ++computations_;
+            owner = true;
+        }
+    }
+
+    // 首个请求者在锁外计算，其他请求者在future上等待
+    if (owner) {
+        try {
+            promise.set_value(compute(key));
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+            std::lock_guard<std::mutex> lock(mutex_);
+            columns_.erase(key);
+        }
+    }
+    return future.get();
+}
+
+std::size_t IndicatorColumnCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return columns_.size();
+}
+
+std::uint64_t IndicatorColumnCache::computations() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return computations_;
+}
+
+IndicatorColumnCache::ColumnPtr IndicatorColumnCache::compute(const Key& key) const {
+    const auto& [symbol, field, type, period] = key;
+
+    auto column = std::make_shared<IndicatorColumn>();
+    column->series = data_->series(data::symbol_name(symbol));
+    auto input = field_column(column->series, field);
+    column->values.assign(input.size(), kNaN);
+    utils::Span<double> output(column->values.data(), column->values.size());
+
+    switch (type) {
+        case IndicatorType::SMA: {
+            // 与SimpleMovingAverage逐个更新，保证与流式策略逐位一致
+            SimpleMovingAverage sma(period);
+            for (std::size_t i = 0; i < input.size(); ++i) {
+                sma.update(input[i]);
+                if (sma.is_valid()) {
+                    output[i] = sma.get_value();
+                }
+            }
+            break;
+        }
+        case IndicatorType::EMA:
+            batch::ema(input, period, output, batch::EmaSeed::FIRST_VALUE);
+            break;
+        case IndicatorType::RSI:
+            batch::rsi(input, period, output);
+            break;
+        case IndicatorType::ROLLING_MIN:
+        case IndicatorType::ROLLING_MAX: {
+            RollingMinMax window(period);
+            for (std::size_t i = 0; i < input.size(); ++i) {
+                window.update(input[i]);
+                if (window.is_valid()) {
+                    output[i] = type == IndicatorType::ROLLING_MAX ? window.get_max() : window.get_min();
+                }
+            }
+            break;
+        }
+        case IndicatorType::ROLLING_STDDEV: {
+            RollingVariance variance(period);
+            for (std::size_t i = 0; i < input.size(); ++i) {
+                variance.update(input[i]);
+                if (variance.is_valid()) {
+                    output[i] = variance.get_stddev();
+                }
+            }
+            break;
+        }
+    }
+    return column;
+}
+
+} // namespace indicators
+} // namespace quant
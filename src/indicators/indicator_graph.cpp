@@ -0,0 +1,278 @@
+#include "indicators/indicator_graph.hpp"
+#include "indicators/moving_average.hpp"
+#include "indicators/rolling_statistics.hpp"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace quant {
+namespace indicators {
+
+namespace {
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+constexpr std::uint64_t kSourceKind = 1000;  // 与IndicatorType的取值区分
+
+} // namespace
+
+// 图中节点：由输入值（源节点为K线）计算当前值，未就绪时返回NaN
+class IndicatorGraph::Node {
+public:
+    explicit Node(NodeId input) : input(input) {}
+    virtual ~Node() = default;
+
+    virtual double evaluate(const data::MarketData& bar, double input_value) = 0;
+    virtual void reset() = 0;
+
+    // 输入节点，源节点为自身
+    const NodeId input;
+};
+
+namespace {
+
+class SourceNode : public IndicatorGraph::Node {
+public:
+    SourceNode(NodeId self, PriceField field) : Node(self), field_(field) {}
+
+    double evaluate(const data::MarketData& bar, double) override {
+        switch (field_) {
+            case PriceField::OPEN: return bar.open;
+            case PriceField::HIGH: return bar.high;
+            case PriceField::LOW: return bar.low;
+            case PriceField::VOLUME: return bar.volume;
+            default: return bar.close;
+        }
+    }
+
+    void reset() override {}
+
+private:
+    PriceField field_;
+};
+
+class SmaNode : public IndicatorGraph::Node {
+public:
+    SmaNode(NodeId input, std::size_t period) : Node(input), sma_(period) {}
+
+    double evaluate(const data::MarketData&, double value) override {
+        sma_.update(value);
+        return sma_.is_valid() ? sma_.get_value() : kNaN;
+    }
+
+    void reset() override { sma_.reset(); }
+
+private:
+    SimpleMovingAverage sma_;
+};
+
+class EmaNode : public IndicatorGraph::Node {
+public:
+    EmaNode(NodeId input, std::size_t period) : Node(input), ema_(period) {}
+
+    double evaluate(const data::MarketData&, double value) override {
+        ema_.update(value);
+        return ema_.get_value();
+    }
+
+    void reset() override { ema_.reset(); }
+
+private:
+    ExponentialMovingAverage ema_;
+};
+
+// Wilder平滑的RSI，前period个涨跌幅的均值作为初始值（与RSI<N>一致）
+class RsiNode : public IndicatorGraph::Node {
+public:
+    RsiNode(NodeId input, std::size_t period) : Node(input), period_(period) {}
+
+    double evaluate(const data::MarketData&, double value) override {
+        if (count_ == 0) {
+            prev_ = value;
+            ++count_;
+            return kNaN;
+        }
+
+        double change = value - prev_;
+        double gain = change > 0 ? change : 0.0;
+        double loss = change > 0 ? 0.0 : -change;
+        prev_ = value;
+
+        const double period = static_cast<double>(period_);
+        if (count_ <= period_) {
+            // 预热期：累计前period个涨跌幅
+            avg_gain_ += gain;
+            avg_loss_ += loss;
+            if (++count_ <= period_) {
+                return kNaN;
+            }
+            avg_gain_ /= period;
+            avg_loss_ /= period;
+        } else {
+            avg_gain_ = (avg_gain_ * (period - 1) + gain) / period;
+            avg_loss_ = (avg_loss_ * (period - 1) + loss) / period;
+        }
+
+        if (avg_loss_ == 0.0) {
+            return 100.0;
+        }
+        double rs = avg_gain_ / avg_loss_;
+        return 100.0 - (100.0 / (1.0 + rs));
+    }
+
+    void reset() override {
+        prev_ = 0.0;
+        avg_gain_ = 0.0;
+        avg_loss_ = 0.0;
+        count_ = 0;
+    }
+
+private:
+    std::size_t period_;
+    std::size_t count_ = 0;
+    double prev_ = 0.0;
+    double avg_gain_ = 0.0;  // 预热期内为累计值
+    double avg_loss_ = 0.0;
+};
+
+class RollingExtremeNode : public IndicatorGraph::Node {
+public:
+    RollingExtremeNode(NodeId input, std::size_t period, bool maximum)
+        : Node(input), window_(period), maximum_(maximum) {}
+
+    double evaluate(const data::MarketData&, double value) override {
+        window_.update(value);
+        if (!window_.is_valid()) {
+            return kNaN;
+        }
+        return maximum_ ? window_.get_max() : window_.get_min();
+    }
+
+    void reset() override { window_.reset(); }
+
+private:
+    RollingMinMax window_;
+    bool maximum_;
+};
+
+class RollingStddevNode : public IndicatorGraph::Node {
+public:
+    RollingStddevNode(NodeId input, std::size_t period) : Node(input), variance_(period) {}
+
+    double evaluate(const data::MarketData&, double value) override {
+        variance_.update(value);
+        return variance_.is_valid() ? variance_.get_stddev() : kNaN;
+    }
+
+    void reset() override { variance_.reset(); }
+
+private:
+    RollingVariance variance_;
+};
+
+std::unique_ptr<IndicatorGraph::Node> make_node(IndicatorType type, std::size_t period, NodeId input) {
+    switch (type) {
+        case IndicatorType::SMA: return std::make_unique<SmaNode>(input, period);
+        case IndicatorType::EMA: return std::make_unique<EmaNode>(input, period);
+        case IndicatorType::RSI: return std::make_unique<RsiNode>(input, period);
+        case IndicatorType::ROLLING_MIN: return std::make_unique<RollingExtremeNode>(input, period, false);
+        case IndicatorType::ROLLING_MAX: return std::make_unique<RollingExtremeNode>(input, period, true);
+        case IndicatorType::ROLLING_STDDEV: return std::make_unique<RollingStddevNode>(input, period);
+    }
+    throw std::invalid_argument("Unknown indicator type");
+}
+
+} // namespace
+
+std::size_t IndicatorGraph::KeyHash::operator()(const Key& key) const {
+    std::uint64_t hash = key.kind * 0x9E3779B97F4A7C15ULL;
+    hash = (hash ^ key.param) * 0x9E3779B97F4A7C15ULL;
+    hash = (hash ^ key.input) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<std::size_t>(hash ^ (hash >> 32));
+}
+
+IndicatorGraph::IndicatorGraph() = default;
+IndicatorGraph::~IndicatorGraph() = default;
+
+NodeId IndicatorGraph::source(data::SymbolId symbol, PriceField field) {
+    if (symbol == data::kInvalidSymbolId) {
+        throw std::invalid_argument("Invalid symbol for indicator source");
+    }
+    Key key{kSourceKind + static_cast<std::uint64_t>(field), symbol, 0};
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        return it->second;
+    }
+    NodeId id = static_cast<NodeId>(nodes_.size());
+    return insert(key, symbol, std::make_unique<SourceNode>(id, field));
+}
+
+NodeId IndicatorGraph::add(IndicatorType type, std::size_t period, NodeId input) {
+    if (input >= nodes_.size()) {
+        throw std::out_of_range("Unknown indicator input node");
+    }
+    if (period == 0) {
+        throw std::invalid_argument("Period must be greater than 0");
+    }
+    Key key{static_cast<std::uint64_t>(type), period, input};
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        return it->second;
+    }
+    return insert(key, symbol_of_[input], make_node(type, period, input));
+}
+
+NodeId IndicatorGraph::insert(const Key& key, data::SymbolId symbol, std::unique_ptr<Node> node) {
+    NodeId id = static_cast<NodeId>(nodes_.size());
+    nodes_.push_back(std::move(node));
+    values_.push_back(kNaN);
+    symbol_of_.push_back(symbol);
+    index_.emplace(key, id);
+    if (symbol >= symbols_.size()) {
+        symbols_.resize(static_cast<std::size_t>(symbol) + 1);
+    }
+    symbols_[symbol].nodes.push_back(id);
+    return id;
+}
+
+bool IndicatorGraph::update(const data::MarketData& bar) {
+    if (bar.symbol >= symbols_.size()) {
+        return false;
+    }
+    SymbolNodes& entry = symbols_[bar.symbol];
+    if (!entry.started || entry.timestamp != bar.timestamp) {
+        entry.started = true;
+        entry.timestamp = bar.timestamp;
+        entry.evaluated = 0;
+    }
+    if (entry.evaluated == entry.nodes.size()) {
+        return false;
+    }
+
+    // 从上次计算到的位置继续，只有这根K线之后新建的节点会在同一时间戳上被补算
+    for (std::size_t k = entry.evaluated; k < entry.nodes.size(); ++k) {
+        NodeId id = entry.nodes[k];
+        Node& node = *nodes_[id];
+        double input = values_[node.input];
+        // 输入未就绪时不推进，避免预热期的不完整值进入下游
+        if (node.input == id || !std::isnan(input)) {
+            values_[id] = node.evaluate(bar, input);
+        }
+    }
+    evaluations_ += entry.nodes.size() - entry.evaluated;
+    entry.evaluated = entry.nodes.size();
+    return true;
+}
+
+void IndicatorGraph::reset() {
+    for (std::size_t id = 0; id < nodes_.size(); ++id) {
+        nodes_[id]->reset();
+        values_[id] = kNaN;
+    }
+    for (auto& entry : symbols_) {
+        entry.started = false;
+        entry.evaluated = 0;
+    }
+}
+
+} // namespace indicators
+} // namespace quant
@@ -1,30 +1,62 @@
 #include "strategy/strategy.hpp"
+#include <stdexcept>
 #include <unordered_map>
 #include <mutex>
 
 namespace quant {
 namespace strategy {
 
+void Strategy::on_data_batch(const data::BarSeriesView& bars, SignalBuffer& signals) {
+    for (std::size_t i = 0; i < bars.size(); ++i) {
+        auto signal = on_data(bars[i]);
+        if (signal) {
+            signals.push(BatchSignal{static_cast<std::uint32_t>(i), signal->symbol, signal->timestamp,
+                                     signal->type, signal->strength});
+        }
+    }
+}
+
+void Strategy::save_state(utils::BinaryWriter&) const {
+    throw std::logic_error("Strategy does not support checkpoints: " + name());
+}
+
+void Strategy::load_state(utils::BinaryReader&) {
+    throw std::logic_error("Strategy does not support checkpoints: " + name());
+}
+
 // 策略工厂实现
 std::unordered_map<std::string, StrategyFactory::StrategyCreator>& StrategyFactory::get_registry() {
     static std::unordered_map<std::string, StrategyCreator> registry;
     return registry;
 }
 
+std::mutex& StrategyFactory::get_mutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
 void StrategyFactory::register_strategy(const std::string& name, StrategyCreator creator) {
-    get_registry()[name] = creator;
+    std::lock_guard<std::mutex> lock(get_mutex());
+    get_registry()[name] = std::move(creator);
 }
 
 std::unique_ptr<Strategy> StrategyFactory::create_strategy(const std::string& name) {
-    auto& registry = get_registry();
-    auto it = registry.find(name);
-    if (it != registry.end()) {
-        return it->second();
+    StrategyCreator creator;
+    {
+        // 只在查找时加锁，创建函数可能较慢，不阻塞其他线程
+        std::lock_guard<std::mutex> lock(get_mutex());
+        auto& registry = get_registry();
+        auto it = registry.find(name);
+        if (it == registry.end()) {
+            return nullptr;
+        }
+        creator = it->second;
     }
-    return nullptr;
+    return creator();
 }
 
 std::vector<std::string> StrategyFactory::get_registered_strategies() {
+    std::lock_guard<std::mutex> lock(get_mutex());
     std::vector<std::string> names;
     for (const auto& [name, _] : get_registry()) {
         names.push_back(name);
@@ -0,0 +1,68 @@
+#include "strategy/vectorized_strategy.hpp"
+#include "utils/compensated_sum.hpp"
+#include "utils/multiversion.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace quant {
+namespace strategy {
+
+namespace {
+
+// 整列简单移动平均，前period-1个位置不写入。
+// 与SimpleMovingAverage::update的加减顺序相同：窗口已满时先减去移出的值再加入新值
+void rolling_mean(utils::Span<const double> values, std::size_t period, double* output) {
+    utils::CompensatedSum sum;
+    const double divisor = static_cast<double>(period);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        if (i >= period) {
+            sum.add(-values[i - period]);
+        }
+        sum.add(values[i]);
+        if (i + 1 >= period) {
+            output[i] = sum.value() / divisor;
+        }
+    }
+}
+
+// 在[first, count)上比较相邻两根的快慢线：金叉记1，死叉记-1
+QUANT_MULTIVERSION
+void crossover_signals(const double* fast, const double* slow, std::size_t first, std::size_t count, double* output) {
+    for (std::size_t i = first; i < count; ++i) {
+        const double buy = fast[i - 1] < slow[i - 1] && fast[i] > slow[i] ? 1.0 : 0.0;
+        const double sell = fast[i - 1] > slow[i - 1] && fast[i] < slow[i] ? -1.0 : 0.0;
+        output[i] = buy + sell;
+    }
+}
+
+} // namespace
+
+VectorizedMovingAverageStrategy::VectorizedMovingAverageStrategy(int fast_period, int slow_period)
+    : fast_period_(static_cast<std::size_t>(fast_period)),
+      slow_period_(static_cast<std::size_t>(slow_period)) {
+    if (fast_period <= 0 || slow_period <= 0) {
+        throw std::invalid_argument("Period must be greater than 0");
+    }
+}
+
+void VectorizedMovingAverageStrategy::generate(const data::BarSeriesView& bars, utils::Span<double> output) {
+    if (output.size() != bars.size()) {
+        throw std::invalid_argument("Signal column size does not match bar count");
+    }
+
+    // 两条均线都就绪的第一根K线，此时前值为0，不会产生信号
+    const std::size_t ready = std::max(fast_period_, slow_period_) - 1;
+    if (bars.size() <= ready + 1) {
+        return;
+    }
+
+    std::vector<double> fast(bars.size());
+    std::vector<double> slow(bars.size());
+    rolling_mean(bars.close(), fast_period_, fast.data());
+    rolling_mean(bars.close(), slow_period_, slow.data());
+    crossover_signals(fast.data(), slow.data(), ready + 1, bars.size(), output.data());
+}
+
+} // namespace strategy
+} // namespace quant
@@ -0,0 +1,81 @@
+#include "utils/latency_histogram.hpp"
+#include "utils/bit_stream.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace quant {
+namespace utils {
+
+unsigned LatencyHistogram::bucket_index(std::uint64_t value) {
+    if (value < kSubBuckets) {
+        return static_cast<unsigned>(value);
+    }
+    // 最高位所在的段，段内取紧随最高位之后的kSubBucketBits位
+    unsigned msb = 63 - count_leading_zeros(value);
+    unsigned shift = msb - kSubBucketBits;
+    unsigned sub = static_cast<unsigned>((value >> shift) & (kSubBuckets - 1));
+    return (shift + 1) * kSubBuckets + sub;
+}
+
+std::uint64_t LatencyHistogram::bucket_upper_bound(unsigned index) {
+    if (index < kSubBuckets) {
+        return index;
+    }
+    unsigned shift = index / kSubBuckets - 1;
+    std::uint64_t sub = index % kSubBuckets;
+    std::uint64_t lower = (kSubBuckets + sub) << shift;
+    return lower + ((std::uint64_t(1) << shift) - 1);
+}
+
+void LatencyHistogram::record(std::uint64_t nanoseconds) {
+    ++buckets_[bucket_index(nanoseconds)];
+    ++count_;
+    sum_ += nanoseconds;
+    min_ = std::min(min_, nanoseconds);
+    max_ = std::max(max_, nanoseconds);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (unsigned i = 0; i < kBucketCount; ++i) {
+        buckets_[i] += other.buckets_[i];
+    }
+    count_ += other.count_;
+    sum_ += other.sum_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+}
+
+void LatencyHistogram::reset() {
+    *this = LatencyHistogram();
+}
+
+std::uint64_t LatencyHistogram::percentile(double percent) const {
+    if (count_ == 0) {
+        return 0;
+    }
+    double clamped = std::min(100.0, std::max(0.0, percent));
+    auto target = static_cast<std::uint64_t>(std::ceil(clamped / 100.0 * count_));
+    target = std::max<std::uint64_t>(target, 1);
+
+    std::uint64_t seen = 0;
+    for (unsigned i = 0; i < kBucketCount; ++i) {
+        seen += buckets_[i];
+        if (seen >= target) {
+            return std::min(bucket_upper_bound(i), max_);
+        }
+    }
+    return max_;
+}
+
+std::string LatencyHistogram::summary() const {
+    char text[192];
+    std::snprintf(text, sizeof(text),
+                  "n=%llu mean=%.2fus p50=%.2fus p99=%.2fus p99.9=%.2fus max=%.2fus",
+                  static_cast<unsigned long long>(count_), mean() / 1e3,
+                  percentile(50) / 1e3, percentile(99) / 1e3, percentile(99.9) / 1e3, max() / 1e3);
+    return text;
+}
+
+} // namespace utils
+} // namespace quant
@@ -0,0 +1,130 @@
+#include "utils/thread_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace quant {
+namespace utils {
+
+ThreadPool::ThreadPool(std::size_t threads) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        workers_.emplace_back([this]() { worker_loop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(timer_mutex_);
+        timer_stopping_ = true;
+    }
+    timer_cv_.notify_all();
+    if (timer_.joinable()) {
+        timer_.join();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::post(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+    }
+    cv_.notify_one();
+}
+
+void ThreadPool::post_after(std::chrono::steady_clock::duration delay, std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(timer_mutex_);
+        if (timer_stopping_) {
+            return;
+        }
+        if (!timer_.joinable()) {
+            timer_ = std::thread([this]() { timer_loop(); });
+        }
+        delayed_.push(DelayedTask{std::chrono::steady_clock::now() + delay, delayed_sequence_++, std::move(task)});
+    }
+    timer_cv_.notify_one();
+}
+
+void ThreadPool::parallel_for(std::size_t count, const std::function<void(std::size_t)>& body) {
+    std::atomic<std::size_t> next{0};
+    auto worker = [&]() {
+        for (std::size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            body(i);
+        }
+    };
+
+    std::size_t tasks = std::min(workers_.size(), count);
+    std::vector<std::future<void>> futures;
+    futures.reserve(tasks);
+    for (std::size_t t = 0; t < tasks; ++t) {
+        futures.push_back(submit(worker));
+    }
+
+    // 等待全部任务结束后再抛出，避免任务仍在引用本函数的局部变量
+    std::exception_ptr error;
+    for (auto& future : futures) {
+        try {
+            future.get();
+        } catch (...) {
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void ThreadPool::worker_loop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return;  // 已停止且队列为空
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
+
+void ThreadPool::timer_loop() {
+    std::unique_lock<std::mutex> lock(timer_mutex_);
+    while (!timer_stopping_) {
+        if (delayed_.empty()) {
+            timer_cv_.wait(lock);
+            continue;
+        }
+        auto deadline = delayed_.top().deadline;
+        if (timer_cv_.wait_until(lock, deadline) == std::cv_status::timeout ||
+            std::chrono::steady_clock::now() >= deadline) {
+            while (!delayed_.empty() && delayed_.top().deadline <= std::chrono::steady_clock::now()) {
+                auto task = std::move(const_cast<DelayedTask&>(delayed_.top()).task);
+                delayed_.pop();
+                lock.unlock();
+                post(std::move(task));
+                lock.lock();
+            }
+        }
+    }
+}
+
+} // namespace utils
+} // namespace quant